@@ -0,0 +1,114 @@
+#include <hoglib.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <pthread.h>
+#endif
+
+#define WIDTH 256
+#define HEIGHT 256
+#define THREAD_COUNT 4
+#define RECT_COUNT 2000
+
+typedef struct job {
+	hl_drawList list;
+	int index;
+} job;
+
+/* rand() shares its state between threads, each strip gets its own generator instead */
+static uint32_t nextRandom(uint32_t* state) {
+	*state = *state * 1664525u + 1013904223u;
+	return *state >> 8;
+}
+
+/* every worker fills its own strip of the image with overlapping translucent rects */
+static void recordStrip(hl_windowHandle target, int index) {
+	uint32_t state = (uint32_t)index + 1;
+	int i;
+
+	for (i = 0; i < RECT_COUNT; i++) {
+		uint8_t r = (uint8_t)nextRandom(&state);
+		uint8_t g = (uint8_t)nextRandom(&state);
+		uint8_t b = (uint8_t)nextRandom(&state);
+		int x = (int)(nextRandom(&state) % WIDTH);
+		int y = index * (HEIGHT / THREAD_COUNT) + (int)(nextRandom(&state) % (HEIGHT / THREAD_COUNT));
+
+		hl_setColor(target, HL_RGBA(r, g, b, 64));
+		hl_drawRect(target, HL_RECT(x, y, 16, 16));
+	}
+}
+
+#ifdef _WIN32
+static DWORD WINAPI worker(LPVOID arg) {
+#else
+static void* worker(void* arg) {
+#endif
+	job* j = (job*)arg;
+	recordStrip(j->list, j->index);
+	return 0;
+}
+
+/* records the same frame on worker threads and on the main thread and checks both come out identical */
+int main(void) {
+	hl_windowHandle window = hl_createWindow("drawlists", WIDTH, HEIGHT, HL_WINDOW_HEADLESS);
+	uint8_t* threaded = (uint8_t*)malloc(WIDTH * HEIGHT * 4);
+	uint8_t* serial = (uint8_t*)malloc(WIDTH * HEIGHT * 4);
+
+	job jobs[THREAD_COUNT];
+	int i;
+	for (i = 0; i < THREAD_COUNT; i++) {
+		jobs[i].list = hl_createDrawList(window);
+		jobs[i].index = i;
+	}
+
+	hl_startFrame(window);
+	hl_clear(window, HL_RGB(255, 255, 255));
+
+#ifdef _WIN32
+	HANDLE threads[THREAD_COUNT];
+	for (i = 0; i < THREAD_COUNT; i++)
+		threads[i] = CreateThread(NULL, 0, worker, &jobs[i], 0, NULL);
+	WaitForMultipleObjects(THREAD_COUNT, threads, TRUE, INFINITE);
+	for (i = 0; i < THREAD_COUNT; i++)
+		CloseHandle(threads[i]);
+#else
+	pthread_t threads[THREAD_COUNT];
+	for (i = 0; i < THREAD_COUNT; i++)
+		pthread_create(&threads[i], NULL, worker, &jobs[i]);
+	for (i = 0; i < THREAD_COUNT; i++)
+		pthread_join(threads[i], NULL);
+#endif
+
+	hl_finishFrame(window);
+	hl_readPixels(window, HL_RECT(0, 0, WIDTH, HEIGHT), threaded);
+
+	/* the lists are empty again after hl_startFrame, so this frame only has the main thread's draws */
+	hl_startFrame(window);
+	hl_clear(window, HL_RGB(255, 255, 255));
+	for (i = 0; i < THREAD_COUNT; i++)
+		recordStrip(window, i);
+	hl_finishFrame(window);
+	hl_readPixels(window, HL_RECT(0, 0, WIDTH, HEIGHT), serial);
+
+	int match = memcmp(threaded, serial, WIDTH * HEIGHT * 4) == 0;
+	printf("draw lists %s the serial frame\n", match ? "match" : "do not match");
+
+	FILE* file = fopen("drawlists.ppm", "wb");
+	if (file) {
+		fprintf(file, "P6\n%d %d\n255\n", WIDTH, HEIGHT);
+		for (i = 0; i < WIDTH * HEIGHT; i++)
+			fwrite(&threaded[i * 4], 1, 3, file);
+		fclose(file);
+	}
+
+	free(threaded);
+	free(serial);
+	hl_closeWindow(window);
+
+	return match ? 0 : 1;
+}
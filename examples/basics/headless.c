@@ -0,0 +1,47 @@
+#include <hoglib.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define WIDTH 256
+#define HEIGHT 256
+#define IMAGE_COUNT 100
+
+/* renders a batch of images without a display and writes the last one to headless.ppm */
+int main(void) {
+	hl_windowHandle window = hl_createWindow("headless", WIDTH, HEIGHT, HL_WINDOW_HEADLESS);
+	uint8_t* pixels = (uint8_t*)malloc(WIDTH * HEIGHT * 4);
+
+	double start = hl_getTime();
+
+	int i;
+	for (i = 0; i < IMAGE_COUNT; i++) {
+		hl_startFrame(window);
+
+		hl_clear(window, HL_RGB(255, 255, 255));
+
+		hl_setColor(window, HL_RGB(255, 0, 0));
+		hl_drawRect(window, HL_RECT(20 + i, 20, 100, 100));
+
+		hl_setColor(window, HL_RGBA(0, 0, 255, 128));
+		hl_drawRect(window, HL_RECT(70, 70 + i, 100, 100));
+
+		hl_requestPixels(window, HL_RECT(0, 0, WIDTH, HEIGHT));
+		hl_finishFrame(window);
+
+		hl_fetchPixels(window, pixels, true);
+	}
+
+	printf("%.1f images/s\n", IMAGE_COUNT / (hl_getTime() - start));
+
+	FILE* file = fopen("headless.ppm", "wb");
+	if (file) {
+		fprintf(file, "P6\n%d %d\n255\n", WIDTH, HEIGHT);
+		for (i = 0; i < WIDTH * HEIGHT; i++)
+			fwrite(&pixels[i * 4], 1, 3, file);
+		fclose(file);
+	}
+
+	free(pixels);
+	hl_closeWindow(window);
+}
@@ -0,0 +1,51 @@
+#include <hoglib.h>
+
+#define WINDOW_COUNT 3
+
+int main() {
+	hl_windowHandle windows[WINDOW_COUNT];
+	int i;
+
+	windows[0] = hl_createWindow("window 0", 400, 300, HL_RENDERER_GL_MODERN);
+	for (i = 1; i < WINDOW_COUNT; i++)
+		windows[i] = hl_createSharedWindow("window", 400, 300, HL_RENDERER_GL_MODERN, windows[0]);
+
+	/* loaded once, usable on every window of the share group */
+	hl_textureHandle texture = hl_loadTextureFromImage(windows[0], "logo.png");
+	hl_fontHandle font = hl_loadFont(windows[0], "COMICSANS.ttf", 60);
+
+	for (i = 0; i < WINDOW_COUNT; i++)
+		hl_setFont(windows[i], font);
+
+	bool running = true;
+	while (running) {
+		hl_pollEvents();
+		if (hl_isKeyPressed(HL_KEY_ESCAPE))
+			break;
+
+		for (i = 0; i < WINDOW_COUNT; i++) {
+			if (hl_windowShouldClose(windows[i]))
+				running = false;
+
+			/* one context switch per window, the frame's other calls reuse the bound context */
+			hl_startFrame(windows[i]);
+
+			hl_clear(windows[i], HL_RGB(255, 255, 255));
+
+			hl_setTexture(windows[i], texture);
+			hl_setColor(windows[i], HL_RGB(255, 255, 255));
+			hl_drawRect(windows[i], HL_RECT(20 + i * 40, 20, 200, 200));
+
+			hl_setColor(windows[i], HL_RGB(0, 0, 0));
+			hl_drawText(windows[i], "shared", 20, 240, 40);
+
+			hl_finishFrame(windows[i]);
+		}
+	}
+
+	hl_releaseFont(windows[0], font);
+	hl_releaseTexture(windows[0], texture);
+
+	for (i = WINDOW_COUNT - 1; i >= 0; i--)
+		hl_closeWindow(windows[i]);
+}
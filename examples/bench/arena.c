@@ -0,0 +1,141 @@
+/*
+ * benchmark for the frame arenas
+ * runs a frame loop that rasterizes new glyphs every frame and formats labels into scratch memory,
+ * once with the library's temporaries and the labels on the heap and once with them in the frame arena,
+ * reports the heap calls and bytes per frame and the frame time
+ * the heap is counted by wrapping malloc, which needs glibc
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal.h"
+
+#define WIDTH 640
+#define HEIGHT 480
+#define FRAMES 64
+#define FRAMES_PER_FONT 8 /* the font is reloaded before its glyph table fills up */
+#define LABELS 64
+
+#if defined(__GLIBC__)
+	#define COUNT_HEAP 1
+
+	extern void* __libc_malloc(size_t size);
+	extern void* __libc_calloc(size_t count, size_t size);
+	extern void* __libc_realloc(void* ptr, size_t size);
+	extern void __libc_free(void* ptr);
+
+	static volatile size_t heapCalls = 0, heapBytes = 0;
+
+	void* malloc(size_t size) {
+		__sync_fetch_and_add(&heapCalls, 1);
+		__sync_fetch_and_add(&heapBytes, size);
+		return __libc_malloc(size);
+	}
+
+	void* calloc(size_t count, size_t size) {
+		__sync_fetch_and_add(&heapCalls, 1);
+		__sync_fetch_and_add(&heapBytes, count * size);
+		return __libc_calloc(count, size);
+	}
+
+	void* realloc(void* ptr, size_t size) {
+		__sync_fetch_and_add(&heapCalls, 1);
+		__sync_fetch_and_add(&heapBytes, size);
+		return __libc_realloc(ptr, size);
+	}
+
+	void free(void* ptr) {
+		__libc_free(ptr);
+	}
+#else
+	#define COUNT_HEAP 0
+	static size_t heapCalls = 0, heapBytes = 0;
+#endif
+
+static const char* text = "Съешь же ещё этих мягких французских булок";
+
+static void drawFrame(hl_windowHandle window, hl_fontHandle font, int frame, bool arena) {
+	char* labels[LABELS];
+	int i;
+
+	hl_startFrame(window);
+	hl_clear(window, HL_RGB(255, 255, 255));
+	hl_setColor(window, HL_RGB(0, 0, 0));
+
+	/* a new size every frame, so every glyph of the line is rasterized */
+	hl_setFont(window, font);
+	hl_drawText(window, text, 10, 10, 12 + (frame % FRAMES_PER_FONT) * 3);
+
+	for (i = 0; i < LABELS; i++) {
+		labels[i] = arena ? (char*)hl_frameAlloc(64) : (char*)malloc(64);
+		snprintf(labels[i], 64, "label %d of frame %d", i, frame);
+	}
+
+	for (i = 0; i < LABELS; i++) {
+		hl_drawRect(window, HL_RECT((i % 8) * 80, 100 + (i / 8) * 40, (float)strlen(labels[i]) * 3, 10));
+		if (arena == false)
+			free(labels[i]);
+	}
+
+	hl_finishFrame(window);
+}
+
+static void run(hl_windowHandle window, const char* path, bool arena) {
+	hl_setTempArena(arena);
+
+	hl_fontHandle font = hl_loadFont(window, path, 40);
+	int frame;
+
+	/* the first pass grows the arenas and the renderer's buffers, the second is measured */
+	for (frame = 0; frame < FRAMES_PER_FONT; frame++)
+		drawFrame(window, font, frame, arena);
+	hl_releaseFont(window, font);
+
+	size_t calls = 0, bytes = 0;
+	double start = hl_getTime();
+
+	for (frame = 0; frame < FRAMES; frame++) {
+		if (frame % FRAMES_PER_FONT == 0)
+			font = hl_loadFont(window, path, 40);
+
+		size_t callsBefore = heapCalls, bytesBefore = heapBytes;
+		drawFrame(window, font, frame, arena);
+		calls += heapCalls - callsBefore;
+		bytes += heapBytes - bytesBefore;
+
+		if (frame % FRAMES_PER_FONT == FRAMES_PER_FONT - 1)
+			hl_releaseFont(window, font);
+	}
+
+	double elapsed = hl_getTime() - start;
+	if (COUNT_HEAP)
+		printf("%10s %14.1f %14.1f %10.3f\n", arena ? "arena" : "heap", (double)calls / FRAMES, (double)bytes / FRAMES / 1024.0, elapsed / FRAMES * 1e3);
+	else
+		printf("%10s %14s %14s %10.3f\n", arena ? "arena" : "heap", "-", "-", elapsed / FRAMES * 1e3);
+}
+
+int main(int argc, char** argv) {
+	const char* path = (argc > 1) ? argv[1] : "COMICSANS.ttf";
+	hl_windowHandle window = hl_createWindow("arena", WIDTH, HEIGHT, HL_WINDOW_HEADLESS);
+	if (window == NULL) {
+		printf("couldn't create the window\n");
+		return 1;
+	}
+
+	hl_fontHandle probe = hl_loadFont(window, path, 40);
+	if (probe == NULL) {
+		printf("couldn't load %s\n", path);
+		return 1;
+	}
+	hl_releaseFont(window, probe);
+
+	printf("%d frames, a line of new glyphs and %d labels each\n", FRAMES, LABELS);
+	printf("%10s %14s %14s %10s\n", "", "heap calls", "heap KiB", "frame ms");
+	run(window, path, false);
+	run(window, path, true);
+
+	hl_closeWindow(window);
+	return 0;
+}
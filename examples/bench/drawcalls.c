@@ -0,0 +1,86 @@
+/*
+ * benchmark for the per draw call overhead
+ * submits frames of small rects with a new color each and a clip every few draws, reports the median CPU time per draw
+ * (a frame's draws fit in one batch, so that is submission alone) and per frame,
+ * build the library with and without `make HL_BACKEND=gl_modern UNITY=1` to compare them
+ * pass software or gl_legacy as the first argument to measure another renderer
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <hoglib.h>
+
+#define WIDTH 640
+#define HEIGHT 480
+#define DRAWS 2000 /* 4 vertices each, RSGL flushes after 8192 */
+#define DRAWS_PER_CLIP 64
+#define WARMUP_FRAMES 50
+#define FRAMES 1000
+
+static int compareTimes(const void* a, const void* b) {
+	double x = *(const double*)a, y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+int main(int argc, char** argv) {
+	const char* name = (argc > 1) ? argv[1] : "gl_modern";
+	hl_windowFlags flags = HL_RENDERER_GL_MODERN;
+	if (strcmp(name, "gl_legacy") == 0)
+		flags = HL_RENDERER_GL_LEGACY;
+	else if (strcmp(name, "software") == 0)
+		flags = HL_WINDOW_HEADLESS;
+
+	hl_windowHandle window = hl_createWindow("drawcalls", WIDTH, HEIGHT, flags);
+	uint8_t pixel[4];
+	if (window == NULL) {
+		printf("couldn't create the window\n");
+		return 1;
+	}
+
+	static double submit[FRAMES], total[FRAMES];
+	int frame, i;
+	for (frame = 0; frame < WARMUP_FRAMES + FRAMES; frame++) {
+		double start = hl_getTime();
+
+		hl_startFrame(window);
+		hl_clear(window, HL_RGB(0, 0, 0));
+
+		double drawStart = hl_getTime();
+		for (i = 0; i < DRAWS; i++) {
+			if (i % DRAWS_PER_CLIP == 0) {
+				int clipX = (i / DRAWS_PER_CLIP) % 8 * 80;
+				hl_pushClip(window, HL_RECT(clipX, 0, 80, HEIGHT));
+			}
+
+			int x = (i * 7) % WIDTH, y = (i * 13) % HEIGHT;
+			hl_setColor(window, HL_RGB(i & 0xFF, (i >> 8) & 0xFF, 128));
+			hl_drawRect(window, HL_RECT(x, y, 4, 4));
+
+			if (i % DRAWS_PER_CLIP == DRAWS_PER_CLIP - 1)
+				hl_popClip(window);
+		}
+		if (DRAWS % DRAWS_PER_CLIP)
+			hl_popClip(window);
+		double drawElapsed = hl_getTime() - drawStart;
+
+		hl_finishFrame(window);
+		hl_readPixels(window, HL_RECT(0, 0, 1, 1), pixel); /* wait for the GPU */
+
+		if (frame >= WARMUP_FRAMES) {
+			submit[frame - WARMUP_FRAMES] = drawElapsed;
+			total[frame - WARMUP_FRAMES] = hl_getTime() - start;
+		}
+	}
+
+	qsort(submit, FRAMES, sizeof(double), compareTimes);
+	qsort(total, FRAMES, sizeof(double), compareTimes);
+
+	printf("%s, %d frames of %d draws\n", name, FRAMES, DRAWS);
+	printf("%24s %10.1f\n", "ns per draw", submit[FRAMES / 2] / DRAWS * 1e9);
+	printf("%24s %10.3f\n", "ms per frame", total[FRAMES / 2] * 1e3);
+
+	hl_closeWindow(window);
+	return 0;
+}
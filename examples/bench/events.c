@@ -0,0 +1,106 @@
+/*
+ * stress test for the event queue
+ * an input thread pushes bursts of events while a logic thread drains the queue once per simulated frame,
+ * reports the latency between queueing and popping and how many events were lost for a few queue sizes
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal.h"
+
+#define EVENT_COUNT 200000
+#define BURST_SIZE 256 /* events pushed back to back, like a fast mouse or a key repeat storm */
+#define BURST_INTERVAL 0.0002 /* seconds between bursts */
+#define FRAME_TIME 0.001 /* how often the logic thread drains the queue */
+
+typedef struct stressState {
+	volatile size_t producerDone;
+} stressState;
+
+static void producer(void* arg) {
+	stressState* state = (stressState*)arg;
+
+	hl_event event;
+	memset(&event, 0, sizeof(event));
+	event.type = HL_EVENT_USER;
+
+	uint64_t i;
+	for (i = 0; i < EVENT_COUNT; i++) {
+		event.user.code = i;
+		event.user.time = 0.0; /* stamped by hl_pushEvent */
+		hl_pushEvent(&event);
+
+		if ((i + 1) % BURST_SIZE == 0)
+			hl_sleep(BURST_INTERVAL);
+	}
+
+	hl_atomicStore(&state->producerDone, 1);
+}
+
+static int runQueueSize(size_t size) {
+	hl_setEventQueueSize(size);
+	size_t droppedBefore = hl_getDroppedEventCount();
+
+	stressState state;
+	state.producerDone = 0;
+
+	size_t received = 0;
+	double totalLatency = 0.0, maxLatency = 0.0;
+	uint64_t lastCode = 0;
+	int outOfOrder = 0;
+
+	double start = hl_getTime();
+	hl_thread* thread = hl_createThread(producer, &state);
+
+	for (;;) {
+		bool done = hl_atomicLoad(&state.producerDone) != 0;
+
+		hl_event event;
+		while (hl_nextEvent(&event)) {
+			double latency = hl_getTime() - event.common.time;
+			totalLatency += latency;
+			if (latency > maxLatency)
+				maxLatency = latency;
+
+			if (received && event.user.code <= lastCode)
+				outOfOrder = 1;
+			lastCode = event.user.code;
+			received += 1;
+		}
+
+		/* anything pushed before `done` was read has been drained above */
+		if (done)
+			break;
+
+		hl_sleep(FRAME_TIME);
+	}
+
+	hl_joinThread(thread);
+	double elapsed = hl_getTime() - start;
+
+	size_t dropped = hl_getDroppedEventCount() - droppedBefore;
+	printf("%10zu %10zu %10zu %9.3f%% %12.1f %12.1f %12.0f%s\n", size, received, dropped,
+			100.0 * (double)dropped / EVENT_COUNT,
+			received ? totalLatency / (double)received * 1e6 : 0.0, maxLatency * 1e6,
+			received / elapsed,
+			outOfOrder ? "  (out of order)" : "");
+
+	/* every event is either received or counted as dropped */
+	return outOfOrder || received + dropped != EVENT_COUNT;
+}
+
+int main(void) {
+	static const size_t sizes[] = { 32, 1024, HL_EVENT_QUEUE_SIZE * 16 };
+
+	printf("%d events in bursts of %d every %.1f ms, drained every %.1f ms\n", EVENT_COUNT, BURST_SIZE, BURST_INTERVAL * 1e3, FRAME_TIME * 1e3);
+	printf("%10s %10s %10s %10s %12s %12s %12s\n", "queue", "received", "dropped", "loss", "avg us", "max us", "events/s");
+
+	int failed = 0;
+	size_t i;
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+		failed |= runQueueSize(sizes[i]);
+
+	return failed;
+}
@@ -0,0 +1,205 @@
+/*
+ * benchmark for shared font faces
+ * loads one font file at several sizes in several windows, once with a private copy of the file per font
+ * (what every hl_loadFont used to do) and once through hl_loadFont, which maps the file and shares the parsed face,
+ * reports the load time and how much the resident set grew, first for the faces alone and then for whole fonts,
+ * whose glyph atlases ((maxHeight * 100)^2 texels each) cost the same either way and hide most of the difference
+ * pass a large (CJK) font as the first argument to see the difference at its worst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <hoglib.h>
+/* the face API, its implementation is in the library */
+#define RFONT_API extern
+#include "external/RFont.h"
+
+#define WINDOW_COUNT 2
+#define ITERATIONS 5
+
+static const uint32_t sizes[] = { 12, 14, 16, 20, 24, 32 };
+#define SIZE_COUNT (sizeof(sizes) / sizeof(sizes[0]))
+#define FONT_COUNT (WINDOW_COUNT * SIZE_COUNT)
+
+/* resident set size in bytes, 0 where it can't be read */
+static size_t residentSize(void) {
+#ifdef __linux__
+	long pages = 0, resident = 0;
+	FILE* file = fopen("/proc/self/statm", "r");
+	if (file == NULL)
+		return 0;
+	if (fscanf(file, "%ld %ld", &pages, &resident) != 2)
+		resident = 0;
+	fclose(file);
+	return (size_t)resident * 4096;
+#else
+	return 0;
+#endif
+}
+
+static uint8_t* readFile(const char* path, size_t* size) {
+	FILE* file = fopen(path, "rb");
+	if (file == NULL)
+		return NULL;
+
+	fseek(file, 0, SEEK_END);
+	*size = (size_t)ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	uint8_t* data = (uint8_t*)malloc(*size);
+	if (fread(data, 1, *size, file) != *size) {
+		free(data);
+		data = NULL;
+	}
+
+	fclose(file);
+	return data;
+}
+
+static void loadFaces(const char* path, bool shared, RFont_src** faces, uint8_t** copies) {
+	size_t i;
+	for (i = 0; i < FONT_COUNT; i++) {
+		if (shared) {
+			faces[i] = RFont_src_load(path);
+			continue;
+		}
+
+		size_t size = 0;
+		copies[i] = readFile(path, &size);
+		faces[i] = RFont_src_init_data(copies[i], size, 0);
+	}
+}
+
+static void releaseFaces(RFont_src** faces, uint8_t** copies) {
+	size_t i;
+	for (i = 0; i < FONT_COUNT; i++) {
+		RFont_src_release(faces[i]);
+		free(copies[i]);
+		copies[i] = NULL;
+	}
+}
+
+static void loadFonts(hl_windowHandle* windows, const char* path, bool shared, hl_fontHandle* fonts, uint8_t** copies) {
+	size_t w, i;
+	for (w = 0; w < WINDOW_COUNT; w++) {
+		for (i = 0; i < SIZE_COUNT; i++) {
+			size_t index = w * SIZE_COUNT + i;
+			if (shared) {
+				fonts[index] = hl_loadFont(windows[w], path, sizes[i]);
+				continue;
+			}
+
+			size_t size = 0;
+			copies[index] = readFile(path, &size);
+			fonts[index] = hl_loadFontFromMemory(windows[w], copies[index], size, sizes[i]);
+		}
+	}
+}
+
+/* draws a line with every font so the glyphs are actually read from the face */
+static void drawText(hl_windowHandle* windows, hl_fontHandle* fonts) {
+	size_t w, i;
+	for (w = 0; w < WINDOW_COUNT; w++) {
+		hl_startFrame(windows[w]);
+		hl_clear(windows[w], HL_RGB(255, 255, 255));
+		hl_setColor(windows[w], HL_RGB(0, 0, 0));
+
+		for (i = 0; i < SIZE_COUNT; i++) {
+			hl_setFont(windows[w], fonts[w * SIZE_COUNT + i]);
+			hl_drawText(windows[w], "The quick brown fox jumps over the lazy dog", 10, 10 + (float)(i * 40), sizes[i]);
+		}
+
+		hl_finishFrame(windows[w]);
+	}
+}
+
+static void releaseFonts(hl_windowHandle* windows, hl_fontHandle* fonts, uint8_t** copies) {
+	size_t w, i;
+	for (w = 0; w < WINDOW_COUNT; w++) {
+		for (i = 0; i < SIZE_COUNT; i++) {
+			size_t index = w * SIZE_COUNT + i;
+			hl_releaseFont(windows[w], fonts[index]);
+			free(copies[index]);
+			copies[index] = NULL;
+		}
+	}
+}
+
+static int run(hl_windowHandle* windows, const char* path, bool shared) {
+	RFont_src* faces[FONT_COUNT];
+	hl_fontHandle fonts[FONT_COUNT];
+	uint8_t* copies[FONT_COUNT] = { NULL };
+	double best = 1e9, bestFaces = 1e9;
+	size_t grown = 0, grownFaces = 0;
+	int i;
+
+	/* the faces without atlases, this is all that sharing saves */
+	for (i = 0; i < ITERATIONS; i++) {
+		size_t before = residentSize();
+		double start = hl_getTime();
+		loadFaces(path, shared, faces, copies);
+		double elapsed = hl_getTime() - start;
+
+		if (faces[0] == NULL) {
+			printf("couldn't load %s\n", path);
+			return 1;
+		}
+
+		if (i == 0)
+			grownFaces = residentSize() - before;
+
+		releaseFaces(faces, copies);
+		if (elapsed < bestFaces)
+			bestFaces = elapsed;
+	}
+
+	for (i = 0; i < ITERATIONS; i++) {
+		size_t before = residentSize();
+		double start = hl_getTime();
+		loadFonts(windows, path, shared, fonts, copies);
+		double elapsed = hl_getTime() - start;
+
+		if (fonts[0] == NULL) {
+			printf("couldn't load %s\n", path);
+			return 1;
+		}
+
+		drawText(windows, fonts);
+		if (i == 0)
+			grown = residentSize() - before;
+
+		releaseFonts(windows, fonts, copies);
+		if (elapsed < best)
+			best = elapsed;
+	}
+
+	printf("%20s %10.3f %12.1f %10.3f %12.1f\n", shared ? "shared face" : "copy per font",
+		   bestFaces * 1e3, (double)grownFaces / 1024.0, best * 1e3, (double)grown / 1024.0);
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	const char* path = (argc > 1) ? argv[1] : "COMICSANS.ttf";
+	hl_windowHandle windows[WINDOW_COUNT];
+	int i;
+
+	for (i = 0; i < WINDOW_COUNT; i++) {
+		windows[i] = hl_createWindow("fontload", 640, 260, HL_WINDOW_HEADLESS);
+		if (windows[i] == NULL) {
+			printf("couldn't create the window\n");
+			return 1;
+		}
+	}
+
+	printf("%s, %d sizes in %d windows\n", path, (int)SIZE_COUNT, WINDOW_COUNT);
+	printf("%20s %10s %12s %10s %12s\n", "", "face ms", "face KiB", "font ms", "font KiB");
+
+	int failed = run(windows, path, false);
+	if (failed == 0)
+		failed = run(windows, path, true);
+
+	for (i = WINDOW_COUNT - 1; i >= 0; i--)
+		hl_closeWindow(windows[i]);
+	return failed;
+}
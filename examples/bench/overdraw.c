@@ -0,0 +1,133 @@
+/*
+ * benchmark for hl_setDepthSorting
+ * draws a layered UI (a background, stacks of opaque panels and translucent overlays) in order and depth sorted,
+ * reports the frame time and the fragments shaded per pixel of both and checks they draw the same image
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <hoglib.h>
+
+#define WIDTH 1024
+#define HEIGHT 768
+#define LAYERS 12 /* stacked panels over every pixel */
+#define PANELS 6 /* panels per layer row */
+#define ITERATIONS 10
+
+static uint8_t checker[64 * 64 * 3];
+
+static void drawFrame(hl_windowHandle window, hl_textureHandle texture) {
+	int layer, i;
+
+	hl_startFrame(window);
+	hl_clear(window, HL_RGB(0, 0, 0));
+
+	hl_setColor(window, HL_RGB(40, 44, 52));
+	hl_drawRect(window, HL_RECT(0, 0, WIDTH, HEIGHT));
+
+	for (layer = 0; layer < LAYERS; layer++) {
+		float offset = (float)(layer * 7);
+
+		for (i = 0; i < PANELS; i++) {
+			float x = (float)(i % 3) * (WIDTH / 3) - offset;
+			float y = (float)(i / 3) * (HEIGHT / 2) - offset;
+
+			/* every third layer is textured with an opaque image, the rest are flat colors */
+			hl_setTexture(window, (layer % 3 == 2) ? texture : NULL);
+			hl_setColor(window, (layer % 3 == 2) ? HL_RGB(255, 255, 255) : HL_RGB((uint8_t)(60 + layer * 15), (uint8_t)(90 + i * 20), 140));
+			hl_drawRect(window, HL_RECT(x, y, WIDTH / 3 + 20, HEIGHT / 2 + 20));
+		}
+
+		/* a translucent highlight and a title bar that aren't fully covered by the next layer */
+		hl_setTexture(window, NULL);
+		hl_setColor(window, HL_RGBA(255, 255, 255, 40));
+		hl_drawRect(window, HL_RECT(100 + offset, 100 + offset, 300, 200));
+		hl_setColor(window, HL_RGB(20, 20, 20));
+		hl_drawRect(window, HL_RECT(offset, offset, WIDTH, 12));
+	}
+
+	hl_finishFrame(window);
+}
+
+static double timeFrames(hl_windowHandle window, hl_textureHandle texture, hl_overdrawStats* stats, uint8_t* pixels) {
+	double best = 1e9;
+	int i;
+	for (i = 0; i < ITERATIONS; i++) {
+		double start = hl_getTime();
+		drawFrame(window, texture);
+		hl_readPixels(window, HL_RECT(0, 0, 1, 1), pixels); /* wait for the GPU */
+
+		double elapsed = hl_getTime() - start;
+		if (elapsed < best)
+			best = elapsed;
+	}
+
+	memset(stats, 0, sizeof(*stats));
+	if (hl_beginOverdrawReport(window)) {
+		drawFrame(window, texture);
+		hl_endOverdrawReport(window, stats);
+	}
+
+	hl_readPixels(window, HL_RECT(0, 0, WIDTH, HEIGHT), pixels);
+	return best;
+}
+
+int main(void) {
+	hl_windowHandle window = hl_createWindow("overdraw", WIDTH, HEIGHT, HL_RENDERER_GL_MODERN);
+	if (window == NULL) {
+		printf("couldn't create the window\n");
+		return 1;
+	}
+
+	uint8_t* inOrder = (uint8_t*)malloc(WIDTH * HEIGHT * 4);
+	uint8_t* sorted = (uint8_t*)malloc(WIDTH * HEIGHT * 4);
+
+	size_t i;
+	for (i = 0; i < 64 * 64; i++) {
+		uint8_t shade = (((i % 64) / 8 + (i / 64) / 8) % 2) ? 200 : 90;
+		checker[i * 3] = shade;
+		checker[i * 3 + 1] = shade;
+		checker[i * 3 + 2] = 120;
+	}
+
+	hl_textureBlob blob;
+	memset(&blob, 0, sizeof(blob));
+	blob.data = checker;
+	blob.width = 64;
+	blob.height = 64;
+	blob.dataType = HL_TEXTURE_DATA_INT;
+	blob.dataFormat = HL_FORMAT_RGB;
+	blob.textureFormat = HL_FORMAT_RGB;
+	hl_textureHandle texture = hl_loadTextureFromBlob(window, &blob);
+
+	hl_overdrawStats inOrderStats, sortedStats;
+	double inOrderTime = timeFrames(window, texture, &inOrderStats, inOrder);
+
+	if (hl_setDepthSorting(window, true) == false) {
+		printf("depth sorting isn't supported by this renderer\n");
+		return 0;
+	}
+
+	double sortedTime = timeFrames(window, texture, &sortedStats, sorted);
+	hl_setDepthSorting(window, false);
+
+	size_t differ = 0;
+	for (i = 0; i < WIDTH * HEIGHT * 4; i++)
+		differ += inOrder[i] != sorted[i];
+
+	printf("%dx%d window, %d layers of %d panels\n", WIDTH, HEIGHT, LAYERS, PANELS);
+	printf("%10s %12s %16s\n", "", "frame ms", "fragments/pixel");
+	printf("%10s %12.2f %16.2f\n", "in order", inOrderTime * 1e3, inOrderStats.overdraw);
+	printf("%10s %12.2f %16.2f\n", "sorted", sortedTime * 1e3, sortedStats.overdraw);
+	if (inOrderStats.fragments)
+		printf("%.1f%% fewer fragments shaded\n", 100.0 * (1.0 - (double)sortedStats.fragments / (double)inOrderStats.fragments));
+	printf("%zu of %d channel values differ\n", differ, WIDTH * HEIGHT * 4);
+
+	hl_releaseTexture(window, texture);
+	free(inOrder);
+	free(sorted);
+	hl_closeWindow(window);
+	return differ != 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * micro-benchmark for the pixel conversion kernels
+ * compares the best SIMD kernels against the scalar fallback and checks they produce the same output
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal.h"
+
+#define PIXEL_COUNT (1920 * 1080 + 7) /* odd size so the scalar tails are exercised */
+#define ITERATIONS 50
+
+typedef enum kernelType {
+	KERNEL_RGB = 0,
+	KERNEL_BGR,
+	KERNEL_BGRA,
+	KERNEL_GRAY_ALPHA,
+	KERNEL_COVERAGE,
+	KERNEL_COUNT
+} kernelType;
+
+static const char* kernelNames[KERNEL_COUNT] = { "rgbToRGBA", "bgrToRGBA", "bgraToRGBA", "grayAlphaToRGBA", "coverageToRGBA" };
+
+static const char* simdName(hl_simdLevel level) {
+	switch (level) {
+		case HL_SIMD_SSE2: return "SSE2";
+		case HL_SIMD_SSSE3: return "SSSE3";
+		case HL_SIMD_AVX2: return "AVX2";
+		case HL_SIMD_NEON: return "NEON";
+		default: break;
+	}
+	return "scalar";
+}
+
+static void runKernel(const hl_pixelOps* ops, kernelType type, uint8_t* dst, const uint8_t* src, size_t count) {
+	switch (type) {
+		case KERNEL_RGB: ops->rgbToRGBA(dst, src, count); break;
+		case KERNEL_BGR: ops->bgrToRGBA(dst, src, count); break;
+		case KERNEL_BGRA: ops->bgraToRGBA(dst, src, count); break;
+		case KERNEL_GRAY_ALPHA: ops->grayAlphaToRGBA(dst, src, count); break;
+		case KERNEL_COVERAGE: ops->coverageToRGBA(dst, src, count); break;
+		default: break;
+	}
+}
+
+static double timeKernel(const hl_pixelOps* ops, kernelType type, uint8_t* dst, const uint8_t* src, size_t count) {
+	double start = hl_getTime();
+
+	size_t i;
+	for (i = 0; i < ITERATIONS; i++)
+		runKernel(ops, type, dst, src, count);
+
+	return (hl_getTime() - start) / ITERATIONS;
+}
+
+int main(void) {
+	const hl_pixelOps* scalar = hl_getPixelOpsLevel(HL_SIMD_SCALAR);
+	const hl_pixelOps* best = hl_getPixelOps();
+
+	uint8_t* src = (uint8_t*)malloc(PIXEL_COUNT * 4);
+	uint8_t* dstScalar = (uint8_t*)malloc(PIXEL_COUNT * 4);
+	uint8_t* dstBest = (uint8_t*)malloc(PIXEL_COUNT * 4);
+
+	size_t i;
+	srand(1);
+	for (i = 0; i < PIXEL_COUNT * 4; i++)
+		src[i] = (uint8_t)rand();
+
+	printf("simd level: %s\n", simdName(best->level));
+	printf("%-18s %12s %12s %10s\n", "kernel", "scalar MP/s", "simd MP/s", "speedup");
+
+	int failed = 0;
+	for (i = 0; i < KERNEL_COUNT; i++) {
+		double scalarTime = timeKernel(scalar, (kernelType)i, dstScalar, src, PIXEL_COUNT);
+		double bestTime = timeKernel(best, (kernelType)i, dstBest, src, PIXEL_COUNT);
+
+		bool match = memcmp(dstScalar, dstBest, PIXEL_COUNT * 4) == 0;
+		if (match == false)
+			failed = 1;
+
+		printf("%-18s %12.1f %12.1f %9.2fx%s\n", kernelNames[i],
+				PIXEL_COUNT / scalarTime / 1e6, PIXEL_COUNT / bestTime / 1e6, scalarTime / bestTime,
+				match ? "" : "  (output mismatch)");
+	}
+
+	free(src);
+	free(dstScalar);
+	free(dstBest);
+
+	return failed;
+}
@@ -0,0 +1,86 @@
+/*
+ * benchmark for hl_drawPolyline
+ * draws a dense noisy series into a headless window with and without column decimation,
+ * reports the frame time of both and how many pixels the decimated frame differs by
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <hoglib.h>
+
+#define WIDTH 1024
+#define HEIGHT 256
+#define POINT_COUNT 2000000
+#define ITERATIONS 10
+
+static uint32_t nextRandom(uint32_t* state) {
+	*state = *state * 1664525u + 1013904223u;
+	return *state >> 8;
+}
+
+static double drawSeries(hl_windowHandle window, const hl_vec2D* points, size_t count, bool decimate, int iterations, uint8_t* pixels) {
+	hl_setPolylineDecimation(window, decimate);
+
+	double best = 1e9;
+	int i;
+	for (i = 0; i < iterations; i++) {
+		double start = hl_getTime();
+
+		hl_startFrame(window);
+		hl_clear(window, HL_RGB(255, 255, 255));
+		hl_setColor(window, HL_RGB(0, 0, 0));
+		hl_drawPolyline(window, points, count, 1.0f);
+		hl_finishFrame(window);
+		hl_readPixels(window, HL_RECT(0, 0, WIDTH, HEIGHT), pixels);
+
+		double elapsed = hl_getTime() - start;
+		if (elapsed < best)
+			best = elapsed;
+	}
+
+	return best;
+}
+
+int main(void) {
+	hl_windowHandle window = hl_createWindow("polyline", WIDTH, HEIGHT, HL_WINDOW_HEADLESS);
+	if (window == NULL) {
+		printf("couldn't create the window\n");
+		return 1;
+	}
+
+	hl_vec2D* points = (hl_vec2D*)malloc(POINT_COUNT * sizeof(hl_vec2D));
+	uint8_t* full = (uint8_t*)malloc(WIDTH * HEIGHT * 4);
+	uint8_t* decimated = (uint8_t*)malloc(WIDTH * HEIGHT * 4);
+
+	/* a slow wave with noise on top, like a sampled sensor */
+	uint32_t state = 1;
+	size_t i;
+	for (i = 0; i < POINT_COUNT; i++) {
+		float t = (float)i / (float)POINT_COUNT;
+		float noise = (float)(nextRandom(&state) % 1000) / 1000.0f - 0.5f;
+		points[i].x = t * (WIDTH - 1);
+		points[i].y = HEIGHT * 0.5f + sinf(t * 20.0f) * HEIGHT * 0.3f + noise * 30.0f;
+	}
+
+	/* the full series is slow enough that one frame is a stable measurement */
+	double fullTime = drawSeries(window, points, POINT_COUNT, false, 1, full);
+	double decimatedTime = drawSeries(window, points, POINT_COUNT, true, ITERATIONS, decimated);
+
+	size_t differing = 0;
+	for (i = 0; i < WIDTH * HEIGHT; i++)
+		differing += memcmp(&full[i * 4], &decimated[i * 4], 4) != 0;
+
+	printf("%d points on %d columns\n", POINT_COUNT, WIDTH);
+	printf("%12s %10.2f ms/frame\n", "full", fullTime * 1e3);
+	printf("%12s %10.2f ms/frame\n", "decimated", decimatedTime * 1e3);
+	printf("%zu of %d pixels differ (%.3f%%)\n", differing, WIDTH * HEIGHT, 100.0 * (double)differing / (WIDTH * HEIGHT));
+
+	free(points);
+	free(full);
+	free(decimated);
+	hl_closeWindow(window);
+	return 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * benchmark for hl_prewarmFont
+ * times the first frame that shows a page of Cyrillic text, once with the glyphs rasterized in that frame
+ * and once after they were prewarmed, reports how long the frames spent committing prewarmed glyphs took
+ * and checks both frames draw the same image
+ * usage: prewarm [font] [software|gl_modern], the software renderer is the default so it runs without a display
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <hoglib.h>
+
+#define WIDTH 800
+#define HEIGHT 300
+
+static const char* lines[] = {
+	"Съешь же ещё этих мягких французских булок, да выпей чаю.",
+	"Широкая электрификация южных губерний даст мощный толчок",
+	"подъёму сельского хозяйства. В чащах юга жил бы цитрус?",
+	"Да, но фальшивый экземпляр! ЭХ, ЖЁСТКИЙ ПЛЮЩ ЦАРИЦЫ."
+};
+#define LINE_COUNT (sizeof(lines) / sizeof(lines[0]))
+
+static const hl_codepointRange cyrillic[] = { { 0x400, 0x45F } };
+static const uint32_t sizes[] = { 24, 32 };
+
+static double drawFrame(hl_windowHandle window, hl_fontHandle font, bool text, uint8_t* pixels) {
+	double start = hl_getTime();
+
+	hl_startFrame(window);
+	hl_clear(window, HL_RGB(255, 255, 255));
+	hl_setColor(window, HL_RGB(0, 0, 0));
+
+	if (text) {
+		size_t i;
+		hl_setFont(window, font);
+		for (i = 0; i < LINE_COUNT; i++)
+			hl_drawText(window, lines[i], 10, 10 + (int32_t)i * 70, (int32_t)sizes[i % 2]);
+	} else {
+		hl_drawRect(window, HL_RECT(10, 10, 100, 20)); /* a loading screen */
+	}
+
+	hl_finishFrame(window);
+	hl_readPixels(window, HL_RECT(0, 0, WIDTH, HEIGHT), pixels); /* wait for the GPU */
+	return hl_getTime() - start;
+}
+
+int main(int argc, char** argv) {
+	const char* path = (argc > 1) ? argv[1] : "COMICSANS.ttf";
+	const char* name = (argc > 2) ? argv[2] : "software";
+	hl_windowFlags flags = HL_WINDOW_HEADLESS;
+	if (strcmp(name, "gl_modern") == 0)
+		flags = HL_RENDERER_GL_MODERN;
+
+	hl_windowHandle window = hl_createWindow("prewarm", WIDTH, HEIGHT, flags);
+	if (window == NULL) {
+		printf("couldn't create the window\n");
+		return 1;
+	}
+
+	uint8_t* cold = (uint8_t*)malloc(WIDTH * HEIGHT * 4);
+	uint8_t* warm = (uint8_t*)malloc(WIDTH * HEIGHT * 4);
+
+	/* two fonts from the same file share the face but each has its own atlas */
+	hl_fontHandle coldFont = hl_loadFont(window, path, 32);
+	hl_fontHandle warmFont = hl_loadFont(window, path, 32);
+	if (coldFont == NULL || warmFont == NULL) {
+		printf("couldn't load %s\n", path);
+		return 1;
+	}
+
+	/* the first text the process draws also pays for the driver setting up the text path, keep that out of the measurement */
+	hl_startFrame(window);
+	hl_setFont(window, coldFont);
+	hl_drawText(window, "warm up", 10, 10, 24);
+	hl_finishFrame(window);
+	drawFrame(window, NULL, false, cold);
+
+	double coldFirst = drawFrame(window, coldFont, true, cold);
+	double coldSecond = drawFrame(window, coldFont, true, cold);
+
+	hl_prewarmFont(window, warmFont, cyrillic, 1, sizes, 2);
+
+	int frames = 0;
+	double total = 0.0, longest = 0.0;
+	while (hl_getPrewarmProgress(window, warmFont) < 1.0f) {
+		double elapsed = drawFrame(window, NULL, false, warm);
+		total += elapsed;
+		if (elapsed > longest)
+			longest = elapsed;
+		frames += 1;
+	}
+
+	double warmFirst = drawFrame(window, warmFont, true, warm);
+
+	size_t differ = 0, i;
+	for (i = 0; i < WIDTH * HEIGHT * 4; i++)
+		differ += cold[i] != warm[i];
+
+	printf("%s, %zu lines at sizes %u and %u, %s\n", path, LINE_COUNT, sizes[0], sizes[1], flags == HL_WINDOW_HEADLESS ? "software" : name);
+	printf("%28s %10s\n", "", "ms");
+	printf("%28s %10.2f\n", "first text frame", coldFirst * 1e3);
+	printf("%28s %10.2f\n", "second text frame", coldSecond * 1e3);
+	printf("%28s %10.2f\n", "first frame after prewarm", warmFirst * 1e3);
+	printf("%d frames while prewarming, %.2f ms average, %.2f ms longest\n", frames, frames ? total / frames * 1e3 : 0.0, longest * 1e3);
+	printf("%zu of %d channel values differ\n", differ, WIDTH * HEIGHT * 4);
+
+	hl_releaseFont(window, warmFont);
+	hl_releaseFont(window, coldFont);
+	free(cold);
+	free(warm);
+	hl_closeWindow(window);
+	return differ != 0;
+}
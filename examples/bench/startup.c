@@ -0,0 +1,71 @@
+/*
+ * benchmark for hl_setProgramCacheDirectory
+ * times creating a HL_RENDERER_GL_MODERN window (which builds the default shader program) without the program cache,
+ * with an empty cache that has to be filled and with a filled one
+ * Mesa only offers program binaries while its own shader cache is on, so there the gain is what skipping its lookups saves
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+	#include <direct.h>
+	#define makeDirectory(path) _mkdir(path)
+#else
+	#include <sys/stat.h>
+	#define makeDirectory(path) mkdir(path, 0755)
+#endif
+
+#include <hoglib.h>
+
+#define CACHE_DIR "program_cache"
+#define ITERATIONS 10
+
+static double createWindow(void) {
+	double start = hl_getTime();
+	hl_windowHandle window = hl_createWindow("startup", 320, 240, HL_RENDERER_GL_MODERN);
+	if (window == NULL)
+		return -1.0;
+
+	/* the first frame, so a driver that finishes linking lazily pays for it here */
+	hl_startFrame(window);
+	hl_clear(window, HL_RGB(0, 0, 0));
+	hl_drawRect(window, HL_RECT(0, 0, 10, 10));
+	hl_finishFrame(window);
+
+	double elapsed = hl_getTime() - start;
+	hl_closeWindow(window);
+	return elapsed;
+}
+
+static double averageCreate(void) {
+	double total = 0.0;
+	int i;
+	for (i = 0; i < ITERATIONS; i++)
+		total += createWindow();
+	return total / ITERATIONS;
+}
+
+int main(void) {
+	makeDirectory(CACHE_DIR);
+
+	/* the first window loads the driver, keep that out of the measurement */
+	if (createWindow() < 0.0) {
+		printf("couldn't create the window\n");
+		return 1;
+	}
+
+	hl_setProgramCacheDirectory(NULL);
+	double uncached = averageCreate();
+
+	hl_setProgramCacheDirectory(CACHE_DIR);
+	double cold = createWindow(); /* compiles and writes the entry */
+	double warm = averageCreate();
+	hl_setProgramCacheDirectory(NULL);
+
+	printf("%24s %10s\n", "", "ms");
+	printf("%24s %10.2f\n", "no cache", uncached * 1e3);
+	printf("%24s %10.2f\n", "cache miss (writes)", cold * 1e3);
+	printf("%24s %10.2f\n", "cache hit", warm * 1e3);
+	return 0;
+}
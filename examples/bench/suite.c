@@ -0,0 +1,393 @@
+/*
+ * benchmark suite run by `make bench`
+ * micro benchmarks for rects, glyphs, texture uploads, batches and text layout, and a macro benchmark that draws a scene
+ * while capturing it and then replays the capture, every result is the median of several runs and printed as a JSON line
+ * it runs headless on the software renderer by default, the OpenGL renderers need a display (Xvfb and Mesa's llvmpipe work)
+ *
+ * usage: suite [--renderer software|gl_modern|gl_legacy] [--font path] [--runs n] [--capture path] [--replay path]
+ * --capture keeps the scene's capture at path, --replay benchmarks a capture made by an app with HL_CAPTURE=path
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <hoglib.h>
+
+#define WIDTH 640
+#define HEIGHT 480
+#define MAX_RUNS 32
+
+#define RECTS 2000 /* 4 vertices each, RSGL flushes after 8192 */
+#define RECT_FRAMES 50
+#define TEXT_LINES 20
+#define TEXT_FRAMES 50
+#define UPLOAD_SIZE 512
+#define UPLOADS 32
+#define BATCH_QUADS 1000
+#define BATCH_FRAMES 50
+#define SCENE_FRAMES 60
+
+static const char* text = "The quick brown fox jumps over the lazy dog 0123456789";
+
+typedef struct suite {
+	hl_windowHandle window;
+	hl_windowFlags flags;
+	const char* renderer;
+	const char* fontPath;
+	hl_fontHandle font;
+	hl_textureHandle textures[2];
+	int runs;
+	uint8_t pixel[4];
+} suite;
+
+static int compareTimes(const void* a, const void* b) {
+	double x = *(const double*)a, y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+/* wait for the GPU so the time covers the whole frame */
+static void finish(suite* s, hl_windowHandle window) {
+	hl_finishFrame(window);
+	hl_readPixels(window, HL_RECT(0, 0, 1, 1), s->pixel);
+}
+
+static void report(const suite* s, const char* bench, double value, const char* unit) {
+	printf("{\"bench\":\"%s\",\"value\":%.6g,\"unit\":\"%s\",\"renderer\":\"%s\",\"runs\":%d}\n", bench, value, unit, s->renderer, s->runs);
+	fflush(stdout);
+}
+
+/* run the work once to warm up, then time it once per run and return the median seconds */
+static double measure(suite* s, void (*work)(suite* s, void* arg), void* arg) {
+	double times[MAX_RUNS];
+	int i;
+
+	work(s, arg);
+	for (i = 0; i < s->runs; i++) {
+		double start = hl_getTime();
+		work(s, arg);
+		times[i] = hl_getTime() - start;
+	}
+
+	qsort(times, (size_t)s->runs, sizeof(double), compareTimes);
+	return times[s->runs / 2];
+}
+
+static void drawRects(suite* s, void* arg) {
+	int frame, i;
+	(void)(arg);
+
+	for (frame = 0; frame < RECT_FRAMES; frame++) {
+		hl_startFrame(s->window);
+		hl_clear(s->window, HL_RGB(0, 0, 0));
+
+		for (i = 0; i < RECTS; i++) {
+			int x = (i * 7 + frame) % WIDTH, y = (i * 13) % HEIGHT;
+			hl_setColor(s->window, HL_RGB(i & 0xFF, (i >> 8) & 0xFF, 128));
+			hl_drawRect(s->window, HL_RECT(x, y, 8, 8));
+		}
+
+		finish(s, s->window);
+	}
+}
+
+/* `arg` is the clip, a clip outside the window drops the glyphs after they're laid out */
+static void drawText(suite* s, void* arg) {
+	const hl_rect* clip = (const hl_rect*)arg;
+	int frame, i;
+
+	for (frame = 0; frame < TEXT_FRAMES; frame++) {
+		hl_startFrame(s->window);
+		hl_clear(s->window, HL_RGB(255, 255, 255));
+		hl_setColor(s->window, HL_RGB(0, 0, 0));
+		hl_setFont(s->window, s->font);
+
+		if (clip)
+			hl_pushClip(s->window, *clip);
+		for (i = 0; i < TEXT_LINES; i++)
+			hl_drawText(s->window, text, 4, 4 + i * 22, 18);
+		if (clip)
+			hl_popClip(s->window);
+
+		finish(s, s->window);
+	}
+}
+
+static void uploadTextures(suite* s, void* arg) {
+	hl_textureBlob* blob = (hl_textureBlob*)arg;
+	int i;
+
+	for (i = 0; i < UPLOADS; i++) {
+		hl_textureHandle texture = hl_loadTextureFromBlob(s->window, blob);
+		hl_releaseTexture(s->window, texture);
+	}
+
+	/* the upload only has to be finished once the texture is used, make sure it is */
+	hl_startFrame(s->window);
+	finish(s, s->window);
+}
+
+/* `arg` is non NULL to switch the texture on every quad, which starts a new batch */
+static void drawBatches(suite* s, void* arg) {
+	int frame, i;
+
+	for (frame = 0; frame < BATCH_FRAMES; frame++) {
+		hl_startFrame(s->window);
+		hl_clear(s->window, HL_RGB(0, 0, 0));
+
+		for (i = 0; i < BATCH_QUADS; i++) {
+			int x = (i * 7) % WIDTH, y = (i * 13) % HEIGHT;
+			hl_setTexture(s->window, s->textures[arg ? (i & 1) : 0]);
+			hl_drawRect(s->window, HL_RECT(x, y, 8, 8));
+		}
+
+		finish(s, s->window);
+	}
+}
+
+static void drawScene(suite* s, hl_drawList list, hl_tilemapHandle tilemap, hl_textureHandle atlas, hl_fontHandle font, int frame) {
+	hl_vec2D wave[256];
+	int i;
+
+	hl_startFrame(s->window);
+	hl_clear(s->window, HL_RGB(20, 20, 30));
+
+	hl_drawTilemap(s->window, tilemap, (float)(frame * 3), (float)(frame * 2), 1.0f);
+
+	for (i = 0; i < 500; i++) {
+		int x = (i * 37 + frame * 5) % WIDTH, y = (i * 53) % HEIGHT;
+		hl_setColor(s->window, HL_RGBA(i & 0xFF, 255 - (i & 0xFF), 128, 200));
+		hl_drawRect(s->window, HL_RECT(x, y, 12, 12));
+	}
+
+	for (i = 0; i < 256; i++)
+		wave[i] = (hl_vec2D){ (float)i * 2.5f, 240.0f + (float)(((i * 11 + frame * 7) % 64) - 32) };
+	hl_setColor(s->window, HL_RGB(255, 255, 0));
+	hl_drawPolyline(s->window, wave, 256, 2.0f);
+
+	/* a HUD recorded into a draw list, as another thread would */
+	hl_setColor(list, HL_RGBA(0, 0, 0, 160));
+	hl_drawRect(list, HL_RECT(0, 0, WIDTH, 40));
+	for (i = 0; i < 8; i++) {
+		hl_setTextureSource(list, atlas, HL_RECT(0, 0, 0.5f, 0.5f));
+		hl_drawRect(list, HL_RECT(8 + i * 40, 4, 32, 32));
+	}
+
+	if (font) {
+		hl_setTexture(s->window, 0);
+		hl_setColor(s->window, HL_RGB(255, 255, 255));
+		hl_setFont(s->window, font);
+		hl_pushClip(s->window, HL_RECT(0, 400, WIDTH, 80));
+		for (i = 0; i < 3; i++)
+			hl_drawText(s->window, text, 8, 404 + i * 24, 20);
+		hl_popClip(s->window);
+	}
+
+	finish(s, s->window);
+}
+
+/* draw the scene live while capturing it, returns the last frame's pixels */
+static uint8_t* captureScene(suite* s, const char* path, double* elapsed) {
+	uint8_t* pixels = (uint8_t*)malloc(WIDTH * HEIGHT * 4);
+	int frame;
+
+	if (hl_startCapture(s->window, path) == false) {
+		free(pixels);
+		return NULL;
+	}
+
+	/* the resources are made after the capture started so it has them */
+	uint8_t atlas[16 * 16 * 4];
+	for (frame = 0; frame < 16 * 16; frame++) {
+		uint8_t v = (uint8_t)((((frame % 16) / 4 + (frame / 16) / 4) & 1) ? 200 : 90);
+		atlas[frame * 4 + 0] = v;
+		atlas[frame * 4 + 1] = (uint8_t)(v / 2);
+		atlas[frame * 4 + 2] = (uint8_t)(255 - v);
+		atlas[frame * 4 + 3] = 255;
+	}
+
+	hl_textureBlob blob = { atlas, 16, 16, HL_TEXTURE_DATA_INT, HL_FORMAT_RGBA, HL_FORMAT_RGBA, HL_FILTER_NEAREST, HL_FILTER_NEAREST };
+	hl_textureHandle texture = hl_loadTextureFromBlob(s->window, &blob);
+
+	hl_tilemapHandle tilemap = hl_createTilemap(s->window, 128, 128, 16.0f, 16.0f, texture);
+	uint32_t x, y;
+	for (y = 0; y < 128; y++) {
+		for (x = 0; x < 128; x++) {
+			float u = (float)((x + y) % 2) * 0.5f;
+			hl_setTile(tilemap, x, y, HL_RECT(u, 0, 0.5f, 0.5f), HL_RGB(255, 255, 255));
+		}
+	}
+
+	hl_drawList list = hl_createDrawList(s->window);
+	hl_fontHandle font = s->font ? hl_loadFont(s->window, s->fontPath, 40) : NULL;
+
+	double start = hl_getTime();
+	for (frame = 0; frame < SCENE_FRAMES; frame++)
+		drawScene(s, list, tilemap, texture, font, frame);
+	*elapsed = hl_getTime() - start;
+
+	hl_readPixels(s->window, HL_RECT(0, 0, WIDTH, HEIGHT), pixels);
+
+	if (font)
+		hl_releaseFont(s->window, font);
+	hl_releaseDrawList(s->window, list);
+	hl_releaseTilemap(s->window, tilemap);
+	hl_releaseTexture(s->window, texture);
+	hl_stopCapture();
+	return pixels;
+}
+
+static void replay(suite* s, void* arg) {
+	hl_captureHandle capture = (hl_captureHandle)arg;
+	while (hl_replayCaptureFrame(s->window, capture)) {}
+	hl_rewindCapture(s->window, capture);
+}
+
+static void replayCapture(suite* s, const char* path) {
+	hl_captureHandle capture = hl_loadCapture(path);
+	if (capture == NULL) {
+		fprintf(stderr, "couldn't load the capture %s\n", path);
+		return;
+	}
+
+	int32_t w, h;
+	hl_getCaptureSize(capture, &w, &h);
+	size_t frames = hl_getCaptureFrameCount(capture);
+
+	hl_windowHandle window = s->window;
+	s->window = hl_createWindow("replay", w, h, s->flags);
+	if (s->window == NULL) {
+		fprintf(stderr, "couldn't create the replay window\n");
+		hl_releaseCapture(window, capture);
+		s->window = window;
+		return;
+	}
+
+	double time = measure(s, replay, capture);
+	report(s, "replay", (double)frames / time, "frames/s");
+
+	hl_releaseCapture(s->window, capture);
+	hl_closeWindow(s->window);
+	s->window = window;
+}
+
+int main(int argc, char** argv) {
+	const char* capturePath = NULL;
+	const char* replayPath = NULL;
+	int i;
+
+	suite s;
+	memset(&s, 0, sizeof(s));
+	s.renderer = "software";
+	s.flags = HL_WINDOW_HEADLESS;
+	s.fontPath = "COMICSANS.ttf";
+	s.runs = 5;
+
+	for (i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "--renderer") == 0)
+			s.renderer = argv[i + 1];
+		else if (strcmp(argv[i], "--font") == 0)
+			s.fontPath = argv[i + 1];
+		else if (strcmp(argv[i], "--runs") == 0)
+			s.runs = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--capture") == 0)
+			capturePath = argv[i + 1];
+		else if (strcmp(argv[i], "--replay") == 0)
+			replayPath = argv[i + 1];
+	}
+
+	if (s.runs < 1) s.runs = 1;
+	if (s.runs > MAX_RUNS) s.runs = MAX_RUNS;
+
+	if (strcmp(s.renderer, "gl_modern") == 0)
+		s.flags = HL_RENDERER_GL_MODERN;
+	else if (strcmp(s.renderer, "gl_legacy") == 0)
+		s.flags = HL_RENDERER_GL_LEGACY;
+	else
+		s.renderer = "software";
+
+	s.window = hl_createWindow("suite", WIDTH, HEIGHT, s.flags);
+	if (s.window == NULL) {
+		fprintf(stderr, "couldn't create the %s window\n", s.renderer);
+		return 1;
+	}
+
+	s.font = hl_loadFont(s.window, s.fontPath, 40);
+	if (s.font == NULL)
+		fprintf(stderr, "couldn't load %s, skipping the text benchmarks (pass --font)\n", s.fontPath);
+
+	uint8_t* upload = (uint8_t*)malloc(UPLOAD_SIZE * UPLOAD_SIZE * 4);
+	for (i = 0; i < UPLOAD_SIZE * UPLOAD_SIZE * 4; i++)
+		upload[i] = (uint8_t)(i * 31);
+
+	uint8_t small[2][4 * 4 * 4];
+	memset(small[0], 0xFF, sizeof(small[0]));
+	memset(small[1], 0x80, sizeof(small[1]));
+	for (i = 0; i < 2; i++) {
+		hl_textureBlob blob = { small[i], 4, 4, HL_TEXTURE_DATA_INT, HL_FORMAT_RGBA, HL_FORMAT_RGBA, HL_FILTER_NEAREST, HL_FILTER_NEAREST };
+		s.textures[i] = hl_loadTextureFromBlob(s.window, &blob);
+	}
+
+	double time = measure(&s, drawRects, NULL);
+	report(&s, "rects", (double)RECTS * RECT_FRAMES / time, "rects/s");
+
+	if (s.font) {
+		size_t glyphs = strlen(text) * TEXT_LINES * TEXT_FRAMES;
+		hl_rect outside = HL_RECT(-100, -100, 1, 1);
+
+		time = measure(&s, drawText, NULL);
+		report(&s, "glyphs", (double)glyphs / time, "glyphs/s");
+
+		time = measure(&s, drawText, &outside);
+		report(&s, "text_layout", (double)glyphs / time, "glyphs/s");
+	}
+
+	hl_textureBlob blob = { upload, UPLOAD_SIZE, UPLOAD_SIZE, HL_TEXTURE_DATA_INT, HL_FORMAT_RGBA, HL_FORMAT_RGBA, HL_FILTER_LINEAR, HL_FILTER_LINEAR };
+	time = measure(&s, uploadTextures, &blob);
+	report(&s, "texture_upload", (double)UPLOAD_SIZE * UPLOAD_SIZE * 4 * UPLOADS / time / (1024.0 * 1024.0), "MiB/s");
+
+	/* a batch per quad against one batch for all of them, the difference is what the extra batches cost */
+	double batched = measure(&s, drawBatches, NULL);
+	double split = measure(&s, drawBatches, &s);
+	report(&s, "batch_flush", (split - batched) / ((double)(BATCH_QUADS - 1) * BATCH_FRAMES) * 1e9, "ns/batch");
+
+	const char* scenePath = capturePath ? capturePath : "suite_scene.hlcap";
+	double live = 0.0;
+	uint8_t* livePixels = captureScene(&s, scenePath, &live);
+	if (livePixels) {
+		report(&s, "scene", SCENE_FRAMES / live, "frames/s");
+
+		hl_captureHandle capture = hl_loadCapture(scenePath);
+		time = measure(&s, replay, capture);
+		report(&s, "scene_replay", (double)hl_getCaptureFrameCount(capture) / time, "frames/s");
+
+		/* the replay has to draw what the app drew */
+		uint8_t* replayPixels = (uint8_t*)malloc(WIDTH * HEIGHT * 4);
+		while (hl_replayCaptureFrame(s.window, capture)) {}
+		hl_readPixels(s.window, HL_RECT(0, 0, WIDTH, HEIGHT), replayPixels);
+
+		size_t differ = 0, j;
+		for (j = 0; j < WIDTH * HEIGHT * 4; j++)
+			differ += livePixels[j] != replayPixels[j];
+		report(&s, "scene_replay_mismatch", (double)differ, "channels");
+
+		hl_releaseCapture(s.window, capture);
+		free(replayPixels);
+		free(livePixels);
+		if (capturePath == NULL)
+			remove(scenePath);
+	} else {
+		fprintf(stderr, "couldn't write the capture %s\n", scenePath);
+	}
+
+	if (replayPath)
+		replayCapture(&s, replayPath);
+
+	for (i = 0; i < 2; i++)
+		hl_releaseTexture(s.window, s.textures[i]);
+	if (s.font)
+		hl_releaseFont(s.window, s.font);
+	free(upload);
+	hl_closeWindow(s.window);
+	return 0;
+}
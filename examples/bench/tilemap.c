@@ -0,0 +1,120 @@
+/*
+ * benchmark for hl_drawTilemap
+ * draws worlds of growing size through a fixed window, once with a hl_drawRect per tile and once as a tilemap,
+ * the tilemap's frame time should stay flat since only the chunks in view are drawn
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <hoglib.h>
+
+#define WIDTH 640
+#define HEIGHT 480
+#define TILE_SIZE 16
+#define ITERATIONS 5
+
+static const uint32_t worldSizes[] = { 64, 256, 1024 }; /* tiles per side */
+
+static hl_color tileColor(uint32_t x, uint32_t y) {
+	return HL_RGB((uint8_t)(x * 5), (uint8_t)(y * 3), (uint8_t)((x ^ y) * 7));
+}
+
+/* the camera pans a little every frame so the visible chunks change */
+static void cameraAt(int frame, float* x, float* y) {
+	*x = 100.0f + (float)frame * 37.0f;
+	*y = 80.0f + (float)frame * 23.0f;
+}
+
+static double drawRects(hl_windowHandle window, uint32_t size) {
+	double best = 1e9;
+	int i;
+	for (i = 0; i < ITERATIONS; i++) {
+		float cameraX, cameraY;
+		cameraAt(i, &cameraX, &cameraY);
+
+		double start = hl_getTime();
+		hl_startFrame(window);
+		hl_clear(window, HL_RGB(0, 0, 0));
+
+		uint32_t x, y;
+		for (y = 0; y < size; y++) {
+			for (x = 0; x < size; x++) {
+				hl_setColor(window, tileColor(x, y));
+				hl_drawRect(window, HL_RECT((float)(x * TILE_SIZE) - cameraX, (float)(y * TILE_SIZE) - cameraY, TILE_SIZE, TILE_SIZE));
+			}
+		}
+
+		hl_finishFrame(window);
+
+		double elapsed = hl_getTime() - start;
+		if (elapsed < best)
+			best = elapsed;
+	}
+
+	return best;
+}
+
+static double drawTilemap(hl_windowHandle window, hl_tilemapHandle map, uint32_t size, bool edit) {
+	double best = 1e9;
+	int i;
+	for (i = 0; i < ITERATIONS; i++) {
+		float cameraX, cameraY;
+		cameraAt(i, &cameraX, &cameraY);
+
+		double start = hl_getTime();
+		hl_startFrame(window);
+		hl_clear(window, HL_RGB(0, 0, 0));
+
+		/* one changed tile per frame, in view, so its chunk is rebuilt */
+		if (edit) {
+			uint32_t x = (uint32_t)(cameraX / TILE_SIZE) + 1, y = (uint32_t)(cameraY / TILE_SIZE) + 1;
+			if (x < size && y < size)
+				hl_setTile(map, x, y, HL_RECT(0, 0, 1, 1), HL_RGB(255, 255, 255));
+		}
+
+		hl_drawTilemap(window, map, cameraX, cameraY, 1.0f);
+		hl_finishFrame(window);
+
+		double elapsed = hl_getTime() - start;
+		if (elapsed < best)
+			best = elapsed;
+	}
+
+	return best;
+}
+
+int main(void) {
+	hl_windowHandle window = hl_createWindow("tilemap", WIDTH, HEIGHT, HL_WINDOW_HEADLESS);
+	if (window == NULL) {
+		printf("couldn't create the window\n");
+		return 1;
+	}
+
+	printf("%dx%d window, %dpx tiles\n", WIDTH, HEIGHT, TILE_SIZE);
+	printf("%10s %14s %14s %14s\n", "world", "rects ms", "tilemap ms", "+1 edit ms");
+
+	size_t i;
+	for (i = 0; i < sizeof(worldSizes) / sizeof(worldSizes[0]); i++) {
+		uint32_t size = worldSizes[i];
+		hl_tilemapHandle map = hl_createTilemap(window, size, size, TILE_SIZE, TILE_SIZE, NULL);
+
+		uint32_t x, y;
+		for (y = 0; y < size; y++)
+			for (x = 0; x < size; x++)
+				hl_setTile(map, x, y, HL_RECT(0, 0, 1, 1), tileColor(x, y));
+
+		/* the first frames build every chunk they see, warm them up outside of the measurement */
+		drawTilemap(window, map, size, false);
+
+		double rects = drawRects(window, size);
+		double tilemap = drawTilemap(window, map, size, false);
+		double edited = drawTilemap(window, map, size, true);
+		printf("%5u^2 %14.2f %14.2f %14.2f\n", size, rects * 1e3, tilemap * 1e3, edited * 1e3);
+
+		hl_releaseTilemap(window, map);
+	}
+
+	hl_closeWindow(window);
+	return 0;
+}
@@ -169,10 +169,13 @@ typedef enum hl_windowFlags {
 	HL_WINDOW_FOCUS_ON_SHOW = HL_BIT(12), /*!< focus the window when it's shown */
 	HL_WINDOW_MINIMIZE = HL_BIT(13), /*!< focus the window when it's shown */
 	HL_WINDOW_FOCUS = HL_BIT(14), /*!< if the window is in focus */
+	HL_WINDOW_HEADLESS = HL_BIT(18), /*!< render offscreen without a display server, always uses the software renderer */
+	HL_WINDOW_RENDER_THREAD = HL_BIT(19), /*!< submit and present frames on a render thread that owns the OpenGL context, ignored by the software renderer */
 
 	/* renderer flags */
 	HL_RENDERER_GL_LEGACY = HL_BIT(15), /*!< use the modern OpenGL renderer */
 	HL_RENDERER_GL_MODERN = HL_BIT(16), /*!< use the legacy OpenGL renderer */
+	HL_RENDERER_SOFTWARE = HL_BIT(17), /*!< use the CPU renderer, draws into a window surface without OpenGL */
 } hl_windowFlags;
 
 /* handle to the source RGFW window */
@@ -324,6 +327,117 @@ typedef enum hl_keymod {
 	HL_MOD_SCROLLLOCK = HL_BIT(6)
 } hl_keymod;
 
+/* number of events the event queue holds by default, see hl_setEventQueueSize */
+#ifndef HL_EVENT_QUEUE_SIZE
+	#define HL_EVENT_QUEUE_SIZE 1024
+#endif
+
+/*! event types for the event queue */
+typedef enum hl_eventType {
+	HL_EVENT_NONE = 0,
+	HL_EVENT_KEY_PRESSED, /*!< a key was pressed, repeats are sent while it's held */
+	HL_EVENT_KEY_RELEASED,
+	HL_EVENT_MOUSE_BUTTON_PRESSED,
+	HL_EVENT_MOUSE_BUTTON_RELEASED,
+	HL_EVENT_MOUSE_SCROLL,
+	HL_EVENT_MOUSE_MOVED,
+	HL_EVENT_MOUSE_ENTER,
+	HL_EVENT_MOUSE_LEAVE,
+	HL_EVENT_WINDOW_RESIZED,
+	HL_EVENT_WINDOW_MOVED,
+	HL_EVENT_WINDOW_CLOSE, /*!< the user asked to close the window */
+	HL_EVENT_FOCUS_IN,
+	HL_EVENT_FOCUS_OUT,
+	HL_EVENT_USER /*!< free for events pushed with hl_pushEvent, the library never sends it */
+} hl_eventType;
+
+/*! data every event has */
+typedef struct hl_commonEvent {
+	hl_eventType type;
+	hl_windowHandle window; /*!< window the event was sent to */
+	double time; /*!< hl_getTime() when the event was received */
+} hl_commonEvent;
+
+/*! HL_EVENT_KEY_PRESSED and HL_EVENT_KEY_RELEASED */
+typedef struct hl_keyEvent {
+	hl_eventType type;
+	hl_windowHandle window;
+	double time;
+	hl_keyCode key; /*!< physical key */
+	uint8_t sym; /*!< mapped key character */
+	hl_keymod mod;
+	bool repeat; /*!< the key is being held */
+} hl_keyEvent;
+
+/*! HL_EVENT_MOUSE_BUTTON_PRESSED and HL_EVENT_MOUSE_BUTTON_RELEASED */
+typedef struct hl_mouseButtonEvent {
+	hl_eventType type;
+	hl_windowHandle window;
+	double time;
+	hl_mouseButton button;
+} hl_mouseButtonEvent;
+
+/*! HL_EVENT_MOUSE_MOVED, HL_EVENT_MOUSE_ENTER and HL_EVENT_MOUSE_LEAVE */
+typedef struct hl_mouseEvent {
+	hl_eventType type;
+	hl_windowHandle window;
+	double time;
+	int32_t x, y; /*!< position in the window */
+	float vecX, vecY; /*!< raw mouse movement */
+} hl_mouseEvent;
+
+/*! HL_EVENT_MOUSE_SCROLL */
+typedef struct hl_scrollEvent {
+	hl_eventType type;
+	hl_windowHandle window;
+	double time;
+	float x, y;
+} hl_scrollEvent;
+
+/*! HL_EVENT_WINDOW_RESIZED and HL_EVENT_WINDOW_MOVED */
+typedef struct hl_windowEvent {
+	hl_eventType type;
+	hl_windowHandle window;
+	double time;
+	int32_t x, y; /*!< new position or size of the window */
+} hl_windowEvent;
+
+/*! HL_EVENT_USER */
+typedef struct hl_userEvent {
+	hl_eventType type;
+	hl_windowHandle window;
+	double time;
+	uint64_t code;
+	void* data;
+} hl_userEvent;
+
+/*! union for all of the event types, check `type` before reading the rest */
+typedef union hl_event {
+	hl_eventType type;
+	hl_commonEvent common;
+	hl_keyEvent key;
+	hl_mouseButtonEvent button;
+	hl_mouseEvent mouse;
+	hl_scrollEvent scroll;
+	hl_windowEvent win;
+	hl_userEvent user;
+} hl_event;
+
+/* number of mouse positions kept per window and poll, see hl_getMouseHistory */
+#ifndef HL_MOUSE_HISTORY_SIZE
+	#define HL_MOUSE_HISTORY_SIZE 256
+#endif
+
+/*! a mouse position received by the window */
+typedef struct hl_mouseSample {
+	int32_t x, y; /*!< position in the window */
+	float vecX, vecY; /*!< raw mouse movement */
+	double time; /*!< hl_getTime() when it was received */
+} hl_mouseSample;
+
+/*! called for every event as it's queued, on the thread that queues it */
+typedef void (*hl_eventCallback)(const hl_event* event, void* userData);
+
 /*
  * Renderer types
  * these types are used for the renderer section of the Hoglib API
@@ -338,6 +452,27 @@ typedef void* hl_textureHandle;
 /* handle to font resource */
 typedef void* hl_fontHandle;
 
+/*
+ * handle to a draw list, it can be passed as the window to the hl_set and hl_draw functions
+ * a list is only touched by the thread recording into it, so several threads can record lists for the same window in parallel
+ * text drawn on a list uses fonts loaded by its window, it is laid out (and its glyphs rasterized) by hl_finishFrame when the list is merged
+*/
+typedef hl_windowHandle hl_drawList;
+
+/* handle to a tilemap, a grid of tiles that is uploaded once and drawn with view culling */
+typedef void* hl_tilemapHandle;
+
+/* handle to a loaded capture, see hl_startCapture */
+typedef void* hl_captureHandle;
+
+/* result of an overdraw report, see hl_beginOverdrawReport */
+typedef struct hl_overdrawStats {
+	size_t frames; /* frames finished during the report */
+	size_t pixels; /* window pixels */
+	size_t fragments; /* fragments shaded during the report */
+	float overdraw; /* fragments per pixel and frame, 1 means every pixel was shaded once */
+} hl_overdrawStats;
+
 typedef struct hl_vec2D { float x, y; } hl_vec2D;
 
 #define HL_VEC2D(x, y) (hl_vec2D){x, y}
@@ -379,6 +514,33 @@ HL_API double hl_getTime(void);
 */
 HL_API void hl_sleep(double seconds);
 
+/* bytes of the first block of each thread's frame arena, it grows to what the busiest frame needed */
+#ifndef HL_FRAME_ARENA_SIZE
+	#define HL_FRAME_ARENA_SIZE (64 * 1024)
+#endif
+
+/**!
+ * @brief allocate scratch memory that lives until the calling thread's next hl_startFrame, it's never freed by hand
+ * every thread has its own arena, which the library also uses for its temporaries (glyph rasterization, image decoding)
+ * threads that don't call hl_startFrame (e.g. workers recording draw lists) have to call hl_resetFrameArena themselves
+ * @param size in bytes
+ * @return 16 byte aligned memory
+*/
+HL_API void* hl_frameAlloc(size_t size);
+
+/**!
+ * @brief free everything hl_frameAlloc returned on the calling thread, hl_startFrame does this for the thread that calls it
+ * a worker thread should call it once per unit of work (for a draw list, after hl_finishFrame merged it and before it records the next frame),
+ * otherwise its arena keeps growing with every allocation
+*/
+HL_API void hl_resetFrameArena(void);
+
+/**!
+ * @brief release the calling thread's arena, threads the library starts do this when they return
+ * threads the application starts itself should call it before they exit if they used the library
+*/
+HL_API void hl_freeThreadArena(void);
+
 /*
  * Windowing API
  * these functions are used across the entire Hoglib API
@@ -390,6 +552,42 @@ HL_API void hl_sleep(double seconds);
 */
 HL_API void hl_pollEvents(void);
 
+/**!
+ * @brief pop the oldest event from the event queue
+ * @param [OUTPUT] the event
+ * @return false if the queue is empty
+ * @note the queue is single producer single consumer, hl_pollEvents (and hl_pushEvent) can run on an input thread while
+ *		another thread calls hl_nextEvent, but only one thread may do each
+*/
+HL_API bool hl_nextEvent(hl_event* event);
+
+/**!
+ * @brief add an event to the event queue, this is how hl_pollEvents queues the window events
+ * @param the event, `common.time` is set to hl_getTime() if it's 0
+ * @return false if the queue was full and the event was dropped
+*/
+HL_API bool hl_pushEvent(const hl_event* event);
+
+/**!
+ * @brief set the number of events the queue can hold before new events are dropped (HL_EVENT_QUEUE_SIZE by default)
+ * @param the queue size, rounded up to a power of 2
+ * @note events still in the queue are lost, call it before polling or from the consumer while nothing is being pushed
+*/
+HL_API void hl_setEventQueueSize(size_t size);
+
+/**!
+ * @brief fetch how many events were dropped because the queue was full
+ * @return the number of dropped events since the queue was created
+*/
+HL_API size_t hl_getDroppedEventCount(void);
+
+/**!
+ * @brief set a function that is called for every event as it's queued, events are still queued for hl_nextEvent
+ * @param the callback or NULL to remove it
+ * @param pointer passed to the callback
+*/
+HL_API void hl_setEventCallback(hl_eventCallback callback, void* userData);
+
 /** * @defgroup Input
 * @{ */
 
@@ -448,6 +646,31 @@ HL_API void hl_getMouseScroll(float* x, float* y);
  * @param Y [OUTPUT] a pointer for the output Y vector value
 */
 HL_API void hl_getMouseVector(float* x, float* y);
+
+/**!
+ * @brief copy out every mouse position the window received during the last hl_pollEvents, oldest first
+ * @param handle to the window object
+ * @param [OUTPUT] buffer for the samples
+ * @param the number of samples the buffer holds, if more were received the newest ones are copied
+ * @return the number of samples copied
+ * @note at most HL_MOUSE_HISTORY_SIZE samples are kept per poll, the history isn't affected by hl_setMouseCoalescing
+*/
+HL_API size_t hl_getMouseHistory(hl_windowHandle window, hl_mouseSample* samples, size_t count);
+
+/**!
+ * @brief lock the cursor to the window and report raw (unaccelerated) mouse motion at the device's rate
+ * @param handle to the window object
+ * @param true to enable it, false to release the cursor again
+ * @note positions in raw mode are accumulated from the raw motion, they aren't clamped to the window
+*/
+HL_API void hl_setRawMouseMode(hl_windowHandle window, bool enabled);
+
+/**!
+ * @brief merge mouse motion events that arrive back to back into one HL_EVENT_MOUSE_MOVED event (enabled by default)
+ * @param false to queue every motion event, use hl_getMouseHistory if you only need the positions
+ * @note merged events keep the time of the first motion, the position of the last and the sum of the movement vectors
+*/
+HL_API void hl_setMouseCoalescing(bool enabled);
 /** @} */
 
 /**!
@@ -456,10 +679,24 @@ HL_API void hl_getMouseVector(float* x, float* y);
  * @param w the requested width of the window
  * @param h the requested height of the window
  * @param flags extra arguments ((u32)0 means no flags used)
- * @return A handle to the newly created window structure
+ * @return A handle to the newly created window structure, NULL if the window or its context could not be created
 */
 HL_API hl_windowHandle hl_createWindow(const char* name, int32_t width, int32_t height, hl_windowFlags flags);
 
+/**!
+ * @brief creates a new window whose resources are shared with an existing window
+ * the OpenGL contexts are put in one share group and the new renderer reuses the default program of `share`,
+ * so textures and fonts loaded through any window of the group can be drawn on all of them
+ * the renderer types must match, otherwise this behaves like hl_createWindow
+ * @param name the requested title of the window
+ * @param w the requested width of the window
+ * @param h the requested height of the window
+ * @param flags extra arguments ((u32)0 means no flags used)
+ * @param share the window to share resources with (or NULL)
+ * @return A handle to the newly created window structure, NULL if the window or its context could not be created
+*/
+HL_API hl_windowHandle hl_createSharedWindow(const char* name, int32_t width, int32_t height, hl_windowFlags flags, hl_windowHandle share);
+
 /**!
  * @brief closes the window and frees its associated structure
  * @param win a handle to the target window
@@ -513,7 +750,15 @@ HL_API hl_rendererHandle hl_initRenderer(uint32_t type, hl_windowHandle window);
 HL_API void hl_freeRenderer(hl_rendererHandle handle);
 
 /**!
- * @brief setup renderer for the new frame
+ * @brief keep the linked shader programs of HL_RENDERER_GL_MODERN windows in a directory, so later launches skip the shader compiler
+ * entries are keyed by the shader sources and the driver's vendor, renderer and version, a missing or rejected entry is compiled and written again
+ * @param existing directory to keep the cache in, NULL (the default) turns the cache off
+ * @note only affects windows created after the call, drivers without program binaries (GL 4.1 or ARB_get_program_binary) always compile
+*/
+HL_API void hl_setProgramCacheDirectory(const char* path);
+
+/**!
+ * @brief setup renderer for the new frame, this also frees what the calling thread got from hl_frameAlloc
  * @param handle to the window surface to renderer to that includes an attached renderer
 */
 HL_API void hl_startFrame(hl_rendererHandle window);
@@ -524,6 +769,16 @@ HL_API void hl_startFrame(hl_rendererHandle window);
 */
 HL_API void hl_finishFrame(hl_windowHandle window);
 
+/* the most frames a window with HL_WINDOW_RENDER_THREAD can submit before hl_finishFrame waits for the render thread */
+#define HL_MAX_FRAME_LATENCY 3
+
+/**!
+ * @brief limit how many frames can be submitted but not presented yet when the window uses HL_WINDOW_RENDER_THREAD
+ * @param handle to the window surface
+ * @param number of frames, clamped to [1, HL_MAX_FRAME_LATENCY], 1 (the default) lets the next frame be recorded while the last one is presented
+*/
+HL_API void hl_setFrameLatency(hl_windowHandle window, uint32_t frames);
+
 
 /**!
  * @brief clear surface to a set background color
@@ -531,15 +786,51 @@ HL_API void hl_finishFrame(hl_windowHandle window);
 */
 HL_API void hl_clear(hl_windowHandle window, hl_color color);
 
+/**!
+ * @brief read back what has been drawn so far, this draws pending batches and waits for the renderer to finish
+ * @param handle to the window surface
+ * @param area to read, in window coordinates
+ * @param [OUTPUT] RGBA8 pixels with a top-left origin, must hold rect.w * rect.h * 4 bytes
+*/
+HL_API void hl_readPixels(hl_windowHandle window, hl_rect rect, uint8_t* pixels);
+
+/**!
+ * @brief start an async read back of what has been drawn so far, call it before hl_finishFrame and fetch the result later with hl_fetchPixels
+ * @param handle to the window surface
+ * @param area to read, in window coordinates
+*/
+HL_API void hl_requestPixels(hl_windowHandle window, hl_rect rect);
+
+/**!
+ * @brief copy out the pixels requested by the last hl_requestPixels call
+ * @param handle to the window surface
+ * @param [OUTPUT] RGBA8 pixels with a top-left origin, must hold rect.w * rect.h * 4 bytes
+ * @param if true block until the read back is done, otherwise return false if it isn't done yet
+ * @return true if the pixels were copied
+*/
+HL_API bool hl_fetchPixels(hl_windowHandle window, uint8_t* pixels, bool wait);
+
 /**!
  * @brief create font resource from a source font file
+ * the file is mapped read-only (read into memory where mapping isn't available) and shared by every font loaded from the same path
  * @param handle to the surface object
  * @param the file name
  * @param the max height supported by the font
- * @return a handle to the created font resource objects
+ * @return a handle to the created font resource objects, NULL if the file can't be loaded
 */
 HL_API hl_fontHandle hl_loadFont(hl_windowHandle window, const char* name, uint32_t maxHeight);
 
+/**!
+ * @brief create font resource from TTF data in memory, the data isn't copied and has to stay valid until the font is released
+ * fonts made from the same data (or the same file with hl_loadFont) share one parsed face, whatever their size or window
+ * @param handle to the surface object
+ * @param the TTF data
+ * @param the size of the data in bytes
+ * @param the max height supported by the font
+ * @return a handle to the created font resource objects, NULL if the data isn't a usable font
+*/
+HL_API hl_fontHandle hl_loadFontFromMemory(hl_windowHandle window, const uint8_t* data, size_t size, uint32_t maxHeight);
+
 /**!
  * @brief create font resource from a source font file
  * @param handle to the surface object
@@ -547,6 +838,47 @@ HL_API hl_fontHandle hl_loadFont(hl_windowHandle window, const char* name, uint3
 */
 HL_API void hl_releaseFont(hl_windowHandle window, hl_fontHandle font);
 
+/*! an inclusive range of unicode codepoints */
+typedef struct hl_codepointRange {
+	uint32_t first;
+	uint32_t last;
+} hl_codepointRange;
+
+/* seconds hl_startFrame spends copying prewarmed glyphs to font atlases by default, see hl_setPrewarmBudget */
+#ifndef HL_PREWARM_BUDGET
+	#define HL_PREWARM_BUDGET 0.001
+#endif
+
+/**!
+ * @brief rasterize glyphs on a worker thread so text using them doesn't have to rasterize mid-frame
+ * the glyphs are copied to the font's atlas by the following hl_startFrame calls of the window, a budgeted amount per frame
+ * codepoints the font doesn't have are skipped, and prewarming stops once the font's glyph table is full
+ * @param handle to the surface object
+ * @param handle to the font resource
+ * @param codepoint ranges to rasterize
+ * @param number of ranges
+ * @param text sizes to rasterize every codepoint at, the same sizes hl_drawText is called with
+ * @param number of sizes
+ * @return false if the window is a draw list or the worker couldn't be started
+*/
+HL_API bool hl_prewarmFont(hl_windowHandle window, hl_fontHandle font, const hl_codepointRange* ranges, size_t rangeCount, const uint32_t* sizes, size_t sizeCount);
+
+/**!
+ * @brief get how much of the glyphs requested with hl_prewarmFont are in the font's atlas
+ * @param handle to the surface object
+ * @param handle to the font resource, NULL for every font prewarmed on the window
+ * @return the finished fraction, 1.0 when nothing is left to prewarm
+*/
+HL_API float hl_getPrewarmProgress(hl_windowHandle window, hl_fontHandle font);
+
+/**!
+ * @brief set how long each hl_startFrame may spend copying prewarmed glyphs to font atlases (HL_PREWARM_BUDGET by default)
+ * at least one glyph is copied per frame while any are ready
+ * @param handle to the surface object
+ * @param budget in seconds
+*/
+HL_API void hl_setPrewarmBudget(hl_windowHandle window, double seconds);
+
 /**!
  * @brief create texture from raw image data
  * @param handle to the surface object
@@ -569,6 +901,69 @@ HL_API hl_textureHandle hl_loadTextureFromImage(hl_windowHandle window, const ch
 */
 HL_API void hl_releaseTexture(hl_windowHandle window, hl_textureHandle texture);
 
+/**!
+ * @brief create a draw list that is merged into the window every hl_finishFrame
+ * @param handle to the window surface the list is drawn to
+ * @return handle to the draw list, textures and fonts of the window can be used with it
+ * @note lists are emptied by hl_startFrame and drawn on top of the window's own draws in the order they were created,
+ *		recording must be done by the time the window calls hl_finishFrame
+*/
+HL_API hl_drawList hl_createDrawList(hl_windowHandle window);
+
+/**!
+ * @brief free a draw list, lists that are not released are freed with their window
+ * @param handle to the window surface the list was created for
+ * @param handle to the draw list
+*/
+HL_API void hl_releaseDrawList(hl_windowHandle window, hl_drawList list);
+
+/**!
+ * @brief create a tilemap, its tiles are split into chunks that keep their vertices in buffers of the window's renderer
+ * @param handle to the window surface the tilemap is drawn to
+ * @param number of tile columns
+ * @param number of tile rows
+ * @param tile width in map units
+ * @param tile height in map units
+ * @param texture the tile sources are taken from, NULL for plain colored tiles
+ * @return handle to the tilemap, every tile starts out empty
+*/
+HL_API hl_tilemapHandle hl_createTilemap(hl_windowHandle window, uint32_t columns, uint32_t rows, float tileWidth, float tileHeight, hl_textureHandle atlas);
+
+/**!
+ * @brief free a tilemap and its buffers
+ * @param handle to the window surface the tilemap was created for
+ * @param handle to the tilemap
+*/
+HL_API void hl_releaseTilemap(hl_windowHandle window, hl_tilemapHandle tilemap);
+
+/**!
+ * @brief set a tile, only the chunk holding it is rebuilt by the next hl_drawTilemap
+ * @param handle to the tilemap
+ * @param tile column
+ * @param tile row
+ * @param part of the atlas to draw, in the same units as hl_setTextureSource
+ * @param tile color, a transparent tile is not drawn
+*/
+HL_API void hl_setTile(hl_tilemapHandle tilemap, uint32_t column, uint32_t row, hl_rect source, hl_color color);
+
+/**!
+ * @brief empty a tile
+ * @param handle to the tilemap
+ * @param tile column
+ * @param tile row
+*/
+HL_API void hl_clearTile(hl_tilemapHandle tilemap, uint32_t column, uint32_t row);
+
+/**!
+ * @brief draw the chunks of a tilemap that overlap the window's view, chunks outside of it cost nothing
+ * @param handle to the window surface or a draw list of it (lists get the visible tiles as regular draws)
+ * @param handle to the tilemap
+ * @param map position shown at the window's top left corner
+ * @param map position shown at the window's top left corner
+ * @param window pixels per map unit
+*/
+HL_API void hl_drawTilemap(hl_windowHandle window, hl_tilemapHandle tilemap, float cameraX, float cameraY, float zoom);
+
 /**!
  * @brief set texture to use for rendering
  * @param handle renderer object
@@ -590,6 +985,27 @@ HL_API void hl_setTexture(hl_windowHandle window, hl_textureHandle texture);
 */
 HL_API void hl_setFont(hl_windowHandle window, hl_fontHandle font);
 
+/* how deep hl_pushClip can nest */
+#ifndef HL_MAX_CLIP_DEPTH
+	#define HL_MAX_CLIP_DEPTH 32
+#endif
+
+/**!
+ * @brief clip the following draws to a rect, intersected with the clip rect already pushed
+ * the clip is recorded with the draws, so clipped regions batch with the rest of the frame instead of flushing it
+ * @param handle to the surface object
+ * @param rect in window pixels
+ * @note pushes past HL_MAX_CLIP_DEPTH are ignored, debug builds assert
+*/
+HL_API void hl_pushClip(hl_windowHandle window, hl_rect rect);
+
+/**!
+ * @brief restore the clip rect from before the last hl_pushClip, the clip stack is emptied by hl_startFrame
+ * @param handle to the surface object
+ * @note pops of an empty stack are ignored, debug builds assert
+*/
+HL_API void hl_popClip(hl_windowHandle window);
+
 /**!
  * @brief set font to use for text rendering based on the length of the string
  * @param handle renderer object
@@ -626,6 +1042,115 @@ HL_API void hl_drawRect(hl_windowHandle window, hl_rect rect);
 */
 HL_API void hl_drawLine(hl_windowHandle window, hl_vec2D vec1, hl_vec2D vec2);
 
+/**!
+ * @brief draw a connected line through a list of points in one batch
+ * when the points are sorted by x and outnumber the pixel columns they cover,
+ * each column is reduced to its first, lowest, highest and last point, which draws the same pixels
+ * @param handle to the surface object
+ * @param array of points
+ * @param number of points
+ * @param line thickness in pixels
+*/
+HL_API void hl_drawPolyline(hl_windowHandle window, const hl_vec2D* points, size_t count, float thickness);
+
+/**!
+ * @brief turn the column decimation of hl_drawPolyline on or off, it's on by default
+ * @param handle to the surface object
+ * @param true to decimate dense polylines
+*/
+HL_API void hl_setPolylineDecimation(hl_windowHandle window, bool enabled);
+
+/**!
+ * @brief give every draw a depth so opaque draws (alpha 255, no texture or a texture loaded without transparent texels)
+ * are drawn front to back with depth testing and blending off, translucent draws follow in their order
+ * covered pixels of stacked opaque panels, backgrounds and tiles are then shaded once, the output doesn't change
+ * the depth buffer is reset by hl_clear, so the frame has to start with it
+ * @param handle to the surface object
+ * @param true to sort
+ * @return false if the window can't sort (software renderer, draw lists and render thread windows)
+*/
+HL_API bool hl_setDepthSorting(hl_windowHandle window, bool enabled);
+
+/**!
+ * @brief start counting the fragments the window's frames shade, this waits for the GPU after every batch so it's for measuring only
+ * @param handle to the surface object
+ * @return false if the window can't count them (only the modern renderer without a render thread can)
+*/
+HL_API bool hl_beginOverdrawReport(hl_windowHandle window);
+
+/**!
+ * @brief stop counting and get the overdraw of the frames finished since hl_beginOverdrawReport
+ * @param handle to the surface object
+ * @param filled with the report
+ * @return false if no report was running or the fragments couldn't be counted
+*/
+HL_API bool hl_endOverdrawReport(hl_windowHandle window, hl_overdrawStats* stats);
+
+/*
+ * Capture
+ * record the calls an app makes on a window to a file and replay them later, to benchmark or debug its frames without the app
+ * setting the HL_CAPTURE environment variable to a path captures the first window the process creates until it's closed or the process exits
+*/
+
+/**!
+ * @brief start recording the calls made on the window and its draw lists, start it between frames
+ * only fonts, textures and tilemaps loaded after this are recorded, the pixels and font files they're made from are stored in the capture
+ * @param handle to the window object
+ * @param path of the capture file, it's overwritten
+ * @return false if a capture is already running or the file couldn't be created
+*/
+HL_API bool hl_startCapture(hl_windowHandle window, const char* path);
+
+/**!
+ * @brief stop recording and close the capture file, closing the captured window also stops it
+*/
+HL_API void hl_stopCapture(void);
+
+/**!
+ * @brief load a capture file for replaying, the file is written in the byte order of the machine that made it
+ * @param path of the capture file
+ * @return handle to the capture or NULL if it can't be read
+*/
+HL_API hl_captureHandle hl_loadCapture(const char* path);
+
+/**!
+ * @brief fetch the size the captured window had when the capture started
+ * @param handle to the capture
+ * @param [OUTPUT] width of the window
+ * @param [OUTPUT] height of the window
+*/
+HL_API void hl_getCaptureSize(hl_captureHandle capture, int32_t* width, int32_t* height);
+
+/**!
+ * @brief fetch the number of frames the captured window finished
+ * @param handle to the capture
+ * @return the number of frames
+*/
+HL_API size_t hl_getCaptureFrameCount(hl_captureHandle capture);
+
+/**!
+ * @brief replay the captured calls up to and including the next hl_finishFrame of the captured window
+ * fonts, textures, tilemaps and draw lists are created on the window as the capture made them, calls on things that weren't captured are skipped
+ * @param handle to the window to replay on
+ * @param handle to the capture
+ * @return false once the capture has no frames left
+*/
+HL_API bool hl_replayCaptureFrame(hl_windowHandle window, hl_captureHandle capture);
+
+/**!
+ * @brief release what the replay created so far and start again from the first frame
+ * @param handle to the window the capture was replayed on
+ * @param handle to the capture
+*/
+HL_API void hl_rewindCapture(hl_windowHandle window, hl_captureHandle capture);
+
+/**!
+ * @brief release what the replay created and free the capture
+ * @param handle to the window the capture was replayed on
+ * @param handle to the capture
+*/
+HL_API void hl_releaseCapture(hl_windowHandle window, hl_captureHandle capture);
+
 #ifdef __cplusplus
 }
 #endif
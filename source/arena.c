@@ -0,0 +1,220 @@
+#include "internal.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * per-thread stack allocator
+ * freeing the newest allocation pops it along with any freed ones below it, so the malloc/free pairs of temporaries
+ * keep reusing the same memory, an allocation freed out of order is reclaimed once everything above it is freed
+ * when nothing is live the blocks are merged into one, so after a few frames the arena stops touching the heap
+*/
+
+/* temporaries bigger than this (decoded images, mostly) go to the heap instead of growing every thread's arena for good */
+#define HL_TEMP_HEAP_SIZE (1024 * 1024)
+
+#define HL_ARENA_ALIGN 16
+#define HL_ARENA_NONE ((size_t)-1)
+
+typedef struct hl_arenaBlock {
+	struct hl_arenaBlock* prev;
+	size_t size; /* usable bytes after the block header */
+	size_t used;
+	size_t top; /* offset of the newest allocation, HL_ARENA_NONE if the block is empty */
+} hl_arenaBlock;
+
+typedef struct hl_arenaHeader {
+	size_t size; /* requested bytes */
+	size_t prev; /* offset of the allocation before it in the same block */
+	hl_arenaBlock* block; /* NULL for allocations that went to the heap */
+	size_t freed;
+} hl_arenaHeader;
+
+typedef struct hl_arena {
+	hl_arenaBlock* block; /* newest block, allocations come from it */
+	size_t capacity; /* usable bytes of every block */
+	size_t live; /* allocations that weren't freed yet */
+} hl_arena;
+
+static HL_THREAD_LOCAL hl_arena hl_threadArena = { NULL, 0, 0 };
+static volatile size_t hl_tempArenaDisabled = 0;
+
+static size_t hl_alignSize(size_t size) {
+	return (size + (HL_ARENA_ALIGN - 1)) & ~(size_t)(HL_ARENA_ALIGN - 1);
+}
+
+static hl_arenaHeader* hl_arenaHeaderAt(hl_arenaBlock* block, size_t offset) {
+	return (hl_arenaHeader*)((uint8_t*)(block + 1) + offset);
+}
+
+static hl_arenaBlock* hl_arenaAddBlock(hl_arena* arena, size_t size) {
+	hl_arenaBlock* block = (hl_arenaBlock*)malloc(sizeof(hl_arenaBlock) + size);
+	block->prev = arena->block;
+	block->size = size;
+	block->used = 0;
+	block->top = HL_ARENA_NONE;
+
+	arena->block = block;
+	arena->capacity += size;
+	return block;
+}
+
+static void hl_arenaReset(hl_arena* arena) {
+	hl_arenaBlock* block = arena->block;
+	arena->live = 0;
+	if (block == NULL)
+		return;
+
+	/* the arena outgrew its first block, replace them all with one that holds everything the last frame needed */
+	if (block->prev) {
+		size_t capacity = arena->capacity;
+		while (block) {
+			hl_arenaBlock* prev = block->prev;
+			free(block);
+			block = prev;
+		}
+
+		arena->block = NULL;
+		arena->capacity = 0;
+		hl_arenaAddBlock(arena, capacity);
+		return;
+	}
+
+	block->used = 0;
+	block->top = HL_ARENA_NONE;
+}
+
+static void* hl_arenaAlloc(hl_arena* arena, size_t size) {
+	size_t need = sizeof(hl_arenaHeader) + hl_alignSize(size);
+	hl_arenaBlock* block = arena->block;
+
+	if (block == NULL || block->size - block->used < need) {
+		size_t blockSize = arena->capacity ? arena->capacity : HL_FRAME_ARENA_SIZE;
+		while (blockSize < need)
+			blockSize *= 2;
+		block = hl_arenaAddBlock(arena, blockSize);
+	}
+
+	hl_arenaHeader* header = hl_arenaHeaderAt(block, block->used);
+	header->size = size;
+	header->prev = block->top;
+	header->block = block;
+	header->freed = 0;
+
+	block->top = block->used;
+	block->used += need;
+	arena->live += 1;
+	return header + 1;
+}
+
+static bool hl_arenaOwns(const hl_arena* arena, const hl_arenaBlock* block) {
+	const hl_arenaBlock* b;
+	for (b = arena->block; b; b = b->prev)
+		if (b == block)
+			return true;
+	return false;
+}
+
+void* hl_frameAlloc(size_t size) {
+	return hl_arenaAlloc(&hl_threadArena, size);
+}
+
+void hl_resetFrameArena(void) {
+	hl_arenaReset(&hl_threadArena);
+}
+
+void hl_freeThreadArena(void) {
+	hl_arena* arena = &hl_threadArena;
+	while (arena->block) {
+		hl_arenaBlock* prev = arena->block->prev;
+		free(arena->block);
+		arena->block = prev;
+	}
+
+	arena->capacity = 0;
+	arena->live = 0;
+}
+
+void hl_setTempArena(bool enabled) {
+	hl_atomicStore(&hl_tempArenaDisabled, enabled ? 0 : 1);
+}
+
+void* hl_tempAlloc(size_t size) {
+	if (size <= HL_TEMP_HEAP_SIZE && hl_atomicLoad(&hl_tempArenaDisabled) == 0)
+		return hl_arenaAlloc(&hl_threadArena, size);
+
+	hl_arenaHeader* header = (hl_arenaHeader*)malloc(sizeof(hl_arenaHeader) + size);
+	if (header == NULL)
+		return NULL;
+
+	header->size = size;
+	header->block = NULL;
+	return header + 1;
+}
+
+void hl_tempFree(void* ptr) {
+	if (ptr == NULL)
+		return;
+
+	hl_arenaHeader* header = (hl_arenaHeader*)ptr - 1;
+	if (header->block == NULL) {
+		free(header);
+		return;
+	}
+
+	/* temporaries never cross threads, the arena is only reachable from the thread that allocated them */
+	hl_arena* arena = &hl_threadArena;
+	hl_arenaBlock* block = header->block;
+	assert(hl_arenaOwns(arena, block));
+
+	header->freed = 1;
+	arena->live -= 1;
+	if (arena->live == 0) {
+		hl_arenaReset(arena);
+		return;
+	}
+
+	while (block->top != HL_ARENA_NONE) {
+		hl_arenaHeader* top = hl_arenaHeaderAt(block, block->top);
+		if (top->freed == 0)
+			break;
+
+		block->used = block->top;
+		block->top = top->prev;
+	}
+}
+
+void* hl_tempRealloc(void* ptr, size_t size) {
+	if (ptr == NULL)
+		return hl_tempAlloc(size);
+
+	hl_arenaHeader* header = (hl_arenaHeader*)ptr - 1;
+	hl_arenaBlock* block = header->block;
+
+	if (block == NULL) {
+		header = (hl_arenaHeader*)realloc(header, sizeof(hl_arenaHeader) + size);
+		if (header == NULL)
+			return NULL;
+
+		header->size = size;
+		return header + 1;
+	}
+
+	/* the newest allocation of its block grows in place */
+	size_t offset = (size_t)((uint8_t*)header - (uint8_t*)(block + 1));
+	size_t need = sizeof(hl_arenaHeader) + hl_alignSize(size);
+	if (block->top == offset && block->size - offset >= need && size <= HL_TEMP_HEAP_SIZE) {
+		block->used = offset + need;
+		header->size = size;
+		return ptr;
+	}
+
+	void* moved = hl_tempAlloc(size);
+	if (moved == NULL)
+		return NULL;
+
+	memcpy(moved, ptr, (header->size < size) ? header->size : size);
+	hl_tempFree(ptr);
+	return moved;
+}
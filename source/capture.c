@@ -0,0 +1,1049 @@
+#include "internal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * a capture is a header followed by records, every record is an op, the size of its payload and the window it was made on,
+ * handles are stored as the values they had in the captured process and mapped to the replay's handles as they're created
+ * records are padded to 8 bytes so pixel and float payloads can be used in place when the file is replayed
+ * the data is written in the native byte order, captures are replayed on the same kind of machine
+*/
+
+#define HL_CAPTURE_MAGIC 0x50434C48 /* "HLCP" */
+#define HL_CAPTURE_VERSION 1
+
+typedef struct hl_captureHeader {
+	uint32_t magic;
+	uint32_t version;
+	int32_t width, height;
+	uint64_t window;
+} hl_captureHeader;
+
+typedef struct hl_captureRecord {
+	uint32_t op;
+	uint32_t size; /* payload bytes, without the padding */
+	uint64_t window; /* 0 for tiles, they only belong to their tilemap */
+} hl_captureRecord;
+
+/* payloads, every one is a multiple of 8 bytes */
+
+typedef struct hl_captureTextArgs {
+	int32_t x, y, size;
+	uint32_t len; /* the text follows, NUL terminated */
+} hl_captureTextArgs;
+
+typedef struct hl_captureSourceArgs {
+	uint64_t texture;
+	hl_rect rect;
+} hl_captureSourceArgs;
+
+typedef struct hl_capturePolylineArgs {
+	uint64_t count; /* the points follow */
+	float thickness;
+	uint32_t pad;
+} hl_capturePolylineArgs;
+
+typedef struct hl_captureDataArgs {
+	uint64_t data;
+	uint64_t size; /* the bytes follow */
+} hl_captureDataArgs;
+
+typedef struct hl_captureFontArgs {
+	uint64_t font;
+	uint64_t data;
+	uint32_t maxHeight;
+	uint32_t pad;
+} hl_captureFontArgs;
+
+typedef struct hl_capturePrewarmArgs {
+	uint64_t font;
+	uint64_t rangeCount; /* the ranges follow, then the sizes */
+	uint64_t sizeCount;
+} hl_capturePrewarmArgs;
+
+typedef struct hl_captureTextureArgs {
+	uint64_t texture;
+	uint64_t width, height;
+	uint32_t dataType, dataFormat, textureFormat, minFilter, magFilter;
+	uint32_t hasData; /* the pixels follow */
+} hl_captureTextureArgs;
+
+typedef struct hl_captureTilemapArgs {
+	uint64_t tilemap;
+	uint64_t atlas;
+	uint32_t columns, rows;
+	float tileWidth, tileHeight;
+} hl_captureTilemapArgs;
+
+typedef struct hl_captureTileArgs {
+	uint64_t tilemap;
+	uint32_t column, row;
+	hl_rect source;
+	hl_color color;
+	uint32_t pad;
+} hl_captureTileArgs;
+
+typedef struct hl_captureDrawTilemapArgs {
+	uint64_t tilemap;
+	float cameraX, cameraY, zoom;
+	uint32_t pad;
+} hl_captureDrawTilemapArgs;
+
+/* what a captured handle is, ids of different kinds may have the same value (texture names and pointers) */
+typedef enum hl_captureKind {
+	HL_CAPTURE_WINDOW = 0,
+	HL_CAPTURE_TEXTURE,
+	HL_CAPTURE_FONT,
+	HL_CAPTURE_TILEMAP,
+	HL_CAPTURE_BYTES,
+	HL_CAPTURE_WINDOW_FONT /* the font set on a replayed window or draw list, keyed by the window's captured id */
+} hl_captureKind;
+
+typedef struct hl_captureEntry {
+	uint32_t kind;
+	uint64_t id;
+	void* handle; /* the replay's handle, unused while capturing */
+	size_t size; /* bytes of HL_CAPTURE_BYTES entries */
+} hl_captureEntry;
+
+typedef struct hl_captureTable {
+	hl_captureEntry* entries;
+	size_t count, cap;
+} hl_captureTable;
+
+/* a file or buffer fonts were loaded from, so it's only stored once */
+typedef struct hl_captureSource {
+	char* path; /* NULL for buffers */
+	const void* ptr;
+	size_t size;
+	uint64_t data;
+} hl_captureSource;
+
+struct hl_captureState {
+	FILE* file;
+	hl_windowHandle window;
+	hl_captureTable handles; /* the window, its draw lists and the resources made while capturing */
+
+	hl_captureSource* sources;
+	size_t sourceCount, sourceCap;
+	uint64_t nextData;
+};
+
+typedef struct hl_capture {
+	uint8_t* data;
+	size_t size;
+	size_t offset; /* of the next record */
+
+	int32_t width, height;
+	uint64_t window;
+	size_t frameCount;
+
+	hl_captureTable handles; /* captured ids to the replay's handles, text drawn with a font that wasn't captured is skipped */
+
+	uint8_t* pixels; /* read backs land here */
+	size_t pixelCap;
+} hl_capture;
+
+hl_captureState* hl_activeCapture = NULL;
+
+/*
+ * guards hl_activeCapture, draw lists may be recorded on several threads and the hooks only use the state while holding it,
+ * so hl_stopCapture can free it, created by the first hl_startCapture and kept for the rest of the process
+*/
+static hl_mutex* hl_captureLock = NULL;
+
+static hl_captureEntry* hl_findCaptureEntry(hl_captureTable* table, uint32_t kind, uint64_t id) {
+	size_t i;
+	for (i = 0; i < table->count; i++)
+		if (table->entries[i].id == id && table->entries[i].kind == kind)
+			return &table->entries[i];
+	return NULL;
+}
+
+static void hl_addCaptureEntry(hl_captureTable* table, uint32_t kind, uint64_t id, void* handle, size_t size) {
+	hl_captureEntry* entry = hl_findCaptureEntry(table, kind, id);
+	if (entry == NULL) {
+		if (table->count >= table->cap) {
+			table->cap = table->cap ? table->cap * 2 : 16;
+			table->entries = (hl_captureEntry*)realloc(table->entries, table->cap * sizeof(hl_captureEntry));
+		}
+		entry = &table->entries[table->count++];
+	}
+
+	entry->kind = kind;
+	entry->id = id;
+	entry->handle = handle;
+	entry->size = size;
+}
+
+static void hl_removeCaptureEntry(hl_captureTable* table, uint32_t kind, uint64_t id) {
+	hl_captureEntry* entry = hl_findCaptureEntry(table, kind, id);
+	if (entry)
+		*entry = table->entries[--table->count];
+}
+
+static uint64_t hl_captureId(const void* handle) {
+	return (uint64_t)(uintptr_t)handle;
+}
+
+/*
+ * Capturing
+*/
+
+static size_t hl_capturePadding(size_t size) {
+	return (8 - (size & 7)) & 7;
+}
+
+/* lock the capture, returns NULL (without holding the lock) if it was stopped */
+static hl_captureState* hl_lockCapture(void) {
+	if (hl_captureLock == NULL)
+		return NULL;
+
+	hl_lockMutex(hl_captureLock);
+	if (hl_activeCapture == NULL) {
+		hl_unlockMutex(hl_captureLock);
+		return NULL;
+	}
+
+	return hl_activeCapture;
+}
+
+static void hl_unlockCapture(void) {
+	hl_unlockMutex(hl_captureLock);
+}
+
+/* the caller holds the lock */
+static void hl_writeCaptureRecord(hl_captureState* state, uint32_t op, uint64_t window, const void* args, size_t argsSize, const void* data, size_t dataSize) {
+	static const uint8_t zeros[8] = { 0 };
+
+	hl_captureRecord record;
+	record.op = op;
+	record.size = (uint32_t)(argsSize + dataSize);
+	record.window = window;
+
+	fwrite(&record, sizeof(record), 1, state->file);
+	if (argsSize)
+		fwrite(args, 1, argsSize, state->file);
+	if (dataSize)
+		fwrite(data, 1, dataSize, state->file);
+	fwrite(zeros, 1, hl_capturePadding(argsSize + dataSize), state->file);
+}
+
+/* record a call made on a captured window, calls on other windows are ignored */
+static void hl_captureCall(hl_windowHandle window, uint32_t op, const void* args, size_t argsSize, const void* data, size_t dataSize) {
+	hl_captureState* state = hl_lockCapture();
+	if (state == NULL)
+		return;
+
+	if (hl_findCaptureEntry(&state->handles, HL_CAPTURE_WINDOW, hl_captureId(window)))
+		hl_writeCaptureRecord(state, op, hl_captureId(window), args, argsSize, data, dataSize);
+
+	hl_unlockCapture();
+}
+
+void hl_recordOp(hl_windowHandle window, uint32_t op) {
+	hl_captureCall(window, op, NULL, 0, NULL, 0);
+}
+
+void hl_recordRect(hl_windowHandle window, uint32_t op, hl_rect rect) {
+	hl_captureCall(window, op, &rect, sizeof(rect), NULL, 0);
+}
+
+void hl_recordColor(hl_windowHandle window, uint32_t op, hl_color color) {
+	uint32_t args[2] = { 0, 0 };
+	memcpy(args, &color, sizeof(color));
+	hl_captureCall(window, op, args, sizeof(args), NULL, 0);
+}
+
+void hl_recordValue(hl_windowHandle window, uint32_t op, double value) {
+	hl_captureCall(window, op, &value, sizeof(value), NULL, 0);
+}
+
+void hl_recordHandle(hl_windowHandle window, uint32_t op, const void* handle) {
+	uint64_t id = hl_captureId(handle);
+	hl_captureState* state = hl_lockCapture();
+	if (state == NULL)
+		return;
+
+	if (hl_findCaptureEntry(&state->handles, HL_CAPTURE_WINDOW, hl_captureId(window)) == NULL) {
+		hl_unlockCapture();
+		return;
+	}
+
+	switch (op) {
+		case HL_CAPTURE_CREATE_DRAW_LIST: hl_addCaptureEntry(&state->handles, HL_CAPTURE_WINDOW, id, NULL, 0); break;
+		case HL_CAPTURE_RELEASE_DRAW_LIST: hl_removeCaptureEntry(&state->handles, HL_CAPTURE_WINDOW, id); break;
+		case HL_CAPTURE_RELEASE_FONT: hl_removeCaptureEntry(&state->handles, HL_CAPTURE_FONT, id); break;
+		case HL_CAPTURE_RELEASE_TEXTURE: hl_removeCaptureEntry(&state->handles, HL_CAPTURE_TEXTURE, id); break;
+		case HL_CAPTURE_RELEASE_TILEMAP: hl_removeCaptureEntry(&state->handles, HL_CAPTURE_TILEMAP, id); break;
+		default: break;
+	}
+
+	hl_writeCaptureRecord(state, op, hl_captureId(window), &id, sizeof(id), NULL, 0);
+	hl_unlockCapture();
+}
+
+void hl_recordTextureSource(hl_windowHandle window, hl_textureHandle texture, hl_rect rect) {
+	hl_captureSourceArgs args;
+	args.texture = hl_captureId(texture);
+	args.rect = rect;
+	hl_captureCall(window, HL_CAPTURE_SET_TEXTURE_SOURCE, &args, sizeof(args), NULL, 0);
+}
+
+void hl_recordLine(hl_windowHandle window, hl_vec2D vec1, hl_vec2D vec2) {
+	hl_vec2D args[2] = { vec1, vec2 };
+	hl_captureCall(window, HL_CAPTURE_DRAW_LINE, args, sizeof(args), NULL, 0);
+}
+
+void hl_recordPolyline(hl_windowHandle window, const hl_vec2D* points, size_t count, float thickness) {
+	hl_capturePolylineArgs args;
+	memset(&args, 0, sizeof(args));
+	args.count = count;
+	args.thickness = thickness;
+	hl_captureCall(window, HL_CAPTURE_DRAW_POLYLINE, &args, sizeof(args), points, count * sizeof(hl_vec2D));
+}
+
+void hl_recordText(hl_windowHandle window, uint32_t op, const char* text, size_t len, int32_t x, int32_t y, int32_t size) {
+	hl_captureTextArgs args;
+	args.x = x;
+	args.y = y;
+	args.size = size;
+	args.len = (uint32_t)len;
+
+	hl_captureState* state = hl_lockCapture();
+	if (state == NULL)
+		return;
+
+	if (hl_findCaptureEntry(&state->handles, HL_CAPTURE_WINDOW, hl_captureId(window))) {
+		/* the terminator goes in the padding, a record always has at least one byte of it after text */
+		hl_captureRecord record;
+		record.op = op;
+		record.size = (uint32_t)(sizeof(args) + len + 1);
+		record.window = hl_captureId(window);
+
+		static const uint8_t zeros[9] = { 0 };
+		fwrite(&record, sizeof(record), 1, state->file);
+		fwrite(&args, sizeof(args), 1, state->file);
+		fwrite(text, 1, len, state->file);
+		fwrite(zeros, 1, 1 + hl_capturePadding(sizeof(args) + len + 1), state->file);
+	}
+	hl_unlockCapture();
+}
+
+/* the caller holds the lock, returns the id of the stored bytes */
+static uint64_t hl_captureSourceData(hl_captureState* state, const char* path, const uint8_t* data, size_t size) {
+	size_t i;
+	for (i = 0; i < state->sourceCount; i++) {
+		const hl_captureSource* source = &state->sources[i];
+		if (path ? (source->path && strcmp(source->path, path) == 0) : (source->path == NULL && source->ptr == data && source->size == size))
+			return source->data;
+	}
+
+	uint8_t* bytes = (uint8_t*)data;
+	if (path) {
+		FILE* file = fopen(path, "rb");
+		if (file == NULL)
+			return 0;
+
+		fseek(file, 0, SEEK_END);
+		long length = ftell(file);
+		fseek(file, 0, SEEK_SET);
+
+		size = length > 0 ? (size_t)length : 0;
+		bytes = (uint8_t*)malloc(size ? size : 1);
+		if (fread(bytes, 1, size, file) != size)
+			size = 0;
+		fclose(file);
+	}
+
+	hl_captureDataArgs args;
+	args.data = ++state->nextData;
+	args.size = size;
+	hl_writeCaptureRecord(state, HL_CAPTURE_DATA, 0, &args, sizeof(args), bytes, size);
+
+	if (path) {
+		free(bytes);
+		bytes = NULL;
+	}
+
+	if (state->sourceCount >= state->sourceCap) {
+		state->sourceCap = state->sourceCap ? state->sourceCap * 2 : 4;
+		state->sources = (hl_captureSource*)realloc(state->sources, state->sourceCap * sizeof(hl_captureSource));
+	}
+
+	hl_captureSource* source = &state->sources[state->sourceCount++];
+	source->path = NULL;
+	if (path) {
+		source->path = (char*)malloc(strlen(path) + 1);
+		strcpy(source->path, path);
+	}
+	source->ptr = data;
+	source->size = size;
+	source->data = args.data;
+	return args.data;
+}
+
+void hl_recordFont(hl_windowHandle window, hl_fontHandle font, const char* path, const uint8_t* data, size_t size, uint32_t maxHeight) {
+	hl_captureState* state = hl_lockCapture();
+	if (state == NULL)
+		return;
+
+	if (hl_findCaptureEntry(&state->handles, HL_CAPTURE_WINDOW, hl_captureId(window))) {
+		hl_captureFontArgs args;
+		memset(&args, 0, sizeof(args));
+		args.font = hl_captureId(font);
+		args.data = hl_captureSourceData(state, path, data, size);
+		args.maxHeight = maxHeight;
+
+		if (args.data) {
+			hl_addCaptureEntry(&state->handles, HL_CAPTURE_FONT, args.font, NULL, 0);
+			hl_writeCaptureRecord(state, HL_CAPTURE_LOAD_FONT, hl_captureId(window), &args, sizeof(args), NULL, 0);
+		}
+	}
+
+	hl_unlockCapture();
+}
+
+void hl_recordPrewarm(hl_windowHandle window, hl_fontHandle font, const hl_codepointRange* ranges, size_t rangeCount, const uint32_t* sizes, size_t sizeCount) {
+	hl_captureState* state = hl_lockCapture();
+	if (state == NULL)
+		return;
+
+	if (hl_findCaptureEntry(&state->handles, HL_CAPTURE_WINDOW, hl_captureId(window))) {
+		static const uint8_t zeros[8] = { 0 };
+		hl_capturePrewarmArgs args;
+		args.font = hl_captureId(font);
+		args.rangeCount = rangeCount;
+		args.sizeCount = sizeCount;
+
+		size_t size = sizeof(args) + rangeCount * sizeof(hl_codepointRange) + sizeCount * sizeof(uint32_t);
+		hl_captureRecord record;
+		record.op = HL_CAPTURE_PREWARM_FONT;
+		record.size = (uint32_t)size;
+		record.window = hl_captureId(window);
+
+		fwrite(&record, sizeof(record), 1, state->file);
+		fwrite(&args, sizeof(args), 1, state->file);
+		fwrite(ranges, sizeof(hl_codepointRange), rangeCount, state->file);
+		fwrite(sizes, sizeof(uint32_t), sizeCount, state->file);
+		fwrite(zeros, 1, hl_capturePadding(size), state->file);
+	}
+
+	hl_unlockCapture();
+}
+
+static size_t hl_blobSize(const hl_textureBlob* blob) {
+	size_t channels = 4;
+	switch (blob->dataFormat) {
+		case HL_FORMAT_RGB: case HL_FORMAT_BGR: channels = 3; break;
+		case HL_FORMAT_RED: case HL_FORMAT_GRAYSCALE: channels = 1; break;
+		case HL_FORMAT_GRAYSCALEALPHA: channels = 2; break;
+		default: break;
+	}
+
+	return blob->width * blob->height * channels * (blob->dataType == HL_TEXTURE_DATA_FLOAT ? sizeof(float) : 1);
+}
+
+void hl_recordTexture(hl_windowHandle window, hl_textureHandle texture, const hl_textureBlob* blob) {
+	hl_captureState* state = hl_lockCapture();
+	if (state == NULL)
+		return;
+
+	if (hl_findCaptureEntry(&state->handles, HL_CAPTURE_WINDOW, hl_captureId(window))) {
+		hl_captureTextureArgs args;
+		args.texture = hl_captureId(texture);
+		args.width = blob->width;
+		args.height = blob->height;
+		args.dataType = blob->dataType;
+		args.dataFormat = blob->dataFormat;
+		args.textureFormat = blob->textureFormat;
+		args.minFilter = blob->minFilter;
+		args.magFilter = blob->magFilter;
+		args.hasData = blob->data != NULL;
+
+		hl_addCaptureEntry(&state->handles, HL_CAPTURE_TEXTURE, args.texture, NULL, 0);
+		hl_writeCaptureRecord(state, HL_CAPTURE_LOAD_TEXTURE, hl_captureId(window), &args, sizeof(args), blob->data, blob->data ? hl_blobSize(blob) : 0);
+	}
+
+	hl_unlockCapture();
+}
+
+void hl_recordTilemap(hl_windowHandle window, hl_tilemapHandle tilemap, uint32_t columns, uint32_t rows, float tileWidth, float tileHeight, hl_textureHandle atlas) {
+	hl_captureState* state = hl_lockCapture();
+	if (state == NULL)
+		return;
+
+	if (hl_findCaptureEntry(&state->handles, HL_CAPTURE_WINDOW, hl_captureId(window))) {
+		hl_captureTilemapArgs args;
+		args.tilemap = hl_captureId(tilemap);
+		args.atlas = hl_captureId(atlas);
+		args.columns = columns;
+		args.rows = rows;
+		args.tileWidth = tileWidth;
+		args.tileHeight = tileHeight;
+
+		hl_addCaptureEntry(&state->handles, HL_CAPTURE_TILEMAP, args.tilemap, NULL, 0);
+		hl_writeCaptureRecord(state, HL_CAPTURE_CREATE_TILEMAP, hl_captureId(window), &args, sizeof(args), NULL, 0);
+	}
+
+	hl_unlockCapture();
+}
+
+void hl_recordTile(hl_tilemapHandle tilemap, uint32_t op, uint32_t column, uint32_t row, hl_rect source, hl_color color) {
+	hl_captureState* state = hl_lockCapture();
+	if (state == NULL)
+		return;
+
+	if (hl_findCaptureEntry(&state->handles, HL_CAPTURE_TILEMAP, hl_captureId(tilemap))) {
+		hl_captureTileArgs args;
+		memset(&args, 0, sizeof(args));
+		args.tilemap = hl_captureId(tilemap);
+		args.column = column;
+		args.row = row;
+		args.source = source;
+		args.color = color;
+		hl_writeCaptureRecord(state, op, 0, &args, sizeof(args), NULL, 0);
+	}
+
+	hl_unlockCapture();
+}
+
+void hl_recordDrawTilemap(hl_windowHandle window, hl_tilemapHandle tilemap, float cameraX, float cameraY, float zoom) {
+	hl_captureDrawTilemapArgs args;
+	memset(&args, 0, sizeof(args));
+	args.tilemap = hl_captureId(tilemap);
+	args.cameraX = cameraX;
+	args.cameraY = cameraY;
+	args.zoom = zoom;
+	hl_captureCall(window, HL_CAPTURE_DRAW_TILEMAP, &args, sizeof(args), NULL, 0);
+}
+
+void hl_captureWindowClosed(hl_windowHandle window) {
+	hl_captureState* state = hl_lockCapture();
+	if (state == NULL)
+		return;
+
+	bool captured = (state->window == window);
+	hl_unlockCapture();
+
+	if (captured)
+		hl_stopCapture();
+}
+
+static void hl_stopCaptureAtExit(void) {
+	hl_stopCapture();
+}
+
+void hl_captureNewWindow(hl_windowHandle window) {
+	static bool checked = false;
+	if (checked)
+		return;
+	checked = true;
+
+	const char* path = getenv("HL_CAPTURE");
+	if (path && path[0] && hl_startCapture(window, path))
+		atexit(hl_stopCaptureAtExit); /* apps often exit without closing their window */
+}
+
+bool hl_startCapture(hl_windowHandle window, const char* path) {
+	if (hl_activeCapture || hl_getWindowRenderer(window) == NULL)
+		return false;
+
+	/* the lock exists before any hook can see a capture */
+	if (hl_captureLock == NULL)
+		hl_captureLock = hl_createMutex();
+
+	FILE* file = fopen(path, "wb");
+	if (file == NULL)
+		return false;
+
+	hl_captureHeader header;
+	memset(&header, 0, sizeof(header));
+	header.magic = HL_CAPTURE_MAGIC;
+	header.version = HL_CAPTURE_VERSION;
+	header.window = hl_captureId(window);
+	hl_getWindowSize(window, &header.width, &header.height);
+	fwrite(&header, sizeof(header), 1, file);
+
+	hl_captureState* state = (hl_captureState*)malloc(sizeof(hl_captureState));
+	memset(state, 0, sizeof(hl_captureState));
+	state->file = file;
+	state->window = window;
+	hl_addCaptureEntry(&state->handles, HL_CAPTURE_WINDOW, header.window, NULL, 0);
+
+	hl_lockMutex(hl_captureLock);
+	hl_activeCapture = state;
+	hl_unlockMutex(hl_captureLock);
+	return true;
+}
+
+void hl_stopCapture(void) {
+	/* once it's unpublished no hook is using the state, they only touch it while holding the lock */
+	hl_captureState* state = hl_lockCapture();
+	if (state == NULL)
+		return;
+
+	hl_activeCapture = NULL;
+	hl_unlockCapture();
+
+	fclose(state->file);
+
+	size_t i;
+	for (i = 0; i < state->sourceCount; i++)
+		free(state->sources[i].path);
+	free(state->sources);
+	free(state->handles.entries);
+	free(state);
+}
+
+/*
+ * Replaying
+*/
+
+static bool hl_readCaptureRecord(const hl_capture* capture, size_t offset, hl_captureRecord* record) {
+	/* the padding of a truncated last record can go past the end */
+	if (offset > capture->size || capture->size - offset < sizeof(hl_captureRecord))
+		return false;
+
+	memcpy(record, capture->data + offset, sizeof(hl_captureRecord));
+	return capture->size - offset - sizeof(hl_captureRecord) >= record->size;
+}
+
+hl_captureHandle hl_loadCapture(const char* path) {
+	FILE* file = fopen(path, "rb");
+	if (file == NULL)
+		return NULL;
+
+	fseek(file, 0, SEEK_END);
+	long length = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	hl_captureHeader header;
+	if (length < (long)sizeof(header) || fread(&header, sizeof(header), 1, file) != 1 ||
+		header.magic != HL_CAPTURE_MAGIC || header.version != HL_CAPTURE_VERSION) {
+		fclose(file);
+		return NULL;
+	}
+
+	hl_capture* capture = (hl_capture*)malloc(sizeof(hl_capture));
+	memset(capture, 0, sizeof(hl_capture));
+	capture->width = header.width;
+	capture->height = header.height;
+	capture->window = header.window;
+
+	/* the records are used in place, their payloads stay alive as long as the capture (fonts keep pointing into them) */
+	capture->size = (size_t)length - sizeof(header);
+	capture->data = (uint8_t*)malloc(capture->size ? capture->size : 1);
+	if (fread(capture->data, 1, capture->size, file) != capture->size)
+		capture->size = 0;
+	fclose(file);
+
+	hl_captureRecord record;
+	size_t offset = 0;
+	while (hl_readCaptureRecord(capture, offset, &record)) {
+		if (record.op == HL_CAPTURE_FINISH_FRAME && record.window == capture->window)
+			capture->frameCount += 1;
+		offset += sizeof(record) + record.size + hl_capturePadding(record.size);
+	}
+
+	return (hl_captureHandle)capture;
+}
+
+void hl_getCaptureSize(hl_captureHandle handle, int32_t* width, int32_t* height) {
+	const hl_capture* capture = (const hl_capture*)handle;
+	*width = capture->width;
+	*height = capture->height;
+}
+
+size_t hl_getCaptureFrameCount(hl_captureHandle handle) {
+	return ((const hl_capture*)handle)->frameCount;
+}
+
+static void* hl_replayHandle(hl_capture* capture, uint32_t kind, uint64_t id) {
+	if (id == 0)
+		return NULL;
+
+	hl_captureEntry* entry = hl_findCaptureEntry(&capture->handles, kind, id);
+	return entry ? entry->handle : NULL;
+}
+
+static uint8_t* hl_replayPixels(hl_capture* capture, hl_rect rect) {
+	size_t size = (size_t)(rect.w > 0 ? rect.w : 0) * (size_t)(rect.h > 0 ? rect.h : 0) * 4;
+	size_t full = (size_t)capture->width * (size_t)capture->height * 4;
+	if (size < full)
+		size = full; /* fetches get the size of their request */
+
+	if (size > capture->pixelCap) {
+		capture->pixelCap = size;
+		capture->pixels = (uint8_t*)realloc(capture->pixels, size);
+	}
+
+	return capture->pixels;
+}
+
+/* the least payload a record of `op` has, records with less were cut short or aren't from this version */
+static size_t hl_captureArgsSize(uint32_t op) {
+	switch (op) {
+		case HL_CAPTURE_CLEAR:
+		case HL_CAPTURE_SET_COLOR:
+			return sizeof(hl_color);
+		case HL_CAPTURE_READ_PIXELS:
+		case HL_CAPTURE_REQUEST_PIXELS:
+		case HL_CAPTURE_PUSH_CLIP:
+		case HL_CAPTURE_DRAW_RECT:
+			return sizeof(hl_rect);
+		case HL_CAPTURE_FETCH_PIXELS:
+		case HL_CAPTURE_SET_FRAME_LATENCY:
+		case HL_CAPTURE_SET_DEPTH_SORTING:
+		case HL_CAPTURE_SET_POLYLINE_DECIMATION:
+		case HL_CAPTURE_SET_PREWARM_BUDGET:
+			return sizeof(double);
+		case HL_CAPTURE_SET_TEXTURE:
+		case HL_CAPTURE_SET_FONT:
+		case HL_CAPTURE_RELEASE_FONT:
+		case HL_CAPTURE_RELEASE_TEXTURE:
+		case HL_CAPTURE_CREATE_DRAW_LIST:
+		case HL_CAPTURE_RELEASE_DRAW_LIST:
+		case HL_CAPTURE_RELEASE_TILEMAP:
+			return sizeof(uint64_t);
+		case HL_CAPTURE_SET_TEXTURE_SOURCE: return sizeof(hl_captureSourceArgs);
+		case HL_CAPTURE_DRAW_LINE: return sizeof(hl_vec2D) * 2;
+		case HL_CAPTURE_DRAW_POLYLINE: return sizeof(hl_capturePolylineArgs);
+		case HL_CAPTURE_DRAW_TEXT:
+		case HL_CAPTURE_DRAW_TEXT_LEN:
+			return sizeof(hl_captureTextArgs) + 1; /* the terminator */
+		case HL_CAPTURE_DRAW_TILEMAP: return sizeof(hl_captureDrawTilemapArgs);
+		case HL_CAPTURE_SET_TILE: return sizeof(hl_captureTileArgs);
+		case HL_CAPTURE_DATA: return sizeof(hl_captureDataArgs);
+		case HL_CAPTURE_LOAD_FONT: return sizeof(hl_captureFontArgs);
+		case HL_CAPTURE_PREWARM_FONT: return sizeof(hl_capturePrewarmArgs);
+		case HL_CAPTURE_LOAD_TEXTURE: return sizeof(hl_captureTextureArgs);
+		case HL_CAPTURE_CREATE_TILEMAP: return sizeof(hl_captureTilemapArgs);
+		default: return 0;
+	}
+}
+
+/* ops that make or free something owned by the window, draw lists only use what their window owns */
+static bool hl_captureIsWindowOp(uint32_t op) {
+	switch (op) {
+		case HL_CAPTURE_LOAD_FONT:
+		case HL_CAPTURE_RELEASE_FONT:
+		case HL_CAPTURE_PREWARM_FONT:
+		case HL_CAPTURE_LOAD_TEXTURE:
+		case HL_CAPTURE_RELEASE_TEXTURE:
+		case HL_CAPTURE_CREATE_DRAW_LIST:
+		case HL_CAPTURE_RELEASE_DRAW_LIST:
+		case HL_CAPTURE_CREATE_TILEMAP:
+		case HL_CAPTURE_RELEASE_TILEMAP:
+			return true;
+		default: return false;
+	}
+}
+
+/* returns true for the record that ends a frame of the captured window */
+static bool hl_replayRecord(hl_windowHandle root, hl_capture* capture, const hl_captureRecord* record, const uint8_t* payload) {
+	hl_windowHandle window = NULL;
+	if (record->window) {
+		window = (record->window == capture->window) ? root : hl_replayHandle(capture, HL_CAPTURE_WINDOW, record->window);
+		if (window == NULL)
+			return false;
+	} else if (record->op != HL_CAPTURE_SET_TILE && record->op != HL_CAPTURE_DATA) {
+		return false; /* only tiles and data don't belong to a window */
+	}
+
+	if (window != root && hl_captureIsWindowOp(record->op))
+		return false;
+
+	/* a damaged record is skipped, the lengths in its payload are checked against its size below */
+	if (record->size < hl_captureArgsSize(record->op))
+		return false;
+
+	uint64_t id = 0;
+	hl_rect rect = HL_RECT(0, 0, 0, 0);
+	hl_color color;
+	double value = 0.0;
+	memset(&color, 0, sizeof(color));
+
+	if (record->size >= sizeof(id))
+		memcpy(&id, payload, sizeof(id));
+	if (record->size >= sizeof(rect))
+		memcpy(&rect, payload, sizeof(rect));
+	if (record->size >= sizeof(color))
+		memcpy(&color, payload, sizeof(color));
+	if (record->size >= sizeof(value))
+		memcpy(&value, payload, sizeof(value));
+
+	switch (record->op) {
+		case HL_CAPTURE_START_FRAME: hl_startFrame(window); break;
+		case HL_CAPTURE_FINISH_FRAME:
+			hl_finishFrame(window);
+			return window == root;
+		case HL_CAPTURE_CLEAR: hl_clear(window, color); break;
+		case HL_CAPTURE_READ_PIXELS: hl_readPixels(window, rect, hl_replayPixels(capture, rect)); break;
+		case HL_CAPTURE_REQUEST_PIXELS: hl_requestPixels(window, rect); break;
+		case HL_CAPTURE_FETCH_PIXELS: hl_fetchPixels(window, hl_replayPixels(capture, rect), value != 0.0); break;
+		case HL_CAPTURE_SET_FRAME_LATENCY: hl_setFrameLatency(window, (uint32_t)value); break;
+		case HL_CAPTURE_SET_DEPTH_SORTING: hl_setDepthSorting(window, value != 0.0); break;
+		case HL_CAPTURE_SET_POLYLINE_DECIMATION: hl_setPolylineDecimation(window, value != 0.0); break;
+		case HL_CAPTURE_SET_PREWARM_BUDGET: hl_setPrewarmBudget(window, value); break;
+		case HL_CAPTURE_SET_TEXTURE: hl_setTexture(window, hl_replayHandle(capture, HL_CAPTURE_TEXTURE, id)); break;
+		case HL_CAPTURE_SET_TEXTURE_SOURCE: {
+			hl_captureSourceArgs args;
+			memcpy(&args, payload, sizeof(args));
+			hl_setTextureSource(window, hl_replayHandle(capture, HL_CAPTURE_TEXTURE, args.texture), args.rect);
+			break;
+		}
+		case HL_CAPTURE_SET_FONT: {
+			/* fonts loaded before the capture started aren't in it */
+			hl_fontHandle font = hl_replayHandle(capture, HL_CAPTURE_FONT, id);
+			if (font) {
+				hl_setFont(window, font);
+				hl_addCaptureEntry(&capture->handles, HL_CAPTURE_WINDOW_FONT, record->window, font, 0);
+			} else {
+				hl_removeCaptureEntry(&capture->handles, HL_CAPTURE_WINDOW_FONT, record->window);
+			}
+			break;
+		}
+		case HL_CAPTURE_SET_COLOR: hl_setColor(window, color); break;
+		case HL_CAPTURE_PUSH_CLIP: hl_pushClip(window, rect); break;
+		case HL_CAPTURE_POP_CLIP: hl_popClip(window); break;
+		case HL_CAPTURE_DRAW_RECT: hl_drawRect(window, rect); break;
+		case HL_CAPTURE_DRAW_LINE: {
+			hl_vec2D line[2];
+			memcpy(line, payload, sizeof(line));
+			hl_drawLine(window, line[0], line[1]);
+			break;
+		}
+		case HL_CAPTURE_DRAW_POLYLINE: {
+			hl_capturePolylineArgs args;
+			memcpy(&args, payload, sizeof(args));
+			if (args.count > (record->size - sizeof(args)) / sizeof(hl_vec2D))
+				break;
+
+			hl_drawPolyline(window, (const hl_vec2D*)(payload + sizeof(args)), (size_t)args.count, args.thickness);
+			break;
+		}
+		case HL_CAPTURE_DRAW_TEXT:
+		case HL_CAPTURE_DRAW_TEXT_LEN: {
+			if (hl_replayHandle(capture, HL_CAPTURE_WINDOW_FONT, record->window) == NULL)
+				break;
+
+			hl_captureTextArgs args;
+			memcpy(&args, payload, sizeof(args));
+			const char* text = (const char*)(payload + sizeof(args));
+			if (args.len > record->size - sizeof(args) - 1 || text[args.len] != '\0')
+				break;
+
+			if (record->op == HL_CAPTURE_DRAW_TEXT)
+				hl_drawText(window, text, args.x, args.y, args.size);
+			else
+				hl_drawTextLen(window, text, args.len, args.x, args.y, args.size);
+			break;
+		}
+		case HL_CAPTURE_DRAW_TILEMAP: {
+			hl_captureDrawTilemapArgs args;
+			memcpy(&args, payload, sizeof(args));
+			hl_tilemapHandle tilemap = hl_replayHandle(capture, HL_CAPTURE_TILEMAP, args.tilemap);
+			if (tilemap)
+				hl_drawTilemap(window, tilemap, args.cameraX, args.cameraY, args.zoom);
+			break;
+		}
+		case HL_CAPTURE_SET_TILE: {
+			hl_captureTileArgs args;
+			memcpy(&args, payload, sizeof(args));
+			hl_tilemapHandle tilemap = hl_replayHandle(capture, HL_CAPTURE_TILEMAP, args.tilemap);
+			if (tilemap == NULL)
+				break;
+
+			uint32_t columns, rows;
+			hl_getTilemapSize(tilemap, &columns, &rows);
+			if (args.column < columns && args.row < rows)
+				hl_setTile(tilemap, args.column, args.row, args.source, args.color);
+			break;
+		}
+		case HL_CAPTURE_DATA: {
+			hl_captureDataArgs args;
+			memcpy(&args, payload, sizeof(args));
+			if (args.size > record->size - sizeof(args))
+				break;
+
+			hl_addCaptureEntry(&capture->handles, HL_CAPTURE_BYTES, args.data, (void*)(payload + sizeof(args)), (size_t)args.size);
+			break;
+		}
+		case HL_CAPTURE_LOAD_FONT: {
+			hl_captureFontArgs args;
+			memcpy(&args, payload, sizeof(args));
+			hl_captureEntry* data = hl_findCaptureEntry(&capture->handles, HL_CAPTURE_BYTES, args.data);
+			if (data == NULL)
+				break;
+
+			hl_fontHandle font = hl_loadFontFromMemory(window, (const uint8_t*)data->handle, data->size, args.maxHeight);
+			if (font)
+				hl_addCaptureEntry(&capture->handles, HL_CAPTURE_FONT, args.font, font, 0);
+			break;
+		}
+		case HL_CAPTURE_RELEASE_FONT: {
+			hl_fontHandle font = hl_replayHandle(capture, HL_CAPTURE_FONT, id);
+			if (font == NULL)
+				break;
+
+			hl_releaseFont(window, font);
+			hl_removeCaptureEntry(&capture->handles, HL_CAPTURE_FONT, id);
+
+			size_t i = 0;
+			while (i < capture->handles.count) {
+				const hl_captureEntry* entry = &capture->handles.entries[i];
+				if (entry->kind == HL_CAPTURE_WINDOW_FONT && entry->handle == font)
+					hl_removeCaptureEntry(&capture->handles, HL_CAPTURE_WINDOW_FONT, entry->id);
+				else
+					i++;
+			}
+			break;
+		}
+		case HL_CAPTURE_PREWARM_FONT: {
+			hl_capturePrewarmArgs args;
+			memcpy(&args, payload, sizeof(args));
+			size_t rest = record->size - sizeof(args);
+			if (args.rangeCount > rest / sizeof(hl_codepointRange) ||
+				args.sizeCount > (rest - (size_t)args.rangeCount * sizeof(hl_codepointRange)) / sizeof(uint32_t))
+				break;
+
+			hl_fontHandle font = hl_replayHandle(capture, HL_CAPTURE_FONT, args.font);
+			const hl_codepointRange* ranges = (const hl_codepointRange*)(payload + sizeof(args));
+			const uint32_t* sizes = (const uint32_t*)(ranges + args.rangeCount);
+			if (font)
+				hl_prewarmFont(window, font, ranges, (size_t)args.rangeCount, sizes, (size_t)args.sizeCount);
+			break;
+		}
+		case HL_CAPTURE_LOAD_TEXTURE: {
+			hl_captureTextureArgs args;
+			memcpy(&args, payload, sizeof(args));
+
+			hl_textureBlob blob;
+			memset(&blob, 0, sizeof(blob));
+			blob.data = args.hasData ? (void*)(payload + sizeof(args)) : NULL;
+			blob.width = (size_t)args.width;
+			blob.height = (size_t)args.height;
+			blob.dataType = (hl_textureDataType)args.dataType;
+			blob.dataFormat = (hl_textureFormat)args.dataFormat;
+			blob.textureFormat = (hl_textureFormat)args.textureFormat;
+			blob.minFilter = (hl_textureFilter)args.minFilter;
+			blob.magFilter = (hl_textureFilter)args.magFilter;
+
+			/* the size of a single texel, so width * height can't overflow before it's compared */
+			size_t rest = record->size - sizeof(args);
+			hl_textureBlob texel = blob;
+			texel.width = 1;
+			texel.height = 1;
+			if (args.hasData && args.height && args.width > rest / hl_blobSize(&texel) / args.height)
+				break;
+
+			hl_textureHandle texture = hl_loadTextureFromBlob(window, &blob);
+			if (texture)
+				hl_addCaptureEntry(&capture->handles, HL_CAPTURE_TEXTURE, args.texture, texture, 0);
+			break;
+		}
+		case HL_CAPTURE_RELEASE_TEXTURE: {
+			hl_textureHandle texture = hl_replayHandle(capture, HL_CAPTURE_TEXTURE, id);
+			if (texture == NULL)
+				break;
+
+			hl_releaseTexture(window, texture);
+			hl_removeCaptureEntry(&capture->handles, HL_CAPTURE_TEXTURE, id);
+			break;
+		}
+		case HL_CAPTURE_CREATE_DRAW_LIST:
+			hl_addCaptureEntry(&capture->handles, HL_CAPTURE_WINDOW, id, hl_createDrawList(window), 0);
+			break;
+		case HL_CAPTURE_RELEASE_DRAW_LIST: {
+			hl_drawList list = hl_replayHandle(capture, HL_CAPTURE_WINDOW, id);
+			if (list == NULL)
+				break;
+
+			hl_releaseDrawList(window, list);
+			hl_removeCaptureEntry(&capture->handles, HL_CAPTURE_WINDOW, id);
+			hl_removeCaptureEntry(&capture->handles, HL_CAPTURE_WINDOW_FONT, id);
+			break;
+		}
+		case HL_CAPTURE_CREATE_TILEMAP: {
+			hl_captureTilemapArgs args;
+			memcpy(&args, payload, sizeof(args));
+			hl_tilemapHandle tilemap = hl_createTilemap(window, args.columns, args.rows, args.tileWidth, args.tileHeight,
+														hl_replayHandle(capture, HL_CAPTURE_TEXTURE, args.atlas));
+			if (tilemap)
+				hl_addCaptureEntry(&capture->handles, HL_CAPTURE_TILEMAP, args.tilemap, tilemap, 0);
+			break;
+		}
+		case HL_CAPTURE_RELEASE_TILEMAP: {
+			hl_tilemapHandle tilemap = hl_replayHandle(capture, HL_CAPTURE_TILEMAP, id);
+			if (tilemap == NULL)
+				break;
+
+			hl_releaseTilemap(window, tilemap);
+			hl_removeCaptureEntry(&capture->handles, HL_CAPTURE_TILEMAP, id);
+			break;
+		}
+		default: break;
+	}
+
+	return false;
+}
+
+bool hl_replayCaptureFrame(hl_windowHandle window, hl_captureHandle handle) {
+	hl_capture* capture = (hl_capture*)handle;
+
+	hl_captureRecord record;
+	while (hl_readCaptureRecord(capture, capture->offset, &record)) {
+		const uint8_t* payload = capture->data + capture->offset + sizeof(record);
+		capture->offset += sizeof(record) + record.size + hl_capturePadding(record.size);
+
+		if (hl_replayRecord(window, capture, &record, payload))
+			return true;
+	}
+
+	return false;
+}
+
+/* release what the replay created, draw lists first since they may use the textures */
+static void hl_releaseReplayHandles(hl_windowHandle window, hl_capture* capture) {
+	static const uint32_t order[] = { HL_CAPTURE_WINDOW, HL_CAPTURE_TILEMAP, HL_CAPTURE_FONT, HL_CAPTURE_TEXTURE };
+	size_t k, i;
+
+	for (k = 0; k < sizeof(order) / sizeof(order[0]); k++) {
+		for (i = 0; i < capture->handles.count; i++) {
+			const hl_captureEntry* entry = &capture->handles.entries[i];
+			if (entry->kind != order[k])
+				continue;
+
+			switch (entry->kind) {
+				case HL_CAPTURE_WINDOW: hl_releaseDrawList(window, entry->handle); break;
+				case HL_CAPTURE_TILEMAP: hl_releaseTilemap(window, entry->handle); break;
+				case HL_CAPTURE_FONT: hl_releaseFont(window, entry->handle); break;
+				case HL_CAPTURE_TEXTURE: hl_releaseTexture(window, entry->handle); break;
+				default: break;
+			}
+		}
+	}
+
+	capture->handles.count = 0;
+}
+
+void hl_rewindCapture(hl_windowHandle window, hl_captureHandle handle) {
+	hl_capture* capture = (hl_capture*)handle;
+	hl_releaseReplayHandles(window, capture);
+	capture->offset = 0;
+}
+
+void hl_releaseCapture(hl_windowHandle window, hl_captureHandle handle) {
+	hl_capture* capture = (hl_capture*)handle;
+	if (capture == NULL)
+		return;
+
+	hl_releaseReplayHandles(window, capture);
+	free(capture->handles.entries);
+	free(capture->pixels);
+	free(capture->data);
+	free(capture);
+}
@@ -0,0 +1,120 @@
+#include "internal.h"
+
+#include <stdlib.h>
+
+/*
+ * single producer single consumer ring
+ * the producer only writes `tail` and the consumer only writes `head`, so neither side needs a lock
+*/
+typedef struct hl_eventQueue {
+	hl_event* events;
+	size_t mask; /* capacity - 1, the capacity is a power of 2 */
+	volatile size_t head; /* next event to pop */
+	volatile size_t tail; /* next slot to push to */
+	volatile size_t dropped;
+
+	hl_eventCallback callback;
+	void* userData;
+
+	/* producer side, the last motion event is held back so following ones can be merged into it */
+	bool coalesce;
+	bool hasPending;
+	hl_event pending;
+} hl_eventQueue;
+
+static hl_eventQueue hl_events = { NULL, 0, 0, 0, 0, NULL, NULL, true, false };
+
+static size_t hl_roundToPow2(size_t size) {
+	size_t capacity = 2;
+	while (capacity < size)
+		capacity <<= 1;
+	return capacity;
+}
+
+void hl_setEventQueueSize(size_t size) {
+	size_t capacity = hl_roundToPow2(size);
+
+	free(hl_events.events);
+	hl_events.events = (hl_event*)malloc(capacity * sizeof(hl_event));
+	hl_events.mask = capacity - 1;
+	hl_events.head = 0;
+	hl_atomicStore(&hl_events.tail, 0);
+}
+
+static bool hl_publishEvent(const hl_event* event) {
+	if (hl_events.events == NULL)
+		hl_setEventQueueSize(HL_EVENT_QUEUE_SIZE);
+
+	if (hl_events.callback)
+		hl_events.callback(event, hl_events.userData);
+
+	size_t tail = hl_events.tail;
+	if (tail - hl_atomicLoad(&hl_events.head) > hl_events.mask) {
+		hl_atomicStore(&hl_events.dropped, hl_events.dropped + 1);
+		return false;
+	}
+
+	hl_events.events[tail & hl_events.mask] = *event;
+	hl_atomicStore(&hl_events.tail, tail + 1);
+	return true;
+}
+
+void hl_flushEvents(void) {
+	if (hl_events.hasPending == false)
+		return;
+
+	hl_events.hasPending = false;
+	hl_publishEvent(&hl_events.pending);
+}
+
+bool hl_pushEvent(const hl_event* event) {
+	hl_event e = *event;
+	if (e.common.time == 0.0)
+		e.common.time = hl_getTime();
+
+	if (hl_events.coalesce && e.type == HL_EVENT_MOUSE_MOVED) {
+		hl_mouseEvent* pending = &hl_events.pending.mouse;
+
+		if (hl_events.hasPending && pending->window == e.mouse.window) {
+			pending->x = e.mouse.x;
+			pending->y = e.mouse.y;
+			pending->vecX += e.mouse.vecX;
+			pending->vecY += e.mouse.vecY;
+			return true;
+		}
+
+		hl_flushEvents();
+		hl_events.pending = e;
+		hl_events.hasPending = true;
+		return true;
+	}
+
+	/* keep the order, the held back motion happened before this event */
+	hl_flushEvents();
+	return hl_publishEvent(&e);
+}
+
+bool hl_nextEvent(hl_event* event) {
+	size_t head = hl_events.head;
+	if (head == hl_atomicLoad(&hl_events.tail))
+		return false;
+
+	*event = hl_events.events[head & hl_events.mask];
+	hl_atomicStore(&hl_events.head, head + 1);
+	return true;
+}
+
+size_t hl_getDroppedEventCount(void) {
+	return hl_atomicLoad(&hl_events.dropped);
+}
+
+void hl_setEventCallback(hl_eventCallback callback, void* userData) {
+	hl_events.callback = callback;
+	hl_events.userData = userData;
+}
+
+void hl_setMouseCoalescing(bool enabled) {
+	hl_events.coalesce = enabled;
+	if (enabled == false)
+		hl_flushEvents();
+}
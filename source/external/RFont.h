@@ -108,6 +108,12 @@ int main () {
 #define RFONT_FREE free
 #endif
 
+/* memory the rasterizer frees before returning, and glyph bitmaps that are freed right after they're copied to an atlas */
+#ifndef RFONT_TEMP_MALLOC
+#define RFONT_TEMP_MALLOC RFONT_MALLOC
+#define RFONT_TEMP_FREE RFONT_FREE
+#endif
+
 #if !defined(RFONT_MEMCPY) || !defined(RFONT_MEMSET)
 	#include <string.h>
 #endif
@@ -342,6 +348,54 @@ RFONT_API void RFont_font_free(RFont_renderer* renderer, RFont_font* font);
 */
 RFONT_API void RFont_font_free_ptr(RFont_renderer* renderer, RFont_font* font);
 
+/*
+ * faces (RFont_src) are shared, every font made from the same file path or the same data pointer uses one face
+ * so the TTF data is held and its tables are parsed once, no matter how many sizes or renderers use it
+*/
+
+#ifndef RFONT_NO_STDIO
+/**
+ * @brief Get the face of a TTF file, the file is mapped read-only where the platform allows it and read otherwise.
+ * @param font_name The TTF file path.
+ * @return The face with a new reference or NULL if the file couldn't be loaded, release it with `RFont_src_release`.
+*/
+RFONT_API RFont_src* RFont_src_load(const char* font_name);
+#endif
+
+/**
+ * @brief Get the face of raw TTF data, the data isn't copied and has to outlive the face.
+ * @param font_data The raw TTF data.
+ * @param size The size of the data in bytes (0 if unknown).
+ * @param freeData Free the data with RFONT_FREE when the face is released for the last time, or right away if the data isn't a usable font.
+ * @return The face with a new reference or NULL if the data isn't a usable font, release it with `RFont_src_release`.
+*/
+RFONT_API RFont_src* RFont_src_init_data(const u8* font_data, size_t size, b8 freeData);
+
+/**
+ * @brief Drop a reference to a face, the face and its data are freed when the last one is dropped.
+ * @param src The face to release.
+*/
+RFONT_API void RFont_src_release(RFont_src* src);
+
+/**
+ * @brief Init font stucture with a face, the font keeps its own reference to the face.
+ * @param src The face to use.
+ * @param atlasWidth The width of the atlas texture.
+ * @param atlasHeight The height of the atlas texture. (This should == the max text size)
+ * @return The `RFont_font` created from the face or NULL if `src` is NULL.
+*/
+RFONT_API RFont_font* RFont_font_init_src(RFont_renderer* renderer, RFont_src* src, u32 maxHeight, size_t atlasWidth, size_t atlasHeight);
+
+/**
+ * @brief Init a given font stucture with a face, the font keeps its own reference to the face.
+ * @param src The face to use.
+ * @param atlasWidth The width of the atlas texture.
+ * @param atlasHeight The height of the atlas texture. (This should == the max text size)
+ * @pram ptr Pointer to the given font structure
+ * @return returns the same pointer or NULL if `src` is NULL
+*/
+RFONT_API RFont_font* RFont_font_init_src_ptr(RFont_renderer* renderer, RFont_src* src, u32 maxHeight, size_t atlasWidth, size_t atlasHeight, RFont_font* font);
+
 typedef RFont_glyph (*RFont_glyph_fallback_callback)(RFont_renderer* renderer, RFont_font* font, u32 codepoint, size_t size);
 RFont_glyph_fallback_callback RFont_set_glyph_fallback_callback(RFont_glyph_fallback_callback callback);
 
@@ -373,6 +427,27 @@ RFONT_API RFont_glyph RFont_font_add_codepoint(RFont_renderer* renderer, RFont_f
 */
 RFONT_API RFont_glyph RFont_font_add_codepoint_ex(RFont_renderer* renderer, RFont_font* font, u32 codepoint, size_t size, b8 fallback);
 
+/**
+ * @brief Rasterize a codepoint without touching the atlas or the glyph table.
+ * Only the font's (shared, read-only) face is read, so this can run on another thread while the font is in use.
+ * @param font The font to use.
+ * @param codepoint The codepoint to rasterize.
+ * @param size The size of the character.
+ * @param glyph [OUTPUT] The glyph, finished by `RFont_font_commit_glyph`.
+ * @param bitmap [OUTPUT] The coverage bitmap, free it with RFONT_TEMP_FREE on the same thread once it's committed.
+ * @return 0 if the font doesn't have the codepoint or the glyph has no outline, nothing is allocated then.
+*/
+RFONT_API b8 RFont_font_rasterize_codepoint(RFont_font* font, u32 codepoint, size_t size, RFont_glyph* glyph, u8** bitmap);
+
+/**
+ * @brief Copy a glyph made by `RFont_font_rasterize_codepoint` to the font's atlas and add it to the glyph table.
+ * @param font The font the glyph was rasterized from.
+ * @param glyph The rasterized glyph.
+ * @param bitmap The coverage bitmap of the glyph.
+ * @return The `RFont_glyph` added to the atlas, zeroed if the glyph table is full.
+*/
+RFONT_API RFont_glyph RFont_font_commit_glyph(RFont_renderer* renderer, RFont_font* font, const RFont_glyph* glyph, u8* bitmap);
+
 /**
  * @brief Add a string to the font's atlas.
  * @param font The font to use.
@@ -473,14 +548,17 @@ RFONT_API size_t RFont_draw_text_len(RFont_renderer* renderer, RFont_font* font,
 size_t RFont_renderer_size(RFont_renderer* renderer) {
 	size_t size = 0;
 	if (renderer->proc.size)
-		renderer->proc.size();
+		size = renderer->proc.size();
 	return size;
 }
 
 RFont_renderer* RFont_renderer_init(RFont_renderer_proc proc) {
 	RFont_renderer* renderer = (RFont_renderer*)RFONT_MALLOC(sizeof(RFont_renderer));
 	void* ptr = NULL;
-	size_t size = RFont_renderer_size(renderer);
+	size_t size;
+
+	renderer->proc = proc;
+	size = RFont_renderer_size(renderer);
 
 	if (size) ptr = RFONT_MALLOC(size);
 
@@ -582,78 +660,316 @@ typedef struct stbtt_fontinfo rstbtt_fontinfo;
 #define rstbtt_GetGlyphBox stbtt_GetGlyphBox
 #endif /* RFONT_EXTERNAL_STB */
 
+#if !defined(RFONT_NO_STDIO) && !defined(RFONT_NO_MMAP)
+	#if defined(_WIN32)
+		#include <windows.h>
+	#elif defined(__unix__) || defined(__APPLE__)
+		#include <fcntl.h>
+		#include <sys/mman.h>
+		#include <sys/stat.h>
+		#include <unistd.h>
+	#else
+		#define RFONT_NO_MMAP
+	#endif
+#endif
+
 struct RFont_src {
     rstbtt_fontinfo info;
+
+    /* read from the hhea and hmtx tables once, every font made from the face copies them */
+    float fheight, descent, numOfLongHorMetrics, space_adv;
+
+    size_t refCount;
+    u8* data;
+    size_t size;
+    b8 freeData; /* the data was handed over and is freed with the face */
+    b8 mapped; /* the data is a read-only mapping of the file */
+    char* path; /* the file the face was loaded from, NULL for faces made from memory */
+    RFont_src* next;
 };
 
+/* every live face */
+static RFont_src* RFont_faces = NULL;
+
 /*
 END of stb defines required by RFont
 
 you probably care about this part
 */
 
+/* rstbtt trusts the data it's given, at least check it starts like a font and, when the size is known, its table directory fits */
+static b8 RFont_src_valid(const u8* data, size_t size) {
+    if (size != 0 && size < 12)
+        return 0;
+
+    if (!((data[0] == 0 && data[1] == 1 && data[2] == 0 && data[3] == 0) ||
+          (data[0] == 't' && data[1] == 'r' && data[2] == 'u' && data[3] == 'e') ||
+          (data[0] == 'O' && data[1] == 'T' && data[2] == 'T' && data[3] == 'O')))
+        return 0;
+
+    return size == 0 || 12 + 16 * (size_t)RFONT_USHORT(data, 4) <= size;
+}
+
+static RFont_src* RFont_src_create(u8* data, size_t size) {
+    i32 space_codepoint;
+    RFont_src* src;
+    if (RFont_src_valid(data, size) == 0)
+        return NULL;
+
+    src = (RFont_src*)RFONT_MALLOC(sizeof(RFont_src));
+    RFONT_MEMSET(src, 0, sizeof(RFont_src));
+
+    if (rstbtt_InitFont(&src->info, data, 0) == 0) {
+        RFONT_FREE(src);
+        return NULL;
+    }
+
+    src->fheight = RFONT_SHORT(src->info.data, src->info.hhea + 4) - RFONT_SHORT(src->info.data, src->info.hhea + 6);
+    src->descent = RFONT_SHORT(src->info.data, src->info.hhea + 6);
+    src->numOfLongHorMetrics = RFONT_USHORT(src->info.data, src->info.hhea + 34);
+
+    space_codepoint = rstbtt_FindGlyphIndex(&src->info, (int)' ');
+    if (' ' < src->numOfLongHorMetrics)
+        src->space_adv = RFONT_SHORT(src->info.data, src->info.hmtx + 4 * space_codepoint);
+    else
+        src->space_adv = RFONT_SHORT(src->info.data, src->info.hmtx + 4 * (i32)(src->numOfLongHorMetrics - 1));
+
+    src->data = data;
+    src->size = size;
+    src->refCount = 1;
+    src->next = RFont_faces;
+    RFont_faces = src;
+    return src;
+}
+
+RFont_src* RFont_src_init_data(const u8* font_data, size_t size, b8 freeData) {
+    RFont_src* src;
+    if (font_data == NULL) return NULL;
+
+    for (src = RFont_faces; src; src = src->next) {
+        if (src->path == NULL && src->data == font_data) {
+            src->refCount++;
+            return src;
+        }
+    }
+
+    src = RFont_src_create((u8*)font_data, size);
+    if (src == NULL) {
+        /* the data was handed over, there's no face to free it with */
+        if (freeData) RFONT_FREE((u8*)font_data);
+        return NULL;
+    }
+
+    src->freeData = freeData;
+    return src;
+}
+
 #ifndef RFONT_NO_STDIO
-char* RFont_read_file(const char* font_name) {
-    size_t size, out;
-    char* ttf_buffer;
+u8* RFont_read_file(const char* font_name, size_t* size) {
+    long length;
+    size_t out;
+    u8* ttf_buffer;
     FILE* ttf_file = fopen(font_name, "rb");
 
     if (ttf_file == NULL) return NULL;
 
     fseek(ttf_file, 0U, SEEK_END);
-    size = (size_t)ftell(ttf_file);
-    if (size <= 0) return NULL;
+    length = ftell(ttf_file);
+    if (length <= 0) {
+        fclose(ttf_file);
+        return NULL;
+    }
 
-    ttf_buffer = (char*)RFONT_MALLOC(sizeof(char) * (size_t)size);
+    ttf_buffer = (u8*)RFONT_MALLOC(sizeof(u8) * (size_t)length);
     fseek(ttf_file, 0U, SEEK_SET);
 
-    out = fread(ttf_buffer, 1, (size_t)size, ttf_file);
+    out = fread(ttf_buffer, 1, (size_t)length, ttf_file);
+    fclose(ttf_file);
     RFONT_UNUSED(out);
 
+    *size = (size_t)length;
     return ttf_buffer;
 }
 
+#ifndef RFONT_NO_MMAP
+/* only the pages that glyphs are read from become resident, and they're shared with every other process using the file */
+static u8* RFont_map_file(const char* font_name, size_t* size) {
+    void* data;
+#ifdef _WIN32
+    LARGE_INTEGER length;
+    HANDLE mapping;
+    HANDLE file = CreateFileA(font_name, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return NULL;
+
+    if (GetFileSizeEx(file, &length) == 0 || length.QuadPart <= 0) {
+        CloseHandle(file);
+        return NULL;
+    }
+
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (mapping == NULL) return NULL;
+
+    /* the view keeps the mapping alive */
+    data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (data == NULL) return NULL;
+
+    *size = (size_t)length.QuadPart;
+#else
+    struct stat st;
+    int fd = open(font_name, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return NULL;
+    }
+
+    data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return NULL;
+
+    *size = (size_t)st.st_size;
+#endif
+    return (u8*)data;
+}
+
+static void RFont_unmap_file(u8* data, size_t size) {
+#ifdef _WIN32
+    RFONT_UNUSED(size);
+    UnmapViewOfFile(data);
+#else
+    munmap(data, size);
+#endif
+}
+#endif
+
+static b8 RFont_path_equal(const char* a, const char* b) {
+    while (*a && *a == *b) {
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+RFont_src* RFont_src_load(const char* font_name) {
+    RFont_src* src;
+    size_t size = 0, len = 0;
+    b8 mapped = 0;
+    u8* data = NULL;
+
+    /* different spellings of the same path get their own face */
+    for (src = RFont_faces; src; src = src->next) {
+        if (src->path && RFont_path_equal(src->path, font_name)) {
+            src->refCount++;
+            return src;
+        }
+    }
+
+#ifndef RFONT_NO_MMAP
+    data = RFont_map_file(font_name, &size);
+    mapped = (data != NULL);
+#endif
+    if (data == NULL)
+        data = RFont_read_file(font_name, &size);
+    if (data == NULL) return NULL;
+
+    src = RFont_src_create(data, size);
+    if (src == NULL) {
+#ifndef RFONT_NO_MMAP
+        if (mapped) RFont_unmap_file(data, size);
+        else
+#endif
+        RFONT_FREE(data);
+        return NULL;
+    }
+
+    src->mapped = mapped;
+    src->freeData = !mapped;
+
+    while (font_name[len]) len++;
+    src->path = (char*)RFONT_MALLOC(len + 1);
+    RFONT_MEMCPY(src->path, font_name, len + 1);
+    return src;
+}
+
 RFont_font* RFont_font_init(RFont_renderer* renderer, const char* font_name, u32 maxHeight, size_t atlasWidth, size_t atlasHeight) {
-    char* ttf_buffer = RFont_read_file(font_name);
-    RFont_font* font = RFont_font_init_data(renderer, (u8*)ttf_buffer, maxHeight, atlasWidth, atlasHeight);
+    RFont_src* src = RFont_src_load(font_name);
+    RFont_font* font = RFont_font_init_src(renderer, src, maxHeight, atlasWidth, atlasHeight);
+    RFont_src_release(src);
     return font;
 }
 
 RFont_font* RFont_font_init_ptr(RFont_renderer* renderer, const char* font_name, u32 maxHeight, size_t atlasWidth, size_t atlasHeight, RFont_font* ptr) {
-    char* ttf_buffer = RFont_read_file(font_name);
-    RFont_font* font = RFont_font_init_data_ptr(renderer, (u8*)ttf_buffer, maxHeight, atlasWidth, atlasHeight, ptr);
+    RFont_src* src = RFont_src_load(font_name);
+    RFont_font* font = RFont_font_init_src_ptr(renderer, src, maxHeight, atlasWidth, atlasHeight, ptr);
+    RFont_src_release(src);
     return font;
 }
 #endif
 
+void RFont_src_release(RFont_src* src) {
+    RFont_src** link;
+    if (src == NULL) return;
+
+    src->refCount--;
+    if (src->refCount) return;
+
+    for (link = &RFont_faces; *link; link = &(*link)->next) {
+        if (*link == src) {
+            *link = src->next;
+            break;
+        }
+    }
+
+#if !defined(RFONT_NO_STDIO) && !defined(RFONT_NO_MMAP)
+    if (src->mapped) RFont_unmap_file(src->data, src->size);
+#endif
+    if (src->freeData) RFONT_FREE(src->data);
+    if (src->path) RFONT_FREE(src->path);
+    RFONT_FREE(src);
+}
+
+/* the data is handed over, it's freed with the last font using it */
 RFont_font* RFont_font_init_data(RFont_renderer* renderer, u8* font_data, u32 maxHeight, size_t atlasWidth, size_t atlasHeight) {
-    RFont_font* font = (RFont_font*)RFONT_MALLOC(sizeof(RFont_font));
-    return RFont_font_init_data_ptr(renderer, font_data, maxHeight, atlasWidth, atlasHeight, font);
+    RFont_src* src = RFont_src_init_data(font_data, 0, 1);
+    RFont_font* font = RFont_font_init_src(renderer, src, maxHeight, atlasWidth, atlasHeight);
+    RFont_src_release(src);
+    return font;
 }
 
 RFont_font* RFont_font_init_data_ptr(RFont_renderer* renderer, u8* font_data, u32 maxHeight, size_t atlasWidth, size_t atlasHeight, RFont_font* font) {
+    RFont_src* src = RFont_src_init_data(font_data, 0, 1);
+    font = RFont_font_init_src_ptr(renderer, src, maxHeight, atlasWidth, atlasHeight, font);
+    RFont_src_release(src);
+    return font;
+}
+
+RFont_font* RFont_font_init_src(RFont_renderer* renderer, RFont_src* src, u32 maxHeight, size_t atlasWidth, size_t atlasHeight) {
+    RFont_font* font;
+    if (src == NULL) return NULL;
+
+    font = (RFont_font*)RFONT_MALLOC(sizeof(RFont_font));
+    return RFont_font_init_src_ptr(renderer, src, maxHeight, atlasWidth, atlasHeight, font);
+}
+
+RFont_font* RFont_font_init_src_ptr(RFont_renderer* renderer, RFont_src* src, u32 maxHeight, size_t atlasWidth, size_t atlasHeight, RFont_font* font) {
 	u16 index = 0;
 	u16 vert_index = 0;
 
-	i32 space_codepoint = 0;
-	font->src = (RFont_src*)RFONT_MALLOC(sizeof(RFont_src));
+	if (src == NULL) return NULL;
+
+	src->refCount++;
+	font->src = src;
 	font->atlasWidth = atlasWidth;
 	font->atlasHeight = atlasHeight;
 	font->maxHeight = maxHeight;
 
-	rstbtt_InitFont(&font->src->info, font_data, 0);
-
-	font->fheight = RFONT_SHORT(font->src->info.data, font->src->info.hhea + 4) - RFONT_SHORT(font->src->info.data, font->src->info.hhea + 6);
-	font->descent = RFONT_SHORT(font->src->info.data, font->src->info.hhea + 6);
-
-	font->numOfLongHorMetrics = RFONT_USHORT(font->src->info.data, font->src->info.hhea + 34);
-
-
-	space_codepoint = rstbtt_FindGlyphIndex(&font->src->info, (int)' ');
-	if (' ' < font->numOfLongHorMetrics)
-		font->space_adv = RFONT_SHORT(font->src->info.data, font->src->info.hmtx + 4 * space_codepoint);
-	else
-		font->space_adv = RFONT_SHORT(font->src->info.data, font->src->info.hmtx + 4 * (i32)(font->numOfLongHorMetrics - 1));
+	font->fheight = src->fheight;
+	font->descent = src->descent;
+	font->numOfLongHorMetrics = src->numOfLongHorMetrics;
+	font->space_adv = src->space_adv;
 
 	if (renderer->proc.create_atlas)
 		font->atlas = renderer->proc.create_atlas(renderer->ctx, (u32)atlasWidth, (u32)atlasHeight);
@@ -678,11 +994,10 @@ RFont_font* RFont_font_init_data_ptr(RFont_renderer* renderer, u8* font_data, u3
 void RFont_font_free_ptr(RFont_renderer* renderer, RFont_font* font) {
 	if (renderer->proc.free_atlas)
 		renderer->proc.free_atlas(renderer->ctx, font->atlas);
-	RFONT_FREE(font->src);
+	RFont_src_release(font->src);
 }
 
 void RFont_font_free(RFont_renderer* renderer, RFont_font* font) {
-    RFONT_FREE(font->src->info.data);
     RFont_font_free_ptr(renderer, font);
     RFONT_FREE(font);
 }
@@ -764,43 +1079,54 @@ RFont_glyph RFont_font_add_codepoint(RFont_renderer* renderer, RFont_font* font,
 }
 
 RFont_glyph RFont_font_add_codepoint_ex(RFont_renderer* renderer, RFont_font* font, u32 codepoint, size_t size, b8 fallback) {
-	RFont_glyph* glyph;
+	RFont_glyph glyph;
 	RFont_glyph glyphNull;
-
-	u8* bitmap;
-	float scale;
-
-	i32 x0, y0, x1, y1, w = 0, h = 0, advanceX = 0;
+	u8* bitmap = NULL;
 	u32 i;
+
 	for (i = 0; i < font->glyph_len; i++)
 		if (font->glyphs[i].codepoint == codepoint && font->glyphs[i].size == size)
 			return font->glyphs[i];
 
 	RFONT_MEMSET(&glyphNull, 0, sizeof(glyphNull));
-	if (i < sizeof(font->glyphs)) {
-		glyph = &font->glyphs[i];
-	} else {
+	if (font->glyph_len >= RFONT_MAX_GLYPHS)
 		return glyphNull;
-	}
 
-	glyph->src = rstbtt_FindGlyphIndex(&font->src->info, (int)codepoint);
+	if (RFont_font_rasterize_codepoint(font, codepoint, size, &glyph, &bitmap) == 0) {
+		if (glyph.src != 0 || codepoint == 0)
+			return glyphNull;
 
-	if ((glyph->src == 0 && codepoint) && fallback && RFont_glyph_fallback) {
-		RFont_glyph fallbackGlyph = RFont_glyph_fallback(renderer, font, codepoint, size);
-		if (fallbackGlyph.codepoint != 0 && fallbackGlyph.size != 0) {
-			return fallbackGlyph;
+		if (fallback && RFont_glyph_fallback) {
+			RFont_glyph fallbackGlyph = RFont_glyph_fallback(renderer, font, codepoint, size);
+			if (fallbackGlyph.codepoint != 0 && fallbackGlyph.size != 0) {
+				return fallbackGlyph;
+			}
 		}
+
+		return RFont_font_add_codepoint_ex(renderer, font, 0, size, fallback);
 	}
 
-	if (glyph->src == 0 && codepoint) return RFont_font_add_codepoint_ex(renderer, font, 0, size, fallback);
-	font->glyph_len++;
+	glyph = RFont_font_commit_glyph(renderer, font, &glyph, bitmap);
+	RFONT_TEMP_FREE(bitmap);
+	return glyph;
+}
 
-	if (codepoint && rstbtt_GetGlyphBox(&font->src->info, glyph->src, &x0, &y0, &x1, &y1) == 0) {
-		return glyphNull;
-	}
+b8 RFont_font_rasterize_codepoint(RFont_font* font, u32 codepoint, size_t size, RFont_glyph* glyph, u8** bitmap) {
+	float scale;
+	i32 x0, y0, x1, y1, w = 0, h = 0, advanceX = 0;
+
+	RFONT_MEMSET(glyph, 0, sizeof(RFont_glyph));
+	*bitmap = NULL;
+
+	glyph->src = rstbtt_FindGlyphIndex(&font->src->info, (int)codepoint);
+	if (glyph->src == 0 && codepoint)
+		return 0;
+
+	if (codepoint && rstbtt_GetGlyphBox(&font->src->info, glyph->src, &x0, &y0, &x1, &y1) == 0)
+		return 0;
 
 	scale = ((float)size) / font->fheight;
-	bitmap =  rstbtt_GetGlyphBitmapSubpixel(&font->src->info, 0, scale, 0.0f, 0.0f, glyph->src, &w, &h, 0, 0);
+	*bitmap = rstbtt_GetGlyphBitmapSubpixel(&font->src->info, 0, scale, 0.0f, 0.0f, glyph->src, &w, &h, 0, 0);
 	glyph->w = (float)w;
 	glyph->h = (float)h;
 
@@ -813,23 +1139,37 @@ RFont_glyph RFont_font_add_codepoint_ex(RFont_renderer* renderer, RFont_font* fo
 	glyph->size = size;
 	glyph->font = font;
 
+	if (glyph->src < font->numOfLongHorMetrics)
+		advanceX = RFONT_SHORT(font->src->info.data, font->src->info.hmtx + 4 * glyph->src);
+	else
+		advanceX = RFONT_SHORT(font->src->info.data, font->src->info.hmtx + 4 * (i32)(font->numOfLongHorMetrics - 1));
+
+	glyph->advance = (u32)((float)advanceX * scale);
+	return 1;
+}
+
+RFont_glyph RFont_font_commit_glyph(RFont_renderer* renderer, RFont_font* font, const RFont_glyph* src, u8* bitmap) {
+	RFont_glyph* glyph;
+
+	if (font->glyph_len >= RFONT_MAX_GLYPHS) {
+		RFont_glyph glyphNull;
+		RFONT_MEMSET(&glyphNull, 0, sizeof(glyphNull));
+		return glyphNull;
+	}
+
+	glyph = &font->glyphs[font->glyph_len];
+	font->glyph_len++;
+	*glyph = *src;
+
 	if (renderer->proc.bitmap_to_atlas)
 		renderer->proc.bitmap_to_atlas(renderer->ctx, font->atlas, (u32)font->atlasWidth, (u32)font->atlasHeight, font->maxHeight, bitmap, glyph->w, glyph->h, &font->atlasX, &font->atlasY);
 
-	RFONT_FREE(bitmap);
 	glyph->x = (i32)(font->atlasX - glyph->w);
 	glyph->x2 = (i32)(font->atlasX);
 
 	glyph->y = (i32)(font->atlasY);
 	glyph->y2 = (i32)((font->atlasY) + glyph->h);
 
-	if (glyph->src < font->numOfLongHorMetrics)
-		advanceX = RFONT_SHORT(font->src->info.data, font->src->info.hmtx + 4 * glyph->src);
-	else
-		advanceX = RFONT_SHORT(font->src->info.data, font->src->info.hmtx + 4 * (i32)(font->numOfLongHorMetrics - 1));
-
-	glyph->advance = (u32)((float)advanceX * scale);
-
 	return *glyph;
 }
 
@@ -1364,7 +1704,7 @@ RFONT_API int rstbtt__GetGlyphShapeTT(const rstbtt_fontinfo *info, int glyph_ind
       n = 1+RFONT_USHORT(endPtsOfContours, numberOfContours*2-2);
 
       m = n + 2*numberOfContours;  /* a loose bound on how many vertices we might need */
-      vertices = (rstbtt_vertex *) RFONT_MALLOC((size_t)m * sizeof(vertices[0]));
+      vertices = (rstbtt_vertex *) RFONT_TEMP_MALLOC((size_t)m * sizeof(vertices[0]));
       if (vertices == 0)
          return 0;
 
@@ -1532,17 +1872,17 @@ RFONT_API int rstbtt__GetGlyphShapeTT(const rstbtt_fontinfo *info, int glyph_ind
                v->cy = (float)(n * (mtx[1] * (float)x + mtx[3] * (float)y + mtx[5]));
             }
             /* Append vertices. */
-            tmp = (rstbtt_vertex*)RFONT_MALLOC((size_t)(num_vertices + comp_num_verts) * sizeof(rstbtt_vertex));
+            tmp = (rstbtt_vertex*)RFONT_TEMP_MALLOC((size_t)(num_vertices + comp_num_verts) * sizeof(rstbtt_vertex));
             if (!tmp) {
-               if (vertices) RFONT_FREE(vertices);
-               if (comp_verts) RFONT_FREE(comp_verts);
+               if (vertices) RFONT_TEMP_FREE(vertices);
+               if (comp_verts) RFONT_TEMP_FREE(comp_verts);
                return 0;
             }
             if (num_vertices > 0) RFONT_MEMCPY(tmp, vertices, (size_t)num_vertices * sizeof(rstbtt_vertex));
             RFONT_MEMCPY(tmp+num_vertices, comp_verts, (size_t)comp_num_verts * sizeof(rstbtt_vertex));
-            if (vertices) RFONT_FREE(vertices);
+            if (vertices) RFONT_TEMP_FREE(vertices);
             vertices = tmp;
-            RFONT_FREE(comp_verts);
+            RFONT_TEMP_FREE(comp_verts);
             num_vertices += comp_num_verts;
          }
          /* More components ? */
@@ -1934,7 +2274,7 @@ RFONT_API int rstbtt__GetGlyphShapeT2(const rstbtt_fontinfo *info, int glyph_ind
    rstbtt__csctx count_ctx = rstbtt__CSCTX_INIT(1);
    rstbtt__csctx output_ctx = rstbtt__CSCTX_INIT(0);
    if (rstbtt__run_charstring(info, glyph_index, &count_ctx)) {
-      *pvertices = (rstbtt_vertex*)RFONT_MALLOC((size_t)count_ctx.num_vertices * sizeof(rstbtt_vertex));
+      *pvertices = (rstbtt_vertex*)RFONT_TEMP_MALLOC((size_t)count_ctx.num_vertices * sizeof(rstbtt_vertex));
       output_ctx.pvertices = *pvertices;
       if (rstbtt__run_charstring(info, glyph_index, &output_ctx)) {
          assert(output_ctx.num_vertices == count_ctx.num_vertices);
@@ -2255,7 +2595,7 @@ RFONT_API void *rstbtt__hheap_alloc(rstbtt__hheap *hh, size_t size)
    } else {
       if (hh->num_remaining_in_head_chunk == 0) {
          int count = (size < 32 ? 2000 : size < 128 ? 800 : 100);
-         rstbtt__hheap_chunk *c = (rstbtt__hheap_chunk *) RFONT_MALLOC(sizeof(rstbtt__hheap_chunk) + size * (size_t)count);
+         rstbtt__hheap_chunk *c = (rstbtt__hheap_chunk *) RFONT_TEMP_MALLOC(sizeof(rstbtt__hheap_chunk) + size * (size_t)count);
          if (c == NULL)
             return NULL;
          c->next = hh->head;
@@ -2278,7 +2618,7 @@ RFONT_API void rstbtt__hheap_cleanup(rstbtt__hheap *hh)
    rstbtt__hheap_chunk *c = hh->head;
    while (c) {
       rstbtt__hheap_chunk *n = c->next;
-      RFONT_FREE(c);
+      RFONT_TEMP_FREE(c);
       c = n;
    }
 }
@@ -2500,7 +2840,7 @@ RFONT_API void rstbtt__rasterize_sorted_edges(rstbtt__bitmap *result, rstbtt__ed
    rstbtt__NOTUSED(vsubsample);
 
    if (result->w > 64)
-      scanline = (float *) RFONT_MALLOC((size_t)(result->w*2+1) * sizeof(float));
+      scanline = (float *) RFONT_TEMP_MALLOC((size_t)(result->w*2+1) * sizeof(float));
    else
       scanline = scanline_data;
 
@@ -2584,7 +2924,7 @@ RFONT_API void rstbtt__rasterize_sorted_edges(rstbtt__bitmap *result, rstbtt__ed
    rstbtt__hheap_cleanup(&hh);
 
    if (scanline != scanline_data)
-      RFONT_FREE(scanline);
+      RFONT_TEMP_FREE(scanline);
 }
 
 #define rstbtt__COMPARE(a,b)  ((a)->y0 < (b)->y0)
@@ -2699,7 +3039,7 @@ RFONT_API void rstbtt__rasterize(rstbtt__bitmap *result, rstbtt__point *pts, int
    for (i=0; i < windings; ++i)
       n += wcount[i];
 
-   e = (rstbtt__edge *) RFONT_MALLOC(sizeof(*e) * (size_t)(n+1)); /* add an extra one as a sentinel */
+   e = (rstbtt__edge *) RFONT_TEMP_MALLOC(sizeof(*e) * (size_t)(n+1)); /* add an extra one as a sentinel */
    if (e == 0) return;
    n = 0;
 
@@ -2734,7 +3074,7 @@ RFONT_API void rstbtt__rasterize(rstbtt__bitmap *result, rstbtt__point *pts, int
    /* now, traverse the scanlines and find the intersections on each scanline, use xor winding rule */
    rstbtt__rasterize_sorted_edges(result, e, n, vsubsample, off_x, off_y);
 
-   RFONT_FREE(e);
+   RFONT_TEMP_FREE(e);
 }
 
 RFONT_API void rstbtt__add_point(rstbtt__point *points, int n, float x, float y)
@@ -2824,7 +3164,7 @@ RFONT_API rstbtt__point *rstbtt_FlattenCurves(rstbtt_vertex *vertices, int num_v
    *num_contours = n;
    if (n == 0) return 0;
 
-   *contour_lengths = (int *) RFONT_MALLOC((size_t)(sizeof(**contour_lengths) * (size_t)n));
+   *contour_lengths = (int *) RFONT_TEMP_MALLOC((size_t)(sizeof(**contour_lengths) * (size_t)n));
 
    if (*contour_lengths == 0) {
       *num_contours = 0;
@@ -2835,7 +3175,7 @@ RFONT_API rstbtt__point *rstbtt_FlattenCurves(rstbtt_vertex *vertices, int num_v
    for (pass=0; pass < 2; ++pass) {
       float x=0,y=0;
       if (pass == 1) {
-         points = (rstbtt__point *) RFONT_MALLOC((size_t)num_points * sizeof(points[0]));
+         points = (rstbtt__point *) RFONT_TEMP_MALLOC((size_t)num_points * sizeof(points[0]));
          if (points == NULL) goto error;
       }
       num_points = 0;
@@ -2879,8 +3219,8 @@ RFONT_API rstbtt__point *rstbtt_FlattenCurves(rstbtt_vertex *vertices, int num_v
 
    return points;
 error:
-   RFONT_FREE(points);
-   RFONT_FREE(*contour_lengths);
+   RFONT_TEMP_FREE(points);
+   RFONT_TEMP_FREE(*contour_lengths);
    *contour_lengths = 0;
    *num_contours = 0;
    return NULL;
@@ -2894,8 +3234,8 @@ RFONT_API void rstbtt_Rasterize(rstbtt__bitmap *result, float flatness_in_pixels
    rstbtt__point *windings = rstbtt_FlattenCurves(vertices, num_verts, flatness_in_pixels / scale, &winding_lengths, &winding_count);
    if (windings) {
       rstbtt__rasterize(result, windings, winding_lengths, winding_count, scale_x, scale_y, shift_x, shift_y, x_off, y_off, invert);
-      RFONT_FREE(winding_lengths);
-      RFONT_FREE(windings);
+      RFONT_TEMP_FREE(winding_lengths);
+      RFONT_TEMP_FREE(windings);
    }
 }
 
@@ -2927,7 +3267,7 @@ RFONT_API unsigned char *rstbtt_GetGlyphBitmapSubpixel(const rstbtt_fontinfo *in
    if (scale_x == 0) scale_x = scale_y;
    if (scale_y == 0) {
       if (scale_x == 0) {
-         RFONT_FREE(vertices);
+         RFONT_TEMP_FREE(vertices);
          return NULL;
       }
       scale_y = scale_x;
@@ -2946,14 +3286,14 @@ RFONT_API unsigned char *rstbtt_GetGlyphBitmapSubpixel(const rstbtt_fontinfo *in
    if (yoff  ) *yoff   = iy0;
 
    if (gbm.w && gbm.h) {
-      gbm.pixels = (unsigned char *) RFONT_MALLOC((size_t)(gbm.w * gbm.h));
+      gbm.pixels = (unsigned char *) RFONT_TEMP_MALLOC((size_t)(gbm.w * gbm.h));
       if (gbm.pixels) {
          gbm.stride = gbm.w;
 
          rstbtt_Rasterize(&gbm, 0.35f, vertices, num_verts, scale_x, scale_y, shift_x, shift_y, ix0, iy0, 1);
       }
    }
-   RFONT_FREE(vertices);
+   RFONT_TEMP_FREE(vertices);
    return gbm.pixels;
 }
 
@@ -3231,6 +3231,12 @@ i32 RGFW_init_ptr(RGFW_info* info) {
 
     RGFW_initKeycodes();
     i32 out = RGFW_initPlatform();
+	if (out != 0) {
+		/* leave RGFW uninitialized so the next RGFW_init tries again */
+		RGFW_setInfo(NULL);
+		return out;
+	}
+
     RGFW_sendDebugInfo(RGFW_typeInfo, RGFW_infoGlobal, "global context initialized");
 
 	return out;
@@ -7043,7 +7049,7 @@ RGFW_proc RGFW_FUNC(RGFW_getProcAddress_OpenGL)(const char* procname) { return g
 
 void RGFW_FUNC(RGFW_window_makeCurrentContext_OpenGL) (RGFW_window* win) { if (win) RGFW_ASSERT(win->src.ctx.native);
 	if (win == NULL)
-		glXMakeCurrent(NULL, (Drawable)NULL, (GLXContext) NULL);
+		glXMakeCurrent(_RGFW->display, (Drawable)None, (GLXContext) NULL);
 	else
 		glXMakeCurrent(_RGFW->display, (Drawable)win->src.ctx.native->window, (GLXContext) win->src.ctx.native->ctx);
 	return;
@@ -7132,6 +7138,10 @@ i32 RGFW_initPlatform_X11(void) {
 
     XInitThreads(); /*!< init X11 threading */
     _RGFW->display = XOpenDisplay(0);
+	if (_RGFW->display == NULL) {
+		RGFW_sendDebugInfo(RGFW_typeError, RGFW_errX11, "Failed to open the X11 display.");
+		return -1;
+	}
 	_RGFW->context = XUniqueContext();
 
 	XSetWindowAttributes wa;
@@ -10372,7 +10382,7 @@ RGFW_bool RGFW_window_createContextPtr_OpenGL(RGFW_window* win, RGFW_glContext*
 	win->src.hdc = GetDC(win->src.window);
 
 	if (hints->share) {
-		wglShareLists((HGLRC)RGFW_getCurrentContext_OpenGL(), hints->share->ctx);
+		wglShareLists((HGLRC)hints->share->ctx, win->src.ctx.native->ctx); /* the new context must not own any objects yet */
 	}
 
 	wglMakeCurrent(win->src.hdc, win->src.ctx.native->ctx);
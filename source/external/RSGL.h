@@ -29,6 +29,9 @@
     #define RSGL_RFONT - do include functions to help with integrating RFont and RSGL
 	#define RSGL_MAX_BATCHES [number of batches] - set max number of batches to be allocated
     #define RSGL_MAX_VERTS [number of verts] - set max number of verts to be allocated (global, not per batch)
+	#define RSGL_STATIC_BACKEND(name) [backend prefix ## name] - fix a backend at compile time, e.g. RSGL_GL_##name,
+		renderers made from it call its per frame functions directly so they can be inlined, other renderers still use their proc,
+		the backend header has to be included before the implementation
 */
 #include <stdint.h>
 #ifndef RSGL_MAX_BATCHES
@@ -45,6 +48,12 @@
 #define RSGL_FREE free
 #endif
 
+/* scratch memory that's freed before the function that allocated it returns */
+#ifndef RSGL_TEMP_MALLOC
+#define RSGL_TEMP_MALLOC RSGL_MALLOC
+#define RSGL_TEMP_FREE RSGL_FREE
+#endif
+
 #ifndef RSGL_SIN
 #include <math.h>
 #define RSGL_SIN sinf
@@ -295,6 +304,9 @@ typedef struct RSGL_BATCH {
     RSGL_texture tex;
     float lineWidth;
     RSGL_mat4 matrix;
+    RSGL_bool clipped; /* scissor the batch to `clip` (in framebuffer pixels, top-left origin) */
+    RSGL_rect clip;
+    RSGL_bool opaque; /* drawn in the opaque pass when depth sorting, see RSGL_renderer_setDepthSort */
 } RSGL_BATCH; /* batch data type for rendering */
 
 typedef struct RSGL_renderData {
@@ -304,6 +316,7 @@ typedef struct RSGL_renderData {
 	u16* elements;
 	size_t elements_count;
     size_t len; /* number of verts */
+	size_t depth; /* draws since the last clear, the z of depth sorted draws */
 
 	RSGL_mat4 perspective; /* perspective matrix */
 } RSGL_renderData;
@@ -345,13 +358,26 @@ typedef struct RSGL_renderState {
 	RSGL_bool forceBatch;
 	RSGL_bool overflow;
 	RSGL_framebuffer framebuffer;
+	RSGL_bool clipped;
+	RSGL_rect clip;
+	RSGL_bool depthSort;
+	RSGL_bool textureOpaque; /* the texture has no transparent texels, set by RSGL_renderer_setTexture for the default texture */
 } RSGL_renderState;
 
+/* filled by the backend while set with RSGL_renderer_setStats */
+typedef struct RSGL_renderStats {
+	size_t fragments; /* fragments that passed the depth test and were shaded */
+	RSGL_bool counted; /* false if the backend can't count fragments */
+} RSGL_renderStats;
+
 typedef struct RSGL_renderPass {
 	RSGL_programInfo* program;
 	float* matrix;
 	RSGL_renderBuffers* buffers;
 	RSGL_framebuffer framebuffer;
+	float height; /* framebuffer height, to flip batch clip rects for the backend */
+	RSGL_bool depthSort; /* draw the opaque batches front to back with depth testing, then the rest in order */
+	RSGL_renderStats* stats; /* NULL unless RSGL_renderer_setStats was called */
 } RSGL_renderPass;
 
 typedef struct RSGL_rendererProc {
@@ -381,6 +407,9 @@ typedef struct RSGL_rendererProc {
 	RSGL_framebuffer (*createFramebuffer)(void* ctx, size_t width, size_t height);
 	void (*attachFramebuffer)(void* ctx, RSGL_framebuffer fbo, RSGL_texture tex, u8 attachType, u8 mipLevel);
 	void (*deleteFramebuffer)(void* ctx, RSGL_framebuffer fbo);
+	void (*readPixels)(void* ctx, i32 x, i32 y, i32 w, i32 h, float renderer_height, u8* data);
+	void (*requestPixels)(void* ctx, i32 x, i32 y, i32 w, i32 h, float renderer_height);
+	RSGL_bool (*fetchPixels)(void* ctx, u8* data, RSGL_bool wait);
 } RSGL_rendererProc;
 
 typedef struct RSGL_renderer {
@@ -393,6 +422,10 @@ typedef struct RSGL_renderer {
 	RSGL_texture defaultTexture;
 	RSGL_programInfo defaultProgram;
 	RSGL_mat4 defaultPerspectiveMatrix;
+	size_t width, height; /* set by RSGL_renderer_updateSize */
+	RSGL_renderStats* stats;
+	RSGL_bool staticBackend; /* made from the RSGL_STATIC_BACKEND backend */
+	size_t* defaultRefs; /* renderers using defaultTexture, the last one to be freed deletes it */
 
     float verts[RSGL_MAX_VERTS * 3];
     float texCoords[RSGL_MAX_VERTS * 2];
@@ -412,6 +445,14 @@ RSGLDEF void RSGL_renderer_initPtr(RSGL_rendererProc proc,
 					);
 
 RSGLDEF RSGL_renderer* RSGL_renderer_init(RSGL_rendererProc proc, void* loader);
+
+/*
+	like RSGL_renderer_initPtr, but reuses the default program and texture of `share` instead of creating new ones
+	the backend's objects must be visible to both renderers (e.g. OpenGL contexts in the same share group)
+	`share` may be NULL
+*/
+RSGLDEF void RSGL_renderer_initSharedPtr(RSGL_rendererProc proc, void* loader, void* ptr, RSGL_renderer* renderer, const RSGL_renderer* share);
+RSGLDEF RSGL_renderer* RSGL_renderer_initShared(RSGL_rendererProc proc, void* loader, const RSGL_renderer* share);
 RSGLDEF void RSGL_renderer_updateSize(RSGL_renderer* renderer, size_t width, size_t height);
 RSGLDEF void RSGL_renderer_freePtr(RSGL_renderer* renderer);
 
@@ -443,6 +484,19 @@ RSGLDEF void RSGL_renderer_setGradient(RSGL_renderer* renderer,
                             ); /* apply gradient to drawing, based on color list*/
 RSGLDEF void RSGL_renderer_setCenter(RSGL_renderer* renderer, RSGL_vec3D center); /* the center of the drawing (or shape), this is used for rotation */
 RSGLDEF void RSGL_renderer_setOverflow(RSGL_renderer* renderer, RSGL_bool overflow);
+/*
+	give every draw its own depth, so opaque draws (alpha 255 color, opaque texture, no gradient) can be drawn
+	front to back with depth testing and without blending, the translucent ones are drawn after them in order
+	the output matches drawing in order, as long as the draws are 2D and the depth buffer is cleared with RSGL_renderer_clear every frame
+	this replaces the z of the draws and is ignored when drawing to a framebuffer, which has no depth buffer
+*/
+RSGLDEF void RSGL_renderer_setDepthSort(RSGL_renderer* renderer, RSGL_bool depthSort);
+/* mark the current texture as having no transparent texels, RSGL_renderer_setTexture resets this */
+RSGLDEF void RSGL_renderer_setTextureOpaque(RSGL_renderer* renderer, RSGL_bool opaque);
+/* the z of the next depth sorted draw, for geometry that doesn't go through RSGL_drawRawVerts */
+RSGLDEF float RSGL_renderer_nextDepth(RSGL_renderer* renderer);
+/* count the fragments shaded by the following renders into stats, NULL stops counting */
+RSGLDEF void RSGL_renderer_setStats(RSGL_renderer* renderer, RSGL_renderStats* stats);
 /* args clear after a draw function by default, this toggles that */
 RSGLDEF void RSGL_renderer_clearArgs(RSGL_renderer* renderer); /* clears the args */
 
@@ -464,6 +518,21 @@ RSGLDEF void RSGL_renderer_deleteFramebuffer(RSGL_renderer* renderer, RSGL_frame
 RSGLDEF void RSGL_renderer_scissorStart(RSGL_renderer* renderer, RSGL_rect scissor, i32 height);
 /* stops scissoring */
 RSGLDEF void RSGL_renderer_scissorEnd(RSGL_renderer* renderer);
+/*
+	clip the following draws to a rect (in framebuffer pixels, top-left origin)
+	unlike scissorStart this is batch state, so nothing has to be flushed around the clipped draws
+	when no matrix is set, draws outside the rect are dropped, draws inside it and axis aligned rects are batched unclipped
+*/
+RSGLDEF void RSGL_renderer_setClip(RSGL_renderer* renderer, RSGL_rect clip);
+RSGLDEF void RSGL_renderer_resetClip(RSGL_renderer* renderer);
+/* read back RGBA8 pixels (top-left origin) of the current surface, this draws the current batch and waits for it to finish */
+RSGLDEF void RSGL_renderer_readPixels(RSGL_renderer* renderer, RSGL_rect rect, i32 height, u8* data);
+/* start reading back RGBA8 pixels (top-left origin) of the current surface without waiting for the GPU */
+RSGLDEF void RSGL_renderer_requestPixels(RSGL_renderer* renderer, RSGL_rect rect, i32 height);
+/* copy the pixels of the last RSGL_renderer_requestPixels call, returns false if there are none or they aren't ready and wait is false */
+RSGLDEF RSGL_bool RSGL_renderer_fetchPixels(RSGL_renderer* renderer, u8* data, RSGL_bool wait);
+/* flips rows of pixel data in place, for backends that read back with a bottom-left origin */
+RSGLDEF void RSGL_flipRows(u8* data, size_t rowSize, size_t rows);
 /* custom shader program */
 RSGLDEF RSGL_programBlob RSGL_renderer_defaultBlob(RSGL_renderer* ctx);
 RSGLDEF RSGL_programInfo RSGL_renderer_createProgram(RSGL_renderer* renderer, RSGL_programBlob* blob);
@@ -554,6 +623,8 @@ RSGLDEF i32 RSGL_drawArc(RSGL_renderer* renderer, RSGL_rect o, RSGL_vec2D arc);
 RSGLDEF i32 RSGL_drawOval(RSGL_renderer* renderer, RSGL_rect o);
 
 RSGLDEF i32 RSGL_drawLine(RSGL_renderer* renderer, RSGL_vec2D p1, RSGL_vec2D p2, u32 thickness);
+/* connected line through count points, drawn as triangles so any thickness stays in one batch */
+RSGLDEF i32 RSGL_drawPolyline(RSGL_renderer* renderer, const RSGL_vec2D* points, size_t count, float thickness);
 
 /* 3D objects */
 RSGLDEF i32 RSGL_drawTriangle(RSGL_renderer* renderer, RSGL_vec3D[3]);
@@ -616,6 +687,7 @@ typedef union RSGL_view {
 
 RSGLDEF RSGL_mat4 RSGL_view_getMatrix(const RSGL_view* view);
 
+#define RSGL_HIGHLEVEL_H
 #endif /* ndef RSGL_HIGHLEVEL_H && ndef RSGL_NO_HIGHLEVEL */
 
 #ifdef RSGL_IMPLEMENTATION
@@ -630,6 +702,13 @@ RSGLDEF RSGL_mat4 RSGL_view_getMatrix(const RSGL_view* view);
     #define RAD2DEG (float)(180.0f / M_PI)
 #endif
 
+/* calls a backend function, directly when the renderer uses the static backend */
+#ifdef RSGL_STATIC_BACKEND
+	#define RSGL_PROC(renderer, name, args) ((renderer)->staticBackend ? RSGL_STATIC_BACKEND(name) args : (renderer)->proc.name args)
+#else
+	#define RSGL_PROC(renderer, name, args) ((renderer)->proc.name args)
+#endif
+
 #define RSGL_GET_MATRIX_X(x, y, z) (float)(matrix.m[0] * x + matrix.m[4] * y + matrix.m[8] * z + matrix.m[12])
 #define RSGL_GET_MATRIX_Y(x, y, z) (float)(matrix.m[1] * x + matrix.m[5] * y + matrix.m[9] * z + matrix.m[13])
 #define RSGL_GET_MATRIX_Z(x, y, z) (float)(matrix.m[2] * x + matrix.m[6] * y + matrix.m[10] * z + matrix.m[14])
@@ -650,6 +729,15 @@ void RSGL_renderer_forceBatch(RSGL_renderer* renderer) {
     renderer->state.forceBatch = RSGL_TRUE;
 }
 
+void RSGL_renderer_setClip(RSGL_renderer* renderer, RSGL_rect clip) {
+	renderer->state.clipped = RSGL_TRUE;
+	renderer->state.clip = clip;
+}
+
+void RSGL_renderer_resetClip(RSGL_renderer* renderer) {
+	renderer->state.clipped = RSGL_FALSE;
+}
+
 void RSGL_renderer_setPerspectiveMatrix(RSGL_renderer* renderer, RSGL_mat4 matrix) {
 	renderer->state.perspectiveMatrix = matrix;
 }
@@ -682,8 +770,141 @@ void RSGL_renderer_getRenderState(RSGL_renderer* renderer, RSGL_renderState* sta
 void RSGL_renderer_setOverflow(RSGL_renderer* renderer, RSGL_bool overflow) {
 	renderer->state.overflow = overflow;
 }
+
+/* draw n lands at 1 - n / 2^21 in NDC, four units apart in a 24 bit depth buffer */
+#define RSGL_MAX_DEPTH_DRAWS ((1u << 22) - 1)
+
+void RSGL_renderer_setDepthSort(RSGL_renderer* renderer, RSGL_bool depthSort) {
+	renderer->state.depthSort = depthSort;
+}
+
+void RSGL_renderer_setTextureOpaque(RSGL_renderer* renderer, RSGL_bool opaque) {
+	renderer->state.textureOpaque = opaque;
+}
+
+float RSGL_renderer_nextDepth(RSGL_renderer* renderer) {
+	/* past the limit every draw shares the front most depth, RSGL_drawRawVerts stops marking them opaque */
+	if (renderer->data.depth < RSGL_MAX_DEPTH_DRAWS)
+		renderer->data.depth += 1;
+	return (float)renderer->data.depth;
+}
+
+void RSGL_renderer_setStats(RSGL_renderer* renderer, RSGL_renderStats* stats) {
+	renderer->stats = stats;
+}
 #include <stdio.h>
+typedef enum RSGL_clipResult {
+	RSGL_clipScissor = 0, /* crosses the clip rect, the batch has to be scissored */
+	RSGL_clipInside,
+	RSGL_clipOutside,
+	RSGL_clipGeometry /* cut to the clip rect on the CPU */
+} RSGL_clipResult;
+
+static RSGL_bool RSGL_mat4_isIdentity(const float m[16]) {
+	size_t i;
+	for (i = 0; i < 16; i++) {
+		if (m[i] != ((i % 5 == 0) ? 1.0f : 0.0f))
+			return RSGL_FALSE;
+	}
+	return RSGL_TRUE;
+}
+
+static RSGL_bool RSGL_rect_equal(RSGL_rect a, RSGL_rect b) {
+	return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+}
+
+/*
+	classify a draw against the clip rect, the verts must be in framebuffer pixels
+	an axis aligned quad that crosses the rect is cut into `verts` and `texCoords` and returned through `out`
+*/
+static RSGL_clipResult RSGL_clipRawVerts(RSGL_renderer* renderer, const RSGL_rawVerts* data, RSGL_rawVerts* out, float verts[12], float texCoords[8]) {
+	RSGL_rect clip = renderer->state.clip;
+	if (data->vert_count == 0)
+		return RSGL_clipInside;
+
+	/* lines and points reach half their width past their vertices */
+	float pad = 0.0f;
+	if (data->type != RSGL_TRIANGLES)
+		pad = (renderer->state.lineWidth ? renderer->state.lineWidth : 1.0f) * 0.5f;
+
+	float minX = data->verts[0], maxX = data->verts[0];
+	float minY = data->verts[1], maxY = data->verts[1];
+	size_t i, j;
+	for (i = 1; i < data->vert_count; i++) {
+		float x = data->verts[i * 3], y = data->verts[i * 3 + 1];
+		if (x < minX) minX = x;
+		if (x > maxX) maxX = x;
+		if (y < minY) minY = y;
+		if (y > maxY) maxY = y;
+	}
+
+	if (maxX + pad <= clip.x || maxY + pad <= clip.y || minX - pad >= clip.x + clip.w || minY - pad >= clip.y + clip.h)
+		return RSGL_clipOutside;
+	if (minX - pad >= clip.x && minY - pad >= clip.y && maxX + pad <= clip.x + clip.w && maxY + pad <= clip.y + clip.h)
+		return RSGL_clipInside;
+
+	/* cutting a gradient would move its colors, anything but a rect would need new triangles */
+	if (data->type != RSGL_TRIANGLES || data->vert_count != 4 || minX == maxX || minY == maxY ||
+		(renderer->state.gradient_len && renderer->state.gradient))
+		return RSGL_clipScissor;
+
+	float x0 = (minX > clip.x) ? minX : clip.x;
+	float y0 = (minY > clip.y) ? minY : clip.y;
+	float x1 = (maxX < clip.x + clip.w) ? maxX : clip.x + clip.w;
+	float y1 = (maxY < clip.y + clip.h) ? maxY : clip.y + clip.h;
+
+	for (i = 0; i < 4; i++) {
+		const float* p = &data->verts[i * 3];
+		const float* t = &data->texCoords[i * 2];
+		if ((p[0] != minX && p[0] != maxX) || (p[1] != minY && p[1] != maxY))
+			return RSGL_clipScissor;
+
+		/* the neighbouring corners along x and y, the texture coordinates are interpolated towards them */
+		size_t acrossX = i, acrossY = i;
+		for (j = 0; j < 4; j++) {
+			const float* q = &data->verts[j * 3];
+			if (q[1] == p[1] && q[0] != p[0]) acrossX = j;
+			if (q[0] == p[0] && q[1] != p[1]) acrossY = j;
+		}
+
+		if (acrossX == i || acrossY == i)
+			return RSGL_clipScissor;
+
+		float x = (p[0] == minX) ? x0 : x1;
+		float y = (p[1] == minY) ? y0 : y1;
+		float fx = (x - p[0]) / (data->verts[acrossX * 3] - p[0]);
+		float fy = (y - p[1]) / (data->verts[acrossY * 3 + 1] - p[1]);
+
+		verts[i * 3] = x;
+		verts[i * 3 + 1] = y;
+		verts[i * 3 + 2] = p[2];
+		texCoords[i * 2] = t[0] + (data->texCoords[acrossX * 2] - t[0]) * fx + (data->texCoords[acrossY * 2] - t[0]) * fy;
+		texCoords[i * 2 + 1] = t[1] + (data->texCoords[acrossX * 2 + 1] - t[1]) * fx + (data->texCoords[acrossY * 2 + 1] - t[1]) * fy;
+	}
+
+	*out = *data;
+	out->verts = verts;
+	out->texCoords = texCoords;
+	return RSGL_clipGeometry;
+}
+
 i32 RSGL_drawRawVerts(RSGL_renderer* renderer, const RSGL_rawVerts* data) {
+	RSGL_bool clipped = renderer->state.clipped;
+	RSGL_rawVerts cut;
+	float cutVerts[12];
+	float cutTexCoords[8];
+
+	/* the clip rect is in framebuffer pixels, the verts only are too when no matrix moves them */
+	if (clipped && RSGL_mat4_isIdentity(renderer->state.modelMatrix.m) &&
+		RSGL_mat4_isIdentity(renderer->state.viewMatrix.m) && RSGL_mat4_isIdentity(renderer->state.perspectiveMatrix.m)) {
+		switch (RSGL_clipRawVerts(renderer, data, &cut, cutVerts, cutTexCoords)) {
+			case RSGL_clipOutside: return -1;
+			case RSGL_clipInside: clipped = RSGL_FALSE; break;
+			case RSGL_clipGeometry: data = &cut; clipped = RSGL_FALSE; break;
+			default: break;
+		}
+	}
+
 	if ((renderer->state.buffers->batchCount + 1 >= RSGL_MAX_BATCHES || renderer->data.len + data->vert_count >= renderer->state.buffers->maxVerts) && renderer->state.overflow) {
         RSGL_renderer_render(renderer);
     }
@@ -691,11 +912,23 @@ i32 RSGL_drawRawVerts(RSGL_renderer* renderer, const RSGL_rawVerts* data) {
 	RSGL_BATCH* batch = NULL;
 	RSGL_color c = renderer->state.color;
 
+	RSGL_bool opaque = RSGL_FALSE;
+	float depth = 0.0f;
+	if (renderer->state.depthSort) {
+		depth = RSGL_renderer_nextDepth(renderer);
+		opaque = data->type == RSGL_TRIANGLES && c.a == 255 && renderer->state.textureOpaque &&
+				(renderer->state.gradient_len == 0 || renderer->state.gradient == NULL) &&
+				renderer->data.depth < RSGL_MAX_DEPTH_DRAWS;
+	}
+
     if (
         renderer->state.buffers->batchCount == 0 ||
         renderer->state.buffers->batches[renderer->state.buffers->batchCount - 1].tex != renderer->state.texture  ||
         renderer->state.buffers->batches[renderer->state.buffers->batchCount - 1].lineWidth != renderer->state.lineWidth ||
         renderer->state.buffers->batches[renderer->state.buffers->batchCount - 1].type != data->type ||
+        renderer->state.buffers->batches[renderer->state.buffers->batchCount - 1].clipped != clipped ||
+        (clipped && RSGL_rect_equal(renderer->state.buffers->batches[renderer->state.buffers->batchCount - 1].clip, renderer->state.clip) == RSGL_FALSE) ||
+        renderer->state.buffers->batches[renderer->state.buffers->batchCount - 1].opaque != opaque ||
         renderer->state.forceBatch
     ) {
         renderer->state.forceBatch = RSGL_FALSE;
@@ -710,6 +943,9 @@ i32 RSGL_drawRawVerts(RSGL_renderer* renderer, const RSGL_rawVerts* data) {
         batch->tex = renderer->state.texture;
         batch->lineWidth = renderer->state.lineWidth;
 		batch->matrix = renderer->state.modelMatrix;
+		batch->clipped = clipped;
+		batch->clip = renderer->state.clip;
+		batch->opaque = opaque;
     } else {
         batch = &renderer->state.buffers->batches[renderer->state.buffers->batchCount - 1];
     }
@@ -726,6 +962,11 @@ i32 RSGL_drawRawVerts(RSGL_renderer* renderer, const RSGL_rawVerts* data) {
 
 	size_t i;
 
+	if (renderer->state.depthSort) {
+		for (i = 0; i < data->vert_count; i++)
+			renderer->data.verts[(renderer->data.len + i) * 3 + 2] = depth;
+	}
+
 	for (i = 0; i < data->elmCount; i++) {
 		size_t index = renderer->data.elements_count + i;
 		u16 elm = data->elements[i] + (u16)renderer->data.len;
@@ -783,7 +1024,7 @@ void RSGL_renderer_createRenderBuffers(RSGL_renderer* renderer, size_t size, RSG
 
 void RSGL_renderer_updateBuffer(RSGL_renderer* renderer, RSGL_bufferType type, size_t buffer, void* data, size_t start, size_t len) {
 	if (renderer->proc.updateBuffer)
-		renderer->proc.updateBuffer(renderer->ctx, type, buffer, data, start, len);
+		RSGL_PROC(renderer, updateBuffer, (renderer->ctx, type, buffer, data, start, len));
 }
 
 void RSGL_renderer_deleteBuffer(RSGL_renderer* renderer, size_t buffer) {
@@ -791,7 +1032,27 @@ void RSGL_renderer_deleteBuffer(RSGL_renderer* renderer, size_t buffer) {
 		renderer->proc.deleteBuffer(renderer->ctx, buffer);
 }
 
+/* reverse the order of a batch's triangles, so the last drawn (front most) go first */
+static void RSGL_reverseTriangles(u16* elements, size_t count) {
+	size_t first = 0, last = count - 3;
+	for (; first < last; first += 3, last -= 3) {
+		u16 tri[3] = { elements[first], elements[first + 1], elements[first + 2] };
+		RSGL_MEMCPY(&elements[first], &elements[last], sizeof(tri));
+		RSGL_MEMCPY(&elements[last], tri, sizeof(tri));
+	}
+}
+
 void RSGL_renderer_updateRenderBuffers(RSGL_renderer* renderer) {
+	/* only a depth sorted pass draws the opaque batches front to back, framebuffer passes draw everything in order */
+	size_t i;
+	if (renderer->state.depthSort && renderer->state.framebuffer == 0) {
+		for (i = 0; i < renderer->state.buffers->batchCount; i++) {
+			const RSGL_BATCH* batch = &renderer->state.buffers->batches[i];
+			if (batch->opaque && batch->elmCount >= 6)
+				RSGL_reverseTriangles(&renderer->data.elements[batch->elmStart], batch->elmCount);
+		}
+	}
+
 	RSGL_renderer_updateBuffer(renderer, RSGL_arrayBuffer, renderer->state.buffers->vertex, renderer->data.verts, 0, renderer->data.len * 3 * sizeof(float));
 	RSGL_renderer_updateBuffer(renderer, RSGL_arrayBuffer, renderer->state.buffers->color, renderer->data.colors, 0, renderer->data.len * 4 * sizeof(float));
 	RSGL_renderer_updateBuffer(renderer, RSGL_arrayBuffer, renderer->state.buffers->texture, renderer->data.texCoords, 0, renderer->data.len * 2 * sizeof(float));
@@ -808,9 +1069,20 @@ void RSGL_renderer_renderBuffers(RSGL_renderer* renderer) {
 	pass.matrix = matrix.m;
 	pass.buffers = renderer->state.buffers;
 	pass.framebuffer = renderer->state.framebuffer;
+	pass.height = (float)renderer->height;
+	pass.depthSort = renderer->state.depthSort && renderer->state.framebuffer == 0;
+	pass.stats = renderer->stats;
+
+	/* replace the z row, draw n goes to 1 - n / 2^21 so the cleared depth of 1 is behind everything */
+	if (renderer->state.depthSort) {
+		matrix.m[2] = 0.0f;
+		matrix.m[6] = 0.0f;
+		matrix.m[10] = pass.depthSort ? -1.0f / (float)(1 << 21) : 0.0f;
+		matrix.m[14] = pass.depthSort ? 1.0f : 0.0f;
+	}
 
 	if (renderer->proc.render)
-		renderer->proc.render(renderer->ctx, &pass);
+		RSGL_PROC(renderer, render, (renderer->ctx, &pass));
 
 	renderer->data.len = 0;
 	renderer->data.elements_count = 0;
@@ -832,8 +1104,17 @@ size_t RSGL_renderer_size(RSGL_renderer* renderer) {
 }
 
 void RSGL_renderer_initPtr(RSGL_rendererProc proc, void* loader, void* data, RSGL_renderer* renderer) {
+	RSGL_renderer_initSharedPtr(proc, loader, data, renderer, NULL);
+}
+
+void RSGL_renderer_initSharedPtr(RSGL_rendererProc proc, void* loader, void* data, RSGL_renderer* renderer, const RSGL_renderer* share) {
 	renderer->ctx = data;
 	renderer->proc = proc;
+#ifdef RSGL_STATIC_BACKEND
+	renderer->staticBackend = (proc.size == RSGL_STATIC_BACKEND(size));
+#else
+	renderer->staticBackend = RSGL_FALSE;
+#endif
     RSGL_renderer_clearArgs(renderer);
     renderer->state.color = RSGL_RGBA(0, 0, 0, 255);
 
@@ -844,25 +1125,38 @@ void RSGL_renderer_initPtr(RSGL_rendererProc proc, void* loader, void* data, RSG
 	renderer->data.colors = renderer->colors;
 	renderer->data.len = 0;
 	renderer->data.elements_count = 0;
+	renderer->data.depth = 0;
+	renderer->stats = NULL;
 
 	if (renderer->proc.initPtr)
 		renderer->proc.initPtr(renderer->ctx, loader);
 
 	RSGL_renderer_setFramebuffer(renderer, 0);
 
-	RSGL_programBlob pBlob = RSGL_renderer_defaultBlob(renderer);
-	renderer->defaultProgram = RSGL_renderer_createProgram(renderer, &pBlob);
-	RSGL_renderer_setProgram(renderer, &renderer->defaultProgram);
-
-    u8 white[4] = {255, 255, 255, 255};
-	RSGL_textureBlob blob;
-	blob.data = white;
-	blob.width = 1;
-	blob.height = 1;
-	blob.dataType = RSGL_textureDataInt;
-	blob.dataFormat = RSGL_formatRGBA;
-	blob.textureFormat = RSGL_formatRGBA;
-    renderer->defaultTexture = RSGL_renderer_createTexture(renderer, &blob);
+	if (share) {
+		renderer->defaultProgram = share->defaultProgram;
+		renderer->defaultTexture = share->defaultTexture;
+		renderer->defaultRefs = share->defaultRefs;
+		if (renderer->defaultRefs) *renderer->defaultRefs += 1;
+		RSGL_renderer_setProgram(renderer, &renderer->defaultProgram);
+	} else {
+		RSGL_programBlob pBlob = RSGL_renderer_defaultBlob(renderer);
+		renderer->defaultProgram = RSGL_renderer_createProgram(renderer, &pBlob);
+		RSGL_renderer_setProgram(renderer, &renderer->defaultProgram);
+
+		u8 white[4] = {255, 255, 255, 255};
+		RSGL_textureBlob blob;
+		RSGL_MEMSET(&blob, 0, sizeof(blob));
+		blob.data = white;
+		blob.width = 1;
+		blob.height = 1;
+		blob.dataType = RSGL_textureDataInt;
+		blob.dataFormat = RSGL_formatRGBA;
+		blob.textureFormat = RSGL_formatRGBA;
+		renderer->defaultTexture = RSGL_renderer_createTexture(renderer, &blob);
+		renderer->defaultRefs = (size_t*)RSGL_MALLOC(sizeof(size_t));
+		*renderer->defaultRefs = 1;
+	}
 
 	RSGL_renderer_setTexture(renderer, renderer->defaultTexture);
 
@@ -883,9 +1177,23 @@ RSGL_renderer* RSGL_renderer_init(RSGL_rendererProc proc, void* loader) {
 	return renderer;
 }
 
+RSGL_renderer* RSGL_renderer_initShared(RSGL_rendererProc proc, void* loader, const RSGL_renderer* share) {
+	RSGL_renderer* renderer = (RSGL_renderer*)RSGL_MALLOC(sizeof(RSGL_renderer));
+	void* data = RSGL_MALLOC(proc.size());
+	RSGL_renderer_initSharedPtr(proc, loader, data, renderer, share);
+	return renderer;
+}
+
 void RSGL_renderer_freePtr(RSGL_renderer* renderer) {
 	RSGL_renderer_deleteRenderBuffers(renderer, &renderer->buffers);
 
+	if (renderer->defaultRefs && --(*renderer->defaultRefs) == 0) {
+		if (renderer->proc.deleteTexture)
+			RSGL_renderer_deleteTexture(renderer, renderer->defaultTexture);
+		RSGL_FREE(renderer->defaultRefs);
+	}
+	renderer->defaultRefs = NULL;
+
 	if (renderer->proc.freePtr)
 		renderer->proc.freePtr(renderer->ctx);
 
@@ -902,21 +1210,56 @@ void RSGL_renderer_free(RSGL_renderer* renderer) {
 }
 
 void RSGL_renderer_clear(RSGL_renderer* renderer, RSGL_color color) {
+	renderer->data.depth = 0;
 	if (renderer->proc.clear)
-		renderer->proc.clear(renderer->ctx, renderer->state.framebuffer, ((float)color.r) / 255.0f, ((float)color.g) / 255.0f, ((float)color.b) / 255.0f, ((float)color.a) / 255.0f);
+		RSGL_PROC(renderer, clear, (renderer->ctx, renderer->state.framebuffer, ((float)color.r) / 255.0f, ((float)color.g) / 255.0f, ((float)color.b) / 255.0f, ((float)color.a) / 255.0f));
 }
-void RSGL_renderer_viewport(RSGL_renderer* renderer, RSGL_rect rect) { renderer->proc.viewport(renderer->ctx, rect.x, rect.y, rect.w, rect.h); }
+void RSGL_renderer_viewport(RSGL_renderer* renderer, RSGL_rect rect) { RSGL_PROC(renderer, viewport, (renderer->ctx, rect.x, rect.y, rect.w, rect.h)); }
 RSGL_texture RSGL_renderer_createTexture(RSGL_renderer* renderer, const RSGL_textureBlob* blob) {
     RSGL_texture tex = 0;
 	if (renderer->proc.createTexture) tex = renderer->proc.createTexture(renderer->ctx, blob);
 	return tex;
 }
 void RSGL_renderer_copyToTexture(RSGL_renderer* renderer, RSGL_texture texture, size_t x, size_t y, const RSGL_textureBlob* blob) {
-    return renderer->proc.copyToTexture(renderer->ctx, texture, x, y, blob);
+    RSGL_PROC(renderer, copyToTexture, (renderer->ctx, texture, x, y, blob));
 }
 void RSGL_renderer_deleteTexture(RSGL_renderer* renderer, RSGL_texture tex) { renderer->proc.deleteTexture(renderer->ctx, tex); }
 void RSGL_renderer_scissorStart(RSGL_renderer* renderer, RSGL_rect scissor, i32 height) {
-	renderer->proc.scissorStart(renderer->ctx, scissor.x, scissor.y, scissor.w, scissor.h, height);
+	RSGL_PROC(renderer, scissorStart, (renderer->ctx, scissor.x, scissor.y, scissor.w, scissor.h, height));
+}
+
+void RSGL_renderer_readPixels(RSGL_renderer* renderer, RSGL_rect rect, i32 height, u8* data) {
+	RSGL_renderer_render(renderer);
+	if (renderer->proc.readPixels)
+		renderer->proc.readPixels(renderer->ctx, rect.x, rect.y, rect.w, rect.h, height, data);
+}
+
+void RSGL_renderer_requestPixels(RSGL_renderer* renderer, RSGL_rect rect, i32 height) {
+	RSGL_renderer_render(renderer);
+	if (renderer->proc.requestPixels)
+		renderer->proc.requestPixels(renderer->ctx, rect.x, rect.y, rect.w, rect.h, height);
+}
+
+RSGL_bool RSGL_renderer_fetchPixels(RSGL_renderer* renderer, u8* data, RSGL_bool wait) {
+	if (renderer->proc.fetchPixels == NULL)
+		return RSGL_FALSE;
+	return renderer->proc.fetchPixels(renderer->ctx, data, wait);
+}
+
+void RSGL_flipRows(u8* data, size_t rowSize, size_t rows) {
+	u8 tmp[256];
+	size_t i, j;
+	for (i = 0; i < rows / 2; i++) {
+		u8* top = data + i * rowSize;
+		u8* bottom = data + (rows - i - 1) * rowSize;
+
+		for (j = 0; j < rowSize; j += sizeof(tmp)) {
+			size_t len = (rowSize - j < sizeof(tmp)) ? (rowSize - j) : sizeof(tmp);
+			RSGL_MEMCPY(tmp, top + j, len);
+			RSGL_MEMCPY(top + j, bottom + j, len);
+			RSGL_MEMCPY(bottom + j, tmp, len);
+		}
+	}
 }
 
 RSGL_framebuffer RSGL_renderer_createFramebuffer(RSGL_renderer* renderer, size_t width, size_t height) {
@@ -938,7 +1281,7 @@ void RSGL_renderer_deleteFramebuffer(RSGL_renderer* renderer, RSGL_framebuffer f
 }
 
 void RSGL_renderer_scissorEnd(RSGL_renderer* renderer) {
-	renderer->proc.scissorEnd(renderer->ctx);
+	RSGL_PROC(renderer, scissorEnd, (renderer->ctx));
 }
 RSGL_programBlob RSGL_renderer_defaultBlob(RSGL_renderer* renderer) {
 	RSGL_programBlob blob;
@@ -985,6 +1328,9 @@ void RSGL_renderer_bindComputeTexture(RSGL_renderer* renderer, u32 texture, u8 f
 }
 
 void RSGL_renderer_updateSize(RSGL_renderer* renderer, size_t width, size_t height) {
+	renderer->width = width;
+	renderer->height = height;
+
 	RSGL_projection projection;
 	projection.p2D.type = RSGL_projectionOrtho2D;
 	projection.p2D.width = width;
@@ -1004,6 +1350,7 @@ void RSGL_renderer_setTexture(RSGL_renderer* renderer, RSGL_texture texture) {
 		renderer->state.texture = texture;
 
 	renderer->state.source = RSGL_RECT(0, 0, 1, 1);
+	renderer->state.textureOpaque = (renderer->state.texture == renderer->defaultTexture);
 }
 
 void RSGL_renderer_setTextureSource(RSGL_renderer* renderer, RSGL_texture texture, RSGL_rect rect) {
@@ -1083,6 +1430,21 @@ RFont_RSGL integration
 #include "RFont.h"
 #endif
 
+/* expands a 1 channel coverage bitmap to RGBA, define RSGL_COVERAGE_TO_RGBA to use your own (e.g. SIMD) version */
+#ifndef RSGL_COVERAGE_TO_RGBA
+#define RSGL_COVERAGE_TO_RGBA(dst, src, count) RSGL_coverageToRGBA(dst, src, count)
+
+static void RSGL_coverageToRGBA(u8* dst, const u8* src, size_t count) {
+	size_t i;
+	for (i = 0; i < count; i++) {
+		dst[i * 4 + 0] = src[i];
+		dst[i * 4 + 1] = src[i];
+		dst[i * 4 + 2] = src[i];
+		dst[i * 4 + 3] = src[i];
+	}
+}
+#endif
+
 struct RFont_renderer* RFont_RSGL_renderer_init(struct RSGL_renderer* ptr) {
 	RFont_renderer* renderer = (RFont_renderer*)RFONT_MALLOC(sizeof(RFont_renderer));
 	RFont_renderer_initPtr(RFont_RSGL_renderer_proc(), ptr, renderer);
@@ -1113,6 +1475,7 @@ void RFont_RSGL_render_text(RSGL_renderer* renderer, const RFont_render_data* sr
 
 RFont_texture RFont_RSGL_createAtlas(RSGL_renderer* renderer, u32 atlasWidth, u32 atlasHeight) {
 	RSGL_textureBlob blob;
+	RSGL_MEMSET(&blob, 0, sizeof(blob)); /* the filters are read by createTexture */
 	blob.data = NULL;
 	blob.width = atlasWidth;
 	blob.height = atlasWidth;
@@ -1135,33 +1498,22 @@ void RFont_RSGL_bitmapToAtlas(RSGL_renderer* renderer, RFont_texture atlas, u32
 	}
 
 	RSGL_textureBlob blob;
+	RSGL_MEMSET(&blob, 0, sizeof(blob));
 	blob.width = w;
 	blob.height = h;
 	blob.dataType = RSGL_textureDataInt;
 	blob.dataFormat = RSGL_formatRGBA;
 	blob.textureFormat = blob.dataFormat;
 
-	u8* newBitmap = (u8*)RSGL_MALLOC(w * h * 4);
+	u8* newBitmap = (u8*)RSGL_TEMP_MALLOC(w * h * 4);
 
-	for (size_t indexY = 0; indexY < (size_t)h; indexY++) {
-		for (size_t indexX = 0; indexX < (size_t)w; indexX++) {
-			size_t index = ((indexY * (size_t)w * 4) + indexX * 4);
-			size_t oIndex = ((indexY * (size_t)w) + indexX);
-
-			u8 value = bitmap[oIndex];
-
-			newBitmap[index + 0] = value;
-			newBitmap[index + 1] = value;
-			newBitmap[index + 2] = value;
-			newBitmap[index + 3] = value;
-		}
-	}
+	RSGL_COVERAGE_TO_RGBA(newBitmap, bitmap, (size_t)w * (size_t)h);
 
 	blob.data = newBitmap;
 
 	RSGL_renderer_copyToTexture(renderer, atlas, (size_t)(*x), (size_t)(*y), &blob);
 
-	RSGL_FREE(newBitmap);
+	RSGL_TEMP_FREE(newBitmap);
 
 	*x += w;
 }
@@ -1261,9 +1613,11 @@ i32 RSGL_drawRoundRect(RSGL_renderer* renderer, RSGL_rect r, RSGL_vec2D rounding
 i32 RSGL_drawPolygonOutlineEx(RSGL_renderer* renderer, RSGL_rect o, u32 sides, RSGL_vec2D arc);
 
 i32 RSGL_drawPolygonEx(RSGL_renderer* renderer, RSGL_rect o, u32 sides, RSGL_vec2D arc) {
-	static float verts[360 * 3];
-    static float texcoords[360 * 2];
-	static u16 elements[360 * 6];
+	/* the center, sides + 1 points around it and a triangle per point */
+	size_t vertCount = (size_t)sides + 2;
+	float* verts = (float*)RSGL_TEMP_MALLOC(vertCount * 5 * sizeof(float) + (vertCount - 1) * 3 * sizeof(u16));
+	float* texcoords = verts + vertCount * 3;
+	u16* elements = (u16*)(texcoords + vertCount * 2);
 
     RSGL_vec3D center =  (RSGL_vec3D){o.x + (o.w / 2.0f), o.y + (o.h / 2.0f), 0};
 
@@ -1330,6 +1684,7 @@ i32 RSGL_drawPolygonEx(RSGL_renderer* renderer, RSGL_rect o, u32 sides, RSGL_vec
 	data.vert_count = (vIndex / 3);
 
     i32 out = RSGL_drawRawVerts(renderer, &data);
+	RSGL_TEMP_FREE(verts);
 	return out;
 }
 
@@ -1555,6 +1910,129 @@ i32 RSGL_drawLine(RSGL_renderer* renderer, RSGL_vec2D p1, RSGL_vec2D p2, u32 thi
 	return RSGL_drawRawVerts(renderer, &data);
 }
 
+#ifndef RSGL_POLYLINE_CHUNK
+#define RSGL_POLYLINE_CHUNK 256 /* points expanded on the stack per RSGL_drawRawVerts call */
+#endif
+
+/* unit normals of the segments ending (n[0]) and starting (n[1]) at point i, an end point copies the one it has */
+static void RSGL_polylineNormals(const RSGL_vec2D* points, size_t count, size_t i, RSGL_vec2D n[2]) {
+	size_t j;
+	for (j = 0; j < 2; j++) {
+		n[j] = RSGL_VEC2D(0, 0);
+		if ((j == 0 && i == 0) || (j == 1 && i + 1 >= count))
+			continue;
+
+		RSGL_vec2D a = points[i + j - 1];
+		RSGL_vec2D b = points[i + j];
+		float dx = b.x - a.x, dy = b.y - a.y;
+		float len = sqrtf(dx * dx + dy * dy);
+		if (len > 0.0f)
+			n[j] = RSGL_VEC2D(-dy / len, dx / len);
+	}
+
+	if (n[0].x == 0.0f && n[0].y == 0.0f) n[0] = n[1];
+	if (n[1].x == 0.0f && n[1].y == 0.0f) n[1] = n[0];
+}
+
+/*
+ * every segment is a quad between two pairs of outline corners
+ * mitered joints share one pair between both segments, joints sharper than 120 degrees would need a long spike (or flip the quad),
+ * so they get a pair per segment instead and are left unjoined
+*/
+i32 RSGL_drawPolyline(RSGL_renderer* renderer, const RSGL_vec2D* points, size_t count, float thickness) {
+	float verts[RSGL_POLYLINE_CHUNK * 4 * 3];
+	float texCoords[RSGL_POLYLINE_CHUNK * 4 * 2];
+	u16 elements[(RSGL_POLYLINE_CHUNK - 1) * 6];
+	i32 out = -1;
+
+	if (count < 2)
+		return -1;
+
+	RSGL_bool rotated = renderer->state.rotate.x || renderer->state.rotate.y || renderer->state.rotate.z;
+	RSGL_vec3D center = {(points[0].x + points[count - 1].x) / 2.0f, (points[0].y + points[count - 1].y) / 2.0f, 0.0f};
+	RSGL_mat4 matrix = RSGL_renderer_initDrawMatrix(renderer, center);
+
+	/* the texture source runs across the line */
+	float u = renderer->state.source.x;
+	float v0 = renderer->state.source.y, v1 = renderer->state.source.y + renderer->state.source.h;
+	float half = thickness / 2.0f;
+
+	/* chunks overlap by one point so the segment between them isn't lost */
+	size_t start;
+	for (start = 0; start + 1 < count; start += RSGL_POLYLINE_CHUNK - 1) {
+		size_t len = count - start;
+		if (len > RSGL_POLYLINE_CHUNK)
+			len = RSGL_POLYLINE_CHUNK;
+
+		size_t pairs = 0, elmCount = 0;
+		size_t i, j;
+		for (i = 0; i < len; i++) {
+			RSGL_vec2D p = points[start + i];
+			RSGL_vec2D n[2];
+			RSGL_polylineNormals(points, count, start + i, n);
+
+			/* cos of half the turn between the segments, 0.5 at 120 degrees */
+			RSGL_vec2D m = RSGL_VEC2D(n[0].x + n[1].x, n[0].y + n[1].y);
+			float mLen = sqrtf(m.x * m.x + m.y * m.y);
+			float cosHalf = mLen / 2.0f;
+
+			RSGL_vec2D offsets[2];
+			size_t offsetCount = 1;
+			if (cosHalf >= 0.5f) {
+				float scale = half / (mLen * cosHalf);
+				offsets[0] = RSGL_VEC2D(m.x * scale, m.y * scale);
+			} else if (i == 0) {
+				/* the first point of a chunk only starts a segment */
+				offsets[0] = RSGL_VEC2D(n[1].x * half, n[1].y * half);
+			} else {
+				offsets[0] = RSGL_VEC2D(n[0].x * half, n[0].y * half);
+				offsets[1] = RSGL_VEC2D(n[1].x * half, n[1].y * half);
+				offsetCount = (i + 1 < len) ? 2 : 1;
+			}
+
+			/* the segment from the previous point ends on the first pair */
+			if (i) {
+				u16 k = (u16)(pairs * 2);
+				u16* elm = &elements[elmCount];
+				elm[0] = (u16)(k - 2); elm[1] = (u16)(k - 1); elm[2] = k;
+				elm[3] = (u16)(k + 1); elm[4] = k; elm[5] = (u16)(k - 1);
+				elmCount += 6;
+			}
+
+			for (j = 0; j < offsetCount; j++, pairs++) {
+				float x0 = p.x + offsets[j].x, y0 = p.y + offsets[j].y;
+				float x1 = p.x - offsets[j].x, y1 = p.y - offsets[j].y;
+
+				float* vert = &verts[pairs * 6];
+				if (rotated) {
+					float corners[] = {RSGL_GET_MATRIX_POINT(x0, y0, 0.0f), RSGL_GET_MATRIX_POINT(x1, y1, 0.0f)};
+					RSGL_MEMCPY(vert, corners, sizeof(corners));
+				} else {
+					vert[0] = x0; vert[1] = y0; vert[2] = 0.0f;
+					vert[3] = x1; vert[4] = y1; vert[5] = 0.0f;
+				}
+
+				texCoords[pairs * 4] = u; texCoords[pairs * 4 + 1] = v0;
+				texCoords[pairs * 4 + 2] = u; texCoords[pairs * 4 + 3] = v1;
+			}
+		}
+
+		RSGL_rawVerts data;
+		data.type = RSGL_TRIANGLES;
+		data.verts = verts;
+		data.texCoords = texCoords;
+		data.elements = elements;
+		data.elmCount = elmCount;
+		data.vert_count = pairs * 2;
+
+		i32 batch = RSGL_drawRawVerts(renderer, &data);
+		if (batch >= 0)
+			out = batch;
+	}
+
+	return out;
+}
+
 i32 RSGL_drawTriangleOutline(RSGL_renderer* renderer, RSGL_vec3D t[3], u32 thickness) {
     renderer->state.lineWidth = thickness;
     RSGL_vec3D center = {t[2].x, (t[2].y + t[0].y) / 2.0f, 0};
@@ -1610,8 +2088,17 @@ i32 RSGL_drawRoundRectOutline(RSGL_renderer* renderer, RSGL_rect r, RSGL_vec2D r
 }
 
 i32 RSGL_drawPolygonOutlineEx(RSGL_renderer* renderer, RSGL_rect o, u32 sides, RSGL_vec2D arc) {
-    static float verts[360 * 2 * 3];
-    static float texCoords[360 * 2 * 2];
+    /* two points per step of the arc, the elements below read at least 6 */
+    size_t vertCount = 6, steps = 0;
+    i32 step;
+    for (step = arc.x; step < arc.y; step++)
+        steps++;
+    if (steps * 2 > vertCount)
+        vertCount = steps * 2;
+
+    float* verts = (float*)RSGL_TEMP_MALLOC(vertCount * 5 * sizeof(float));
+    float* texCoords = verts + vertCount * 3;
+    RSGL_MEMSET(verts, 0, vertCount * 5 * sizeof(float));
 
     RSGL_vec3D center = (RSGL_vec3D) {o.x + (o.w / 2.0f), o.y + (o.h / 2.0f), 0.0f};
         RSGL_mat4 matrix = RSGL_renderer_initDrawMatrix(renderer, center);
@@ -1654,7 +2141,9 @@ i32 RSGL_drawPolygonOutlineEx(RSGL_renderer* renderer, RSGL_rect o, u32 sides, R
 	data.elmCount = 6;
 	data.vert_count = 6;
 
-    return RSGL_drawRawVerts(renderer, &data);
+    i32 out = RSGL_drawRawVerts(renderer, &data);
+    RSGL_TEMP_FREE(verts);
+    return out;
 }
 
 i32 RSGL_drawPolygonOutline(RSGL_renderer* renderer, RSGL_rect o, u32 sides, u32 thickness) {
@@ -26,6 +26,16 @@
 
 typedef struct RSGL_glRenderer {
 	u32 vao;
+
+	/* pixel readback, a pixel pack buffer and fence on GL3/GLES3, a CPU copy otherwise */
+	u32 pbo;
+	void* readbackSync;
+	u8* readback;
+	size_t readbackSize, readbackCap;
+	i32 readbackWidth, readbackHeight;
+	RSGL_bool readbackPending;
+
+	u32 query; /* GL_SAMPLES_PASSED query for RSGL_renderStats, created on first use */
 } RSGL_glRenderer;
 
 RSGLDEF RSGL_rendererProc RSGL_GL_rendererProc(void);
@@ -62,6 +72,18 @@ RSGLDEF RSGL_framebuffer RSGL_GL_createFramebuffer(RSGL_glRenderer* renderer, si
 RSGLDEF void RSGL_GL_attachFramebuffer(RSGL_glRenderer* renderer, RSGL_framebuffer fbo, RSGL_texture tex, u8 attachType, u8 mipLevel);
 RSGLDEF void RSGL_GL_deleteFramebuffer(RSGL_glRenderer* renderer, RSGL_framebuffer fbo);
 
+/* pixel readback */
+RSGLDEF void RSGL_GL_readPixels(RSGL_glRenderer* ctx, i32 x, i32 y, i32 w, i32 h, float renderer_height, u8* data);
+RSGLDEF void RSGL_GL_requestPixels(RSGL_glRenderer* ctx, i32 x, i32 y, i32 w, i32 h, float renderer_height);
+RSGLDEF RSGL_bool RSGL_GL_fetchPixels(RSGL_glRenderer* ctx, u8* data, RSGL_bool wait);
+
+/*
+	keep linked program binaries in `directory` (it has to exist), keyed by the shader sources and the driver's vendor, renderer and version strings
+	a missing or rejected entry is compiled from source and written again, NULL turns the cache off
+	needs GL 4.1, ARB_get_program_binary or GLES3, without them programs are always compiled
+*/
+RSGLDEF void RSGL_GL_setProgramCache(const char* directory);
+
 #ifdef RSGL_USE_COMPUTE
 RSGLDEF RSGL_programInfo RSGL_GL_createComputeProgram(RSGL_glRenderer* ctx, const char* CShaderCode);
 RSGLDEF void RSGL_GL_dispatchComputeProgram(RSGL_glRenderer* ctx, RSGL_programInfo program, u32 groups_x, u32 groups_y, u32 groups_z);
@@ -99,6 +121,16 @@ typedef int	 GLsizei;
 #include <GL/glext.h>
 #endif
 
+/* GLES2 only has the OES variant with different names */
+#if !defined(RSGL_GLES2) && !defined(RSGL_NO_GL_LOADER)
+	#define RSGL_GL_PROGRAM_BINARY
+#endif
+
+/* GLES only has boolean occlusion queries */
+#if !defined(RSGL_GLES2) && !defined(RSGL_GLES3)
+	#define RSGL_GL_SAMPLE_QUERIES
+#endif
+
 #ifndef RSGL_NO_GL_LOADER
 
 typedef void (*RSGL_gl_proc)(void); // function pointer equivalent of void*
@@ -144,10 +176,44 @@ typedef void (*glUniform4fPROC) (GLint location, GLfloat v0, GLfloat v1, GLfloat
 	typedef void (*glGenVertexArraysPROC)(GLsizei n, GLuint *arrays);
 	typedef void (*glBindVertexArrayPROC)(GLuint array);
 	typedef void (*glDeleteVertexArraysPROC) (GLsizei n, const GLuint *arrays);
+	typedef void* (*glMapBufferRangePROC) (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+	typedef GLboolean (*glUnmapBufferPROC) (GLenum target);
+	typedef GLsync (*glFenceSyncPROC) (GLenum condition, GLbitfield flags);
+	typedef GLenum (*glClientWaitSyncPROC) (GLsync sync, GLbitfield flags, GLuint64 timeout);
+	typedef void (*glDeleteSyncPROC) (GLsync sync);
 
 	glGenVertexArraysPROC glGenVertexArraysSRC = NULL;
 	glBindVertexArrayPROC glBindVertexArraySRC = NULL;
 	glDeleteVertexArraysPROC glDeleteVertexArraysSRC = NULL;
+	glMapBufferRangePROC glMapBufferRangeSRC = NULL;
+	glUnmapBufferPROC glUnmapBufferSRC = NULL;
+	glFenceSyncPROC glFenceSyncSRC = NULL;
+	glClientWaitSyncPROC glClientWaitSyncSRC = NULL;
+	glDeleteSyncPROC glDeleteSyncSRC = NULL;
+#endif
+
+#ifdef RSGL_GL_PROGRAM_BINARY
+	typedef void (*glGetProgramBinaryPROC) (GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
+	typedef void (*glProgramBinaryPROC) (GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+	typedef void (*glProgramParameteriPROC) (GLuint program, GLenum pname, GLint value);
+
+	glGetProgramBinaryPROC glGetProgramBinarySRC = NULL;
+	glProgramBinaryPROC glProgramBinarySRC = NULL;
+	glProgramParameteriPROC glProgramParameteriSRC = NULL;
+#endif
+
+#ifdef RSGL_GL_SAMPLE_QUERIES
+	typedef void (*glGenQueriesPROC) (GLsizei n, GLuint *ids);
+	typedef void (*glDeleteQueriesPROC) (GLsizei n, const GLuint *ids);
+	typedef void (*glBeginQueryPROC) (GLenum target, GLuint id);
+	typedef void (*glEndQueryPROC) (GLenum target);
+	typedef void (*glGetQueryObjectuivPROC) (GLuint id, GLenum pname, GLuint *params);
+
+	glGenQueriesPROC glGenQueriesSRC = NULL;
+	glDeleteQueriesPROC glDeleteQueriesSRC = NULL;
+	glBeginQueryPROC glBeginQuerySRC = NULL;
+	glEndQueryPROC glEndQuerySRC = NULL;
+	glGetQueryObjectuivPROC glGetQueryObjectuivSRC = NULL;
 #endif
 
 glShaderSourcePROC glShaderSourceSRC = NULL;
@@ -244,6 +310,25 @@ glFramebufferTexture2DPROC glFramebufferTexture2DSRC = NULL;
 	#define glGenVertexArrays glGenVertexArraysSRC
 	#define glBindVertexArray glBindVertexArraySRC
 	#define glDeleteVertexArrays glDeleteVertexArraysSRC
+	#define glMapBufferRange glMapBufferRangeSRC
+	#define glUnmapBuffer glUnmapBufferSRC
+	#define glFenceSync glFenceSyncSRC
+	#define glClientWaitSync glClientWaitSyncSRC
+	#define glDeleteSync glDeleteSyncSRC
+#endif
+
+#ifdef RSGL_GL_PROGRAM_BINARY
+	#define glGetProgramBinary glGetProgramBinarySRC
+	#define glProgramBinary glProgramBinarySRC
+	#define glProgramParameteri glProgramParameteriSRC
+#endif
+
+#ifdef RSGL_GL_SAMPLE_QUERIES
+	#define glGenQueries glGenQueriesSRC
+	#define glDeleteQueries glDeleteQueriesSRC
+	#define glBeginQuery glBeginQuerySRC
+	#define glEndQuery glEndQuerySRC
+	#define glGetQueryObjectuiv glGetQueryObjectuivSRC
 #endif
 
 #ifdef RSGL_USE_COMPUTE
@@ -290,6 +375,9 @@ RSGL_rendererProc RSGL_GL_rendererProc() {
 	proc.createFramebuffer = (RSGL_framebuffer (*)(void*, size_t, size_t))RSGL_GL_createFramebuffer;
 	proc.attachFramebuffer = (void (*)(void*, RSGL_framebuffer, RSGL_texture, u8, u8))RSGL_GL_attachFramebuffer;
 	proc.deleteFramebuffer = (void (*)(void*, RSGL_framebuffer))RSGL_GL_deleteFramebuffer;
+	proc.readPixels = (void (*)(void*, i32, i32, i32, i32, float, u8*))RSGL_GL_readPixels;
+	proc.requestPixels = (void (*)(void*, i32, i32, i32, i32, float))RSGL_GL_requestPixels;
+	proc.fetchPixels = (RSGL_bool (*)(void*, u8*, RSGL_bool))RSGL_GL_fetchPixels;
 
 
 //	proc.setSurface = (void (*)(void*, void*))RSGL_GL_setSurface;
@@ -346,7 +434,7 @@ void RSGL_GL_createBuffer(RSGL_glRenderer* ctx, RSGL_bufferType type, size_t siz
 }
 
 void RSGL_GL_updateBuffer(RSGL_glRenderer* ctx, RSGL_bufferType type, size_t buffer, const void* data, size_t start, size_t end) {
-	glBindBuffer(RSGL_GL_bufferTypeToNative(type), *(u32*)&buffer);
+	glBindBuffer(RSGL_GL_bufferTypeToNative(type), (u32)buffer);
 	glBufferSubData(RSGL_GL_bufferTypeToNative(type), start, end, data);
 }
 
@@ -469,6 +557,8 @@ print matrix array code snippet
 
 
 void RSGL_GL_initPtr(RSGL_glRenderer* ctx, void* proc) {
+	RSGL_MEMSET(ctx, 0, sizeof(RSGL_glRenderer));
+
     #if !defined(__EMSCRIPTEN__) && !defined(RSGL_NO_GL_LOADER)
     if (RSGL_loadGLModern((RSGLloadfunc)proc)) {
         #ifdef RSGL_DEBUG
@@ -498,7 +588,44 @@ void RSGL_GL_initPtr(RSGL_glRenderer* ctx, void* proc) {
 void RSGL_GL_freePtr(RSGL_glRenderer* ctx) {
 #if defined(RSGL_GLES3) || defined(RSGL_GL3)
 	glDeleteVertexArrays(0, &ctx->vao);
+
+	if (ctx->readbackSync) glDeleteSync((GLsync)ctx->readbackSync);
+	if (ctx->pbo) glDeleteBuffers(1, &ctx->pbo);
 #endif
+#ifdef RSGL_GL_SAMPLE_QUERIES
+	if (ctx->query) glDeleteQueries(1, &ctx->query);
+#endif
+	if (ctx->readback) RSGL_FREE(ctx->readback);
+}
+
+static void RSGL_GL_drawBatch(const RSGL_renderPass* pass, const RSGL_BATCH* batch, RSGL_bool* scissor) {
+	GLenum mode = GL_TRIANGLES;
+	glBindTexture(GL_TEXTURE_2D, batch->tex);
+
+	if (batch->clipped) {
+		RSGL_rect clip = batch->clip;
+		if (*scissor == RSGL_FALSE)
+			glEnable(GL_SCISSOR_TEST);
+		*scissor = RSGL_TRUE;
+		glScissor((i32)clip.x, (i32)(pass->height - (clip.y + clip.h)), (i32)(clip.w > 0 ? clip.w : 0), (i32)(clip.h > 0 ? clip.h : 0));
+	} else if (*scissor) {
+		glDisable(GL_SCISSOR_TEST);
+		*scissor = RSGL_FALSE;
+	}
+
+	if (batch->lineWidth)
+		glLineWidth(batch->lineWidth);
+
+	glUniformMatrix4fv(pass->program->model, 1, GL_FALSE, batch->matrix.m);
+
+	switch (batch->type) {
+		case RSGL_TRIANGLES: mode = GL_TRIANGLES; break;
+		case RSGL_POINTS: mode = GL_POINTS; break;
+		case RSGL_LINES:  mode = GL_LINES; break;
+		default: break;
+	}
+
+	glDrawElements(mode, (i32)batch->elmCount, GL_UNSIGNED_SHORT, (void*)(batch->elmStart * sizeof(u16)));
 }
 
 void RSGL_GL_render(RSGL_glRenderer* ctx, const RSGL_renderPass* pass) {
@@ -525,26 +652,56 @@ void RSGL_GL_render(RSGL_glRenderer* ctx, const RSGL_renderPass* pass) {
 	glUseProgram(pass->program->program);
 	glUniformMatrix4fv(pass->program->perspectiveView, 1, GL_FALSE, pass->matrix);
 
-	u32 i;
-	for (i = 0; i < pass->buffers->batchCount; i++) {
-		GLenum mode = GL_TRIANGLES;
-		glBindTexture(GL_TEXTURE_2D, pass->buffers->batches[i].tex);
+	RSGL_bool scissor = RSGL_FALSE;
 
-		if (pass->buffers->batches[i].lineWidth)
-			glLineWidth(pass->buffers->batches[i].lineWidth);
+#ifdef RSGL_GL_SAMPLE_QUERIES
+	if (pass->stats) {
+		if (ctx->query == 0)
+			glGenQueries(1, &ctx->query);
+		glBeginQuery(GL_SAMPLES_PASSED, ctx->query);
+	}
+#endif
 
-		glUniformMatrix4fv(pass->program->model, 1, GL_FALSE, pass->buffers->batches[i].matrix.m);
+	size_t i;
+	if (pass->depthSort) {
+		/* opaque batches front to back without blending, the depth test drops whatever a later draw covers */
+		glEnable(GL_DEPTH_TEST);
+		glDepthFunc(GL_LEQUAL);
+		glDisable(GL_BLEND);
+		for (i = pass->buffers->batchCount; i-- > 0;) {
+			if (pass->buffers->batches[i].opaque)
+				RSGL_GL_drawBatch(pass, &pass->buffers->batches[i], &scissor);
+		}
 
-		switch (pass->buffers->batches[i].type) {
-			case RSGL_TRIANGLES: mode = GL_TRIANGLES; break;
-			case RSGL_POINTS: mode = GL_POINTS; break;
-			case RSGL_LINES:  mode = GL_LINES; break;
-			default: break;
+		/* the rest in order on top, hidden where a later opaque draw covers them */
+		glEnable(GL_BLEND);
+		glDepthMask(GL_FALSE);
+		for (i = 0; i < pass->buffers->batchCount; i++) {
+			if (pass->buffers->batches[i].opaque == RSGL_FALSE)
+				RSGL_GL_drawBatch(pass, &pass->buffers->batches[i], &scissor);
 		}
 
-		glDrawElements(mode, (i32)pass->buffers->batches[i].elmCount, GL_UNSIGNED_SHORT, (void*)(pass->buffers->batches[i].elmStart * sizeof(u16)));
+		glDepthMask(GL_TRUE);
+		glDisable(GL_DEPTH_TEST);
+	} else {
+		for (i = 0; i < pass->buffers->batchCount; i++)
+			RSGL_GL_drawBatch(pass, &pass->buffers->batches[i], &scissor);
 	}
 
+	if (scissor)
+		glDisable(GL_SCISSOR_TEST);
+
+#ifdef RSGL_GL_SAMPLE_QUERIES
+	/* waits for the GPU, only done while someone is counting */
+	if (pass->stats) {
+		GLuint fragments = 0;
+		glEndQuery(GL_SAMPLES_PASSED);
+		glGetQueryObjectuiv(ctx->query, GL_QUERY_RESULT, &fragments);
+		pass->stats->fragments += fragments;
+		pass->stats->counted = RSGL_TRUE;
+	}
+#endif
+
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
@@ -568,6 +725,96 @@ void RSGL_GL_scissorEnd(RSGL_glRenderer* ctx) {
     glDisable(GL_SCISSOR_TEST);
 }
 
+#ifndef GL_PIXEL_PACK_BUFFER
+	#define GL_PIXEL_PACK_BUFFER 0x88EB
+	#define GL_STREAM_READ 0x88E1
+	#define GL_MAP_READ_BIT 0x0001
+#endif
+
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+	#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+	#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+	#define GL_TIMEOUT_EXPIRED 0x911B
+#endif
+
+void RSGL_GL_readPixels(RSGL_glRenderer* ctx, i32 x, i32 y, i32 w, i32 h, float renderer_height, u8* data) {
+	RSGL_UNUSED(ctx);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(x, (i32)renderer_height - (y + h), w, h, GL_RGBA, GL_UNSIGNED_BYTE, data);
+	RSGL_flipRows(data, (size_t)w * 4, (size_t)h);
+}
+
+void RSGL_GL_requestPixels(RSGL_glRenderer* ctx, i32 x, i32 y, i32 w, i32 h, float renderer_height) {
+	size_t size = (size_t)w * (size_t)h * 4;
+	ctx->readbackSize = size;
+	ctx->readbackWidth = w;
+	ctx->readbackHeight = h;
+	ctx->readbackPending = RSGL_TRUE;
+
+#if defined(RSGL_GLES3) || defined(RSGL_GL3)
+	/* the copy happens on the GPU timeline, fetchPixels only stalls if it isn't done yet */
+	if (ctx->pbo == 0)
+		glGenBuffers(1, &ctx->pbo);
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, ctx->pbo);
+	if (size > ctx->readbackCap) {
+		glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)size, NULL, GL_STREAM_READ);
+		ctx->readbackCap = size;
+	}
+
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(x, (i32)renderer_height - (y + h), w, h, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	if (ctx->readbackSync) glDeleteSync((GLsync)ctx->readbackSync);
+	ctx->readbackSync = (void*)glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#else
+	if (size > ctx->readbackCap) {
+		ctx->readback = (u8*)RSGL_REALLOC(ctx->readback, size);
+		ctx->readbackCap = size;
+	}
+
+	RSGL_GL_readPixels(ctx, x, y, w, h, renderer_height, ctx->readback);
+#endif
+}
+
+RSGL_bool RSGL_GL_fetchPixels(RSGL_glRenderer* ctx, u8* data, RSGL_bool wait) {
+	if (ctx->readbackPending == RSGL_FALSE) return RSGL_FALSE;
+
+#if defined(RSGL_GLES3) || defined(RSGL_GL3)
+	if (ctx->readbackSync) {
+		GLenum status = glClientWaitSync((GLsync)ctx->readbackSync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		if (status == GL_TIMEOUT_EXPIRED && wait == RSGL_FALSE)
+			return RSGL_FALSE;
+
+		while (status == GL_TIMEOUT_EXPIRED)
+			status = glClientWaitSync((GLsync)ctx->readbackSync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+
+		glDeleteSync((GLsync)ctx->readbackSync);
+		ctx->readbackSync = NULL;
+	}
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, ctx->pbo);
+	const u8* mapped = (const u8*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)ctx->readbackSize, GL_MAP_READ_BIT);
+	if (mapped) {
+		/* flip to a top-left origin while copying out */
+		size_t rowSize = (size_t)ctx->readbackWidth * 4;
+		i32 row;
+		for (row = 0; row < ctx->readbackHeight; row++)
+			RSGL_MEMCPY(data + (size_t)row * rowSize, mapped + (size_t)(ctx->readbackHeight - row - 1) * rowSize, rowSize);
+
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#else
+	RSGL_UNUSED(wait);
+	RSGL_MEMCPY(data, ctx->readback, ctx->readbackSize);
+#endif
+
+	ctx->readbackPending = RSGL_FALSE;
+	return RSGL_TRUE;
+}
+
 GLuint RSGL_GL_textureFormatToNative(RSGL_textureFormat format) {
 	switch (format) {
 		case RSGL_formatRGB: return GL_RGB;
@@ -735,9 +982,143 @@ void RSGL_debug_shader(u32 src, const char *shader, const char *action) {
 }
 #endif
 
-RSGL_programInfo RSGL_GL_createProgram(RSGL_glRenderer* ctx, RSGL_programBlob* blob) {
-	RSGL_programInfo program;
-	u32 vShader, fShader;
+#ifdef RSGL_GL_PROGRAM_BINARY
+#include <stdio.h>
+#include <string.h>
+
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+	#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+	#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+	#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
+#define RSGL_GL_PROGRAM_CACHE_MAGIC 0x42505352u /* "RSPB" */
+
+typedef struct RSGL_gl_programCacheHeader {
+	u32 magic;
+	u32 format;
+	u32 length;
+	u32 reserved;
+	u64 key; /* repeated so a renamed or truncated file is rejected */
+} RSGL_gl_programCacheHeader;
+
+static char RSGL_GL_programCacheDir[512] = { 0 };
+#endif
+
+void RSGL_GL_setProgramCache(const char* directory) {
+#ifdef RSGL_GL_PROGRAM_BINARY
+	RSGL_GL_programCacheDir[0] = '\0';
+	if (directory && strlen(directory) < sizeof(RSGL_GL_programCacheDir) - 32)
+		strcpy(RSGL_GL_programCacheDir, directory);
+#else
+	RSGL_UNUSED(directory);
+#endif
+}
+
+#ifdef RSGL_GL_PROGRAM_BINARY
+static u64 RSGL_GL_hashString(u64 hash, const char* str) {
+	/* the terminator is hashed too, so "ab" + "c" and "a" + "bc" differ */
+	for (;; str++) {
+		hash = (hash ^ (u8)*str) * 1099511628211ull;
+		if (*str == '\0')
+			return hash;
+	}
+}
+
+/* returns false if there's no usable cache, otherwise fills the key and the entry's path */
+static RSGL_bool RSGL_GL_programCachePath(const RSGL_programBlob* blob, u64* key, char* path, size_t size) {
+	if (RSGL_GL_programCacheDir[0] == '\0' || glProgramBinary == NULL || glGetProgramBinary == NULL || glProgramParameteri == NULL)
+		return RSGL_FALSE;
+
+	GLint formats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+	if (formats <= 0)
+		return RSGL_FALSE;
+
+	const char* strings[5];
+	strings[0] = blob->vertex;
+	strings[1] = blob->fragment;
+	strings[2] = (const char*)glGetString(GL_VENDOR);
+	strings[3] = (const char*)glGetString(GL_RENDERER);
+	strings[4] = (const char*)glGetString(GL_VERSION);
+
+	u64 hash = 14695981039346656037ull;
+	size_t i;
+	for (i = 0; i < sizeof(strings) / sizeof(strings[0]); i++)
+		hash = RSGL_GL_hashString(hash, strings[i] ? strings[i] : "");
+
+	*key = hash;
+	snprintf(path, size, "%s/%016llx.rsglbin", RSGL_GL_programCacheDir, (unsigned long long)hash);
+	return RSGL_TRUE;
+}
+
+/* link `program` from the cache entry, returns false if it's missing or the driver rejects it */
+static RSGL_bool RSGL_GL_loadProgramBinary(u32 program, u64 key, const char* path) {
+	FILE* file = fopen(path, "rb");
+	if (file == NULL)
+		return RSGL_FALSE;
+
+	RSGL_gl_programCacheHeader header;
+	void* binary = NULL;
+	GLint linked = GL_FALSE;
+
+	if (fread(&header, sizeof(header), 1, file) == 1 && header.magic == RSGL_GL_PROGRAM_CACHE_MAGIC && header.key == key && header.length) {
+		binary = RSGL_TEMP_MALLOC(header.length);
+		if (fread(binary, 1, header.length, file) == header.length) {
+			glProgramBinary(program, (GLenum)header.format, binary, (GLsizei)header.length);
+			/* a driver update changes the version string, but a driver may still reject its own binaries */
+			glGetProgramiv(program, GL_LINK_STATUS, &linked);
+		}
+		RSGL_TEMP_FREE(binary);
+	}
+
+	fclose(file);
+	return linked == GL_TRUE;
+}
+
+static void RSGL_GL_saveProgramBinary(u32 program, u64 key, const char* path) {
+	GLint length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return;
+
+	RSGL_gl_programCacheHeader header;
+	RSGL_MEMSET(&header, 0, sizeof(header));
+	header.magic = RSGL_GL_PROGRAM_CACHE_MAGIC;
+	header.key = key;
+
+	void* binary = RSGL_TEMP_MALLOC((size_t)length);
+	GLenum format = 0;
+	GLsizei written = 0;
+	glGetProgramBinary(program, length, &written, &format, binary);
+	header.format = format;
+	header.length = (u32)written;
+
+	/* written next to the entry and renamed, so another process never reads half a file */
+	char temp[sizeof(RSGL_GL_programCacheDir) + 64];
+	snprintf(temp, sizeof(temp), "%s.tmp", path);
+
+	FILE* file = written > 0 ? fopen(temp, "wb") : NULL;
+	if (file) {
+		RSGL_bool ok = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(binary, 1, (size_t)written, file) == (size_t)written;
+		ok = (fclose(file) == 0) && ok;
+
+		remove(path); /* rename doesn't replace on windows */
+		if (ok == RSGL_FALSE || rename(temp, path) != 0)
+			remove(temp);
+	}
+
+	RSGL_TEMP_FREE(binary);
+}
+#endif
+
+/* compile and link the blob's shaders, `retrievable` asks the driver to keep the binary for glGetProgramBinary */
+static u32 RSGL_GL_compileProgram(const RSGL_programBlob* blob, RSGL_bool retrievable) {
+	u32 program, vShader, fShader;
 
 	/* compile vertex shader */
 	vShader = glCreateShader(GL_VERTEX_SHADER);
@@ -758,18 +1139,58 @@ RSGL_programInfo RSGL_GL_createProgram(RSGL_glRenderer* ctx, RSGL_programBlob* b
 #endif
 
 	/* create program and link vertex and fragment shaders */
-	program.program = glCreateProgram();
+	program = glCreateProgram();
 
-	glAttachShader(program.program, vShader);
-	glAttachShader(program.program, fShader);
-	glLinkProgram(program.program);
+	glAttachShader(program, vShader);
+	glAttachShader(program, fShader);
+#ifdef RSGL_GL_PROGRAM_BINARY
+	if (retrievable)
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#else
+	RSGL_UNUSED(retrievable);
+#endif
+	glLinkProgram(program);
 
 #ifdef RSGL_DEBUG
-	RSGL_debug_shader(program.program, "Program", "link");
+	RSGL_debug_shader(program, "Program", "link");
 #endif
 
 	glDeleteShader(vShader);
 	glDeleteShader(fShader);
+	return program;
+}
+
+RSGL_programInfo RSGL_GL_createProgram(RSGL_glRenderer* ctx, RSGL_programBlob* blob) {
+	RSGL_programInfo program;
+
+#ifdef RSGL_GL_PROGRAM_BINARY
+	char cachePath[sizeof(RSGL_GL_programCacheDir) + 32];
+	u64 cacheKey = 0;
+	RSGL_bool cached = RSGL_GL_programCachePath(blob, &cacheKey, cachePath, sizeof(cachePath));
+	RSGL_bool loaded = RSGL_FALSE;
+
+	if (cached) {
+		program.program = glCreateProgram();
+		loaded = RSGL_GL_loadProgramBinary((u32)program.program, cacheKey, cachePath);
+		if (loaded == RSGL_FALSE)
+			glDeleteProgram(program.program);
+	#ifdef RSGL_DEBUG
+		else
+			printf("Loaded program from %s\n", cachePath);
+	#endif
+	}
+
+	if (loaded == RSGL_FALSE) {
+		program.program = RSGL_GL_compileProgram(blob, cached);
+
+		GLint status = GL_FALSE;
+		glGetProgramiv(program.program, GL_LINK_STATUS, &status);
+		if (cached && status == GL_TRUE)
+			RSGL_GL_saveProgramBinary((u32)program.program, cacheKey, cachePath);
+	}
+#else
+	program.program = RSGL_GL_compileProgram(blob, RSGL_FALSE);
+#endif
 
 	glUseProgram(program.program);
 
@@ -956,6 +1377,23 @@ int RSGL_loadGLModern(RSGLloadfunc proc) {
 	RSGL_PROC_DEF(proc, glBindVertexArray);
 	RSGL_PROC_DEF(proc, glGenVertexArrays);
 	RSGL_PROC_DEF(proc, glDeleteVertexArrays);
+	RSGL_PROC_DEF(proc, glMapBufferRange);
+	RSGL_PROC_DEF(proc, glUnmapBuffer);
+	RSGL_PROC_DEF(proc, glFenceSync);
+	RSGL_PROC_DEF(proc, glClientWaitSync);
+	RSGL_PROC_DEF(proc, glDeleteSync);
+#endif
+#ifdef RSGL_GL_PROGRAM_BINARY
+	RSGL_PROC_DEF(proc, glGetProgramBinary);
+	RSGL_PROC_DEF(proc, glProgramBinary);
+	RSGL_PROC_DEF(proc, glProgramParameteri);
+#endif
+#ifdef RSGL_GL_SAMPLE_QUERIES
+	RSGL_PROC_DEF(proc, glGenQueries);
+	RSGL_PROC_DEF(proc, glDeleteQueries);
+	RSGL_PROC_DEF(proc, glBeginQuery);
+	RSGL_PROC_DEF(proc, glEndQuery);
+	RSGL_PROC_DEF(proc, glGetQueryObjectuiv);
 #endif
 #ifdef RSGL_USE_COMPUTE
 	RSGL_PROC_DEF(proc, glDispatchCompute);
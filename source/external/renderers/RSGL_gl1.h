@@ -9,7 +9,32 @@
 #ifndef RSGL_GL1_H
 #define RSGL_GL1_H
 
-typedef struct RSGL_gl1Renderer { } RSGL_gl1Renderer;
+/*
+	define RSGL_GL1_DISPLAY_LIST_CACHE to compile batches that are drawn again unchanged into display lists,
+	on drivers that keep display lists on the GPU this saves sending the same vertices every frame
+*/
+#ifdef RSGL_GL1_DISPLAY_LIST_CACHE
+#ifndef RSGL_GL1_DISPLAY_LIST_COUNT
+	#define RSGL_GL1_DISPLAY_LIST_COUNT 64
+#endif
+
+typedef struct RSGL_gl1DisplayList {
+	u64 hash; /* of the batch's draw type, vertices and elements */
+	u32 list; /* 0 until the batch is drawn a second time */
+	size_t lastUsed;
+} RSGL_gl1DisplayList;
+#endif
+
+typedef struct RSGL_gl1Renderer {
+	u8* readback; /* pixels read by RSGL_GL1_requestPixels, GL 1.1 has no async readback */
+	size_t readbackSize, readbackCap;
+	RSGL_bool readbackPending;
+
+#ifdef RSGL_GL1_DISPLAY_LIST_CACHE
+	RSGL_gl1DisplayList lists[RSGL_GL1_DISPLAY_LIST_COUNT];
+	size_t passCount;
+#endif
+} RSGL_gl1Renderer;
 
 RSGLDEF RSGL_rendererProc RSGL_GL1_rendererProc(void);
 RSGLDEF size_t RSGL_GL1_size(void);
@@ -34,6 +59,10 @@ RSGLDEF void RSGL_GL1_deleteTexture(RSGL_gl1Renderer* ctx, RSGL_texture tex);
 RSGLDEF void RSGL_GL1_scissorStart(RSGL_gl1Renderer* ctx, float x, float y, float w, float h, float renderer_height);
 /* stops scissoring */
 RSGLDEF void RSGL_GL1_scissorEnd(RSGL_gl1Renderer* ctx);
+/* pixel readback */
+RSGLDEF void RSGL_GL1_readPixels(RSGL_gl1Renderer* ctx, i32 x, i32 y, i32 w, i32 h, float renderer_height, u8* data);
+RSGLDEF void RSGL_GL1_requestPixels(RSGL_gl1Renderer* ctx, i32 x, i32 y, i32 w, i32 h, float renderer_height);
+RSGLDEF RSGL_bool RSGL_GL1_fetchPixels(RSGL_gl1Renderer* ctx, u8* data, RSGL_bool wait);
 #endif
 
 #ifdef RSGL_IMPLEMENTATION
@@ -88,6 +117,9 @@ RSGL_rendererProc RSGL_GL1_rendererProc() {
 	proc.createBuffer = (void (*)(void*, RSGL_bufferType, size_t, const void*, size_t*))RSGL_GL1_createBuffer;
 	proc.updateBuffer = (void (*)(void*, RSGL_bufferType, size_t, void*, size_t, size_t))RSGL_GL1_updateBuffer;
 	proc.deleteBuffer = (void (*)(void*, size_t))RSGL_GL1_deleteBuffer;
+	proc.readPixels = (void (*)(void*, i32, i32, i32, i32, float, u8*))RSGL_GL1_readPixels;
+	proc.requestPixels = (void (*)(void*, i32, i32, i32, i32, float))RSGL_GL1_requestPixels;
+	proc.fetchPixels = (RSGL_bool (*)(void*, u8*, RSGL_bool))RSGL_GL1_fetchPixels;
 	return proc;
 }
 
@@ -119,56 +151,169 @@ void RSGL_GL1_deleteBuffer(RSGL_gl1Renderer* ctx, size_t buffer) {
 }
 
 void RSGL_GL1_initPtr(RSGL_gl1Renderer* ctx, void* proc) {
-	RSGL_UNUSED(proc); RSGL_UNUSED(ctx);
+	RSGL_UNUSED(proc);
+	RSGL_MEMSET(ctx, 0, sizeof(RSGL_gl1Renderer));
 	glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 }
 
-void RSGL_GL1_freePtr(RSGL_gl1Renderer* ctx) { RSGL_UNUSED(ctx); }
+void RSGL_GL1_freePtr(RSGL_gl1Renderer* ctx) {
+	if (ctx->readback) RSGL_FREE(ctx->readback);
 
-void RSGL_GL1_render(RSGL_gl1Renderer* ctx, const RSGL_renderPass* pass) {
-	size_t i, j;
+#ifdef RSGL_GL1_DISPLAY_LIST_CACHE
+	size_t i;
+	for (i = 0; i < RSGL_GL1_DISPLAY_LIST_COUNT; i++) {
+		if (ctx->lists[i].list)
+			glDeleteLists(ctx->lists[i].list, 1);
+	}
+#endif
+}
+
+#ifdef RSGL_GL1_DISPLAY_LIST_CACHE
+static u64 RSGL_GL1_hash(u64 hash, const u32* words, size_t count) {
+	size_t i;
+	for (i = 0; i < count; i++)
+		hash = (hash ^ words[i]) * 1099511628211ull;
+	return hash;
+}
 
-	float* colors = (float*)pass->buffers->color;
-	float* verts = (float*)pass->buffers->vertex;
-	float* texCoords = (float*)pass->buffers->texture;
+/* draws the batch from its display list if it has been drawn unchanged before, returns false if the caller has to draw it */
+static RSGL_bool RSGL_GL1_callDisplayList(RSGL_gl1Renderer* ctx, const RSGL_renderPass* pass, const RSGL_BATCH* batch, u32 mode) {
+	const u16* elements = &((const u16*)pass->buffers->elements)[batch->elmStart];
+
+	u64 hash = RSGL_GL1_hash(14695981039346656037ull ^ mode, (const u32*)&((const float*)pass->buffers->vertex)[batch->start * 3], batch->len * 3);
+	hash = RSGL_GL1_hash(hash, (const u32*)&((const float*)pass->buffers->color)[batch->start * 4], batch->len * 4);
+	hash = RSGL_GL1_hash(hash, (const u32*)&((const float*)pass->buffers->texture)[batch->start * 2], batch->len * 2);
+
+	/* relative to the batch, the same batch can land anywhere in the buffers */
+	size_t i;
+	for (i = 0; i < batch->elmCount; i++)
+		hash = (hash ^ (u32)(elements[i] - batch->start)) * 1099511628211ull;
+
+	RSGL_gl1DisplayList* entry = &ctx->lists[0];
+	for (i = 0; i < RSGL_GL1_DISPLAY_LIST_COUNT; i++) {
+		RSGL_gl1DisplayList* list = &ctx->lists[i];
+		if (list->lastUsed && list->hash == hash) {
+			list->lastUsed = ctx->passCount;
+			if (list->list == 0) {
+				/* the arrays are read while the list is compiled, the list keeps the vertices themselves */
+				list->list = glGenLists(1);
+				glNewList(list->list, GL_COMPILE);
+				glDrawElements(mode, (GLsizei)batch->elmCount, GL_UNSIGNED_SHORT, elements);
+				glEndList();
+			}
+
+			glCallList(list->list);
+			return RSGL_TRUE;
+		}
+
+		if (list->lastUsed < entry->lastUsed)
+			entry = list;
+	}
+
+	/* the first sighting only reserves a slot, batches that change every frame never get compiled */
+	if (entry->list)
+		glDeleteLists(entry->list, 1);
+	entry->hash = hash;
+	entry->list = 0;
+	entry->lastUsed = ctx->passCount;
+	return RSGL_FALSE;
+}
+#endif
+
+static void RSGL_GL1_drawBatch(RSGL_gl1Renderer* ctx, const RSGL_renderPass* pass, const RSGL_BATCH* batch, RSGL_bool* scissor) {
 	u16* elements = (u16*)pass->buffers->elements;
 
+	glBindTexture(GL_TEXTURE_2D, batch->tex);
+	glLineWidth(batch->lineWidth);
+
+	if (batch->clipped) {
+		RSGL_rect clip = batch->clip;
+		if (*scissor == RSGL_FALSE)
+			glEnable(GL_SCISSOR_TEST);
+		*scissor = RSGL_TRUE;
+		glScissor((i32)clip.x, (i32)(pass->height - (clip.y + clip.h)), (i32)(clip.w > 0 ? clip.w : 0), (i32)(clip.h > 0 ? clip.h : 0));
+	} else if (*scissor) {
+		glDisable(GL_SCISSOR_TEST);
+		*scissor = RSGL_FALSE;
+	}
+
+	u32 mode = GL_TRIANGLES;
+	switch (batch->type) {
+		case RSGL_TRIANGLES: mode = GL_TRIANGLES; break;
+		case RSGL_POINTS: mode = GL_POINTS; break;
+		case RSGL_LINES:  mode = GL_LINES; break;
+		default: break;
+	}
+
+	glPushMatrix();
+	glMultMatrixf(batch->matrix.m);
+
+#ifdef RSGL_GL1_DISPLAY_LIST_CACHE
+	if (RSGL_GL1_callDisplayList(ctx, pass, batch, mode) == RSGL_FALSE)
+#else
+	RSGL_UNUSED(ctx);
+#endif
+	glDrawElements(mode, (GLsizei)batch->elmCount, GL_UNSIGNED_SHORT, &elements[batch->elmStart]);
+
+	glPopMatrix();
+}
+
+void RSGL_GL1_render(RSGL_gl1Renderer* ctx, const RSGL_renderPass* pass) {
+	size_t i;
+
 	glPushMatrix();
 	glLoadIdentity();
 	glMultMatrixf(pass->matrix);
 	glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	for (i = 0; i < pass->buffers->batchCount; i++) {
-		glEnable(GL_TEXTURE_2D);
-		glBindTexture(GL_TEXTURE_2D, pass->buffers->batches[i].tex);
-		glLineWidth(pass->buffers->batches[i].lineWidth);
-
-		u32 mode = GL_TRIANGLES;
-		switch (pass->buffers->batches[i].type) {
-			case RSGL_TRIANGLES: mode = GL_TRIANGLES; break;
-			case RSGL_POINTS: mode = GL_POINTS; break;
-			case RSGL_LINES:  mode = GL_LINES; break;
-			default: break;
+	glEnable(GL_TEXTURE_2D);
+
+	/* client side arrays are GL 1.1, each batch is one glDrawElements instead of three calls per vertex */
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glVertexPointer(3, GL_FLOAT, 0, (float*)pass->buffers->vertex);
+	glColorPointer(4, GL_FLOAT, 0, (float*)pass->buffers->color);
+	glTexCoordPointer(2, GL_FLOAT, 0, (float*)pass->buffers->texture);
+
+#ifdef RSGL_GL1_DISPLAY_LIST_CACHE
+	ctx->passCount += 1;
+#endif
+
+	RSGL_bool scissor = RSGL_FALSE;
+	if (pass->depthSort) {
+		/* opaque batches front to back without blending, the depth test drops whatever a later draw covers */
+		glEnable(GL_DEPTH_TEST);
+		glDepthFunc(GL_LEQUAL);
+		glDisable(GL_BLEND);
+		for (i = pass->buffers->batchCount; i-- > 0;) {
+			if (pass->buffers->batches[i].opaque)
+				RSGL_GL1_drawBatch(ctx, pass, &pass->buffers->batches[i], &scissor);
 		}
 
-		glPushMatrix();
-		glMultMatrixf(pass->buffers->batches[i].matrix.m);
-		glBegin(mode);
-
-		for (j = pass->buffers->batches[i].elmStart; j < pass->buffers->batches[i].elmStart + pass->buffers->batches[i].elmCount; j++) {
-			size_t vIndex = elements[j] * 3;
-			size_t tIndex = elements[j] * 2;
-			size_t cIndex = elements[j] * 4;
-			glTexCoord2f(texCoords[tIndex], texCoords[tIndex + 1]);
-			glColor4f(colors[cIndex], colors[cIndex + 1], colors[cIndex + 2], colors[cIndex + 3]);
-			glVertex3f(verts[vIndex], verts[vIndex + 1],  verts[vIndex + 2]);
+		/* the rest in order on top, hidden where a later opaque draw covers them */
+		glEnable(GL_BLEND);
+		glDepthMask(GL_FALSE);
+		for (i = 0; i < pass->buffers->batchCount; i++) {
+			if (pass->buffers->batches[i].opaque == RSGL_FALSE)
+				RSGL_GL1_drawBatch(ctx, pass, &pass->buffers->batches[i], &scissor);
 		}
 
-		glEnd();
-		glPopMatrix();
+		glDepthMask(GL_TRUE);
+		glDisable(GL_DEPTH_TEST);
+	} else {
+		for (i = 0; i < pass->buffers->batchCount; i++)
+			RSGL_GL1_drawBatch(ctx, pass, &pass->buffers->batches[i], &scissor);
 	}
 
+	if (scissor)
+		glDisable(GL_SCISSOR_TEST);
+
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+
 	glPopMatrix();
 }
 
@@ -181,6 +326,33 @@ void RSGL_GL1_scissorEnd(RSGL_gl1Renderer* ctx) {
     glDisable(GL_SCISSOR_TEST);
 }
 
+void RSGL_GL1_readPixels(RSGL_gl1Renderer* ctx, i32 x, i32 y, i32 w, i32 h, float renderer_height, u8* data) {
+	RSGL_UNUSED(ctx);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(x, (i32)renderer_height - (y + h), w, h, GL_RGBA, GL_UNSIGNED_BYTE, data);
+	RSGL_flipRows(data, (size_t)w * 4, (size_t)h);
+}
+
+void RSGL_GL1_requestPixels(RSGL_gl1Renderer* ctx, i32 x, i32 y, i32 w, i32 h, float renderer_height) {
+	ctx->readbackSize = (size_t)w * (size_t)h * 4;
+	if (ctx->readbackSize > ctx->readbackCap) {
+		ctx->readback = (u8*)RSGL_REALLOC(ctx->readback, ctx->readbackSize);
+		ctx->readbackCap = ctx->readbackSize;
+	}
+
+	RSGL_GL1_readPixels(ctx, x, y, w, h, renderer_height, ctx->readback);
+	ctx->readbackPending = RSGL_TRUE;
+}
+
+RSGL_bool RSGL_GL1_fetchPixels(RSGL_gl1Renderer* ctx, u8* data, RSGL_bool wait) {
+	RSGL_UNUSED(wait);
+	if (ctx->readbackPending == RSGL_FALSE) return RSGL_FALSE;
+
+	RSGL_MEMCPY(data, ctx->readback, ctx->readbackSize);
+	ctx->readbackPending = RSGL_FALSE;
+	return RSGL_TRUE;
+}
+
 GLuint RSGL_GL1_textureFormatToNative(RSGL_textureFormat format) {
 	switch (format) {
 		case RSGL_formatRGB: return GL_RGB;
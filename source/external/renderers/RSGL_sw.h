@@ -0,0 +1,1025 @@
+#ifndef RSGL_H
+#include "RSGL.h"
+#endif
+
+/*
+	software (CPU) renderer backend for RSGL
+
+	define args
+	#define RSGL_SW_TILE_SIZE [pixels] - size of the screen tiles triangles are binned into (default 64)
+	#define RSGL_SW_MAX_THREADS [number of threads] - max number of rasterizer threads (default 16)
+	#define RSGL_SW_NO_THREADS - rasterize on the calling thread only
+	#define RSGL_SW_BGRA_TO_RGBA(dst, src, count) - swizzle count BGRA pixels to RGBA (used for pixel readback)
+
+	the renderer draws into a RSGL_swSurface set with RSGL_renderer_setSurface,
+	the surface uses 32-bit BGRA pixels (0xAARRGGBB), which is the native format of X11, winapi and most CPU framebuffers
+*/
+
+#ifndef RSGL_SW_H
+#define RSGL_SW_H
+
+#ifndef RSGL_SW_TILE_SIZE
+#define RSGL_SW_TILE_SIZE 64
+#endif
+
+#ifndef RSGL_SW_MAX_THREADS
+#define RSGL_SW_MAX_THREADS 16
+#endif
+
+typedef struct RSGL_swSurface {
+	u32* pixels; /* BGRA (0xAARRGGBB) pixels */
+	i32 width, height;
+	i32 stride; /* pixels per row */
+} RSGL_swSurface;
+
+typedef struct RSGL_swTexture {
+	u32* pixels; /* same layout as the surface */
+	i32 width, height;
+} RSGL_swTexture;
+
+/* triangle after setup, everything is in screen space */
+typedef struct RSGL_swTriangle {
+	float edges[3][3]; /* A, B, C of each edge function, positive inside */
+	float invA[3]; /* 1 / A, used to solve for the span bounds of each row */
+	float planes[7][3]; /* u/w, v/w, r/w, g/w, b/w, a/w, 1/w as a*x + b*y + c */
+	i32 minX, minY, maxX, maxY; /* bounding box, max is exclusive */
+	const RSGL_swTexture* texture; /* NULL when untextured */
+	u32 color; /* constant color for flat triangles */
+	u8 flat; /* constant color and untextured */
+	u8 affine; /* w is the same for all vertices, no perspective divide needed */
+} RSGL_swTriangle;
+
+typedef struct RSGL_swTile {
+	u32* triangles; /* indices into the triangle list, in submission order */
+	size_t count, cap;
+} RSGL_swTile;
+
+typedef struct RSGL_swRenderer {
+	RSGL_swSurface surface;
+	i32 viewport[4];
+	RSGL_bool scissor;
+	i32 scissorRect[4];
+
+	RSGL_swTriangle* triangles;
+	size_t triangleCount, triangleCap;
+
+	RSGL_swTile* tiles;
+	size_t tilesX, tilesY, tileCap;
+
+	volatile long nextTile; /* next tile to be picked up by a rasterizer thread */
+	void* workers; /* thread pool, created on demand */
+
+	u8* readback; /* pixels copied by RSGL_SW_requestPixels */
+	size_t readbackSize, readbackCap;
+	RSGL_bool readbackPending;
+} RSGL_swRenderer;
+
+RSGLDEF RSGL_rendererProc RSGL_SW_rendererProc(void);
+RSGLDEF size_t RSGL_SW_size(void);
+
+RSGLDEF RSGL_renderer* RSGL_SW_renderer_init(void);
+RSGLDEF void RSGL_SW_renderer_initPtr(RSGL_swRenderer* ptr, RSGL_renderer* renderer);
+
+RSGLDEF void RSGL_SW_render(RSGL_swRenderer* ctx, const RSGL_renderPass* pass);
+RSGLDEF void RSGL_SW_initPtr(RSGL_swRenderer* ctx, void* proc); /* init render backend */
+RSGLDEF void RSGL_SW_freePtr(RSGL_swRenderer* ctx); /* free render backend */
+RSGLDEF void RSGL_SW_setSurface(RSGL_swRenderer* ctx, RSGL_swSurface* surface);
+RSGLDEF void RSGL_SW_clear(RSGL_swRenderer* ctx, RSGL_framebuffer framebuffer, float r, float g, float b, float a);
+RSGLDEF void RSGL_SW_viewport(RSGL_swRenderer* ctx, i32 x, i32 y, i32 w, i32 h);
+RSGLDEF void RSGL_SW_createBuffer(RSGL_swRenderer* ctx, RSGL_bufferType type, size_t size, const void* data, size_t* buffer);
+RSGLDEF void RSGL_SW_updateBuffer(RSGL_swRenderer* ctx, RSGL_bufferType type, size_t buffer, const void* data, size_t start, size_t end);
+RSGLDEF void RSGL_SW_deleteBuffer(RSGL_swRenderer* ctx, size_t buffer);
+/* create a texture based on a given bitmap, this must be freed later using RSGL_deleteTexture */
+RSGLDEF RSGL_texture RSGL_SW_createTexture(RSGL_swRenderer* ctx, const RSGL_textureBlob* blob);
+RSGLDEF void RSGL_SW_copyToTexture(RSGL_swRenderer* ctx, RSGL_texture texture, size_t x, size_t y, const RSGL_textureBlob* blob);
+/* delete a texture */
+RSGLDEF void RSGL_SW_deleteTexture(RSGL_swRenderer* ctx, RSGL_texture tex);
+/* starts scissoring */
+RSGLDEF void RSGL_SW_scissorStart(RSGL_swRenderer* ctx, float x, float y, float w, float h, float renderer_height);
+/* stops scissoring */
+RSGLDEF void RSGL_SW_scissorEnd(RSGL_swRenderer* ctx);
+/* pixel readback, the surface is CPU memory so requests are copied right away */
+RSGLDEF void RSGL_SW_readPixels(RSGL_swRenderer* ctx, i32 x, i32 y, i32 w, i32 h, float renderer_height, u8* data);
+RSGLDEF void RSGL_SW_requestPixels(RSGL_swRenderer* ctx, i32 x, i32 y, i32 w, i32 h, float renderer_height);
+RSGLDEF RSGL_bool RSGL_SW_fetchPixels(RSGL_swRenderer* ctx, u8* data, RSGL_bool wait);
+#endif
+
+#ifdef RSGL_IMPLEMENTATION
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define RSGL_SW_SSE2
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#define RSGL_SW_NEON
+	#include <arm_neon.h>
+#endif
+
+#ifndef RSGL_SW_NO_THREADS
+	#if defined(_WIN32)
+		#ifndef WIN32_LEAN_AND_MEAN
+			#define WIN32_LEAN_AND_MEAN
+		#endif
+		#include <windows.h>
+		#define RSGL_SW_ATOMIC_INC(x) (InterlockedIncrement(x) - 1)
+	#else
+		#include <pthread.h>
+		#include <unistd.h>
+		#define RSGL_SW_ATOMIC_INC(x) __atomic_fetch_add(x, 1, __ATOMIC_RELAXED)
+	#endif
+#endif
+
+RSGL_renderer* RSGL_SW_renderer_init(void) { return RSGL_renderer_init(RSGL_SW_rendererProc(), NULL); }
+void RSGL_SW_renderer_initPtr(RSGL_swRenderer* ptr, RSGL_renderer* renderer) { return RSGL_renderer_initPtr(RSGL_SW_rendererProc(), NULL, ptr, renderer); }
+
+size_t RSGL_SW_size(void) {
+	return sizeof(RSGL_swRenderer);
+}
+
+RSGL_rendererProc RSGL_SW_rendererProc(void) {
+	RSGL_rendererProc proc;
+	RSGL_MEMSET(&proc, 0, sizeof(proc));
+
+	proc.render = (void (*)(void*, const RSGL_renderPass* pass))RSGL_SW_render;
+	proc.size = (size_t (*)(void))RSGL_SW_size;
+	proc.initPtr = (void (*)(void*, void*))RSGL_SW_initPtr;
+	proc.freePtr = (void (*)(void*))RSGL_SW_freePtr;
+	proc.setSurface = (void (*)(void*, void*))RSGL_SW_setSurface;
+	proc.clear = (void (*)(void*, RSGL_framebuffer, float, float, float, float))RSGL_SW_clear;
+	proc.viewport = (void (*)(void*, i32, i32, i32, i32))RSGL_SW_viewport;
+	proc.createTexture = (RSGL_texture (*)(void*, const RSGL_textureBlob*))RSGL_SW_createTexture;
+	proc.copyToTexture = (void (*)(void*, RSGL_texture, size_t, size_t, const RSGL_textureBlob* blob))RSGL_SW_copyToTexture;
+	proc.deleteTexture = (void (*)(void*, RSGL_texture))RSGL_SW_deleteTexture;
+	proc.scissorStart = (void (*)(void*, float, float, float, float, float))RSGL_SW_scissorStart;
+	proc.scissorEnd = (void (*)(void*))RSGL_SW_scissorEnd;
+	proc.createBuffer = (void (*)(void*, RSGL_bufferType, size_t, const void*, size_t*))RSGL_SW_createBuffer;
+	proc.updateBuffer = (void (*)(void*, RSGL_bufferType, size_t, void*, size_t, size_t))RSGL_SW_updateBuffer;
+	proc.deleteBuffer = (void (*)(void*, size_t))RSGL_SW_deleteBuffer;
+	proc.readPixels = (void (*)(void*, i32, i32, i32, i32, float, u8*))RSGL_SW_readPixels;
+	proc.requestPixels = (void (*)(void*, i32, i32, i32, i32, float))RSGL_SW_requestPixels;
+	proc.fetchPixels = (RSGL_bool (*)(void*, u8*, RSGL_bool))RSGL_SW_fetchPixels;
+	return proc;
+}
+
+/*
+****
+pixel helpers
+****
+*/
+
+#define RSGL_SW_PACK(r, g, b, a) (((u32)(a) << 24) | ((u32)(r) << 16) | ((u32)(g) << 8) | (u32)(b))
+#define RSGL_SW_DIV255(x) ((((x) + 128) + (((x) + 128) >> 8)) >> 8)
+
+/* GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA for every channel */
+static u32 RSGL_SW_blend(u32 src, u32 dst) {
+	u32 a = src >> 24;
+	if (a == 255) return src;
+	if (a == 0) return dst;
+
+	u32 inv = 255 - a;
+	u32 out = 0;
+	u32 shift;
+	for (shift = 0; shift < 32; shift += 8) {
+		u32 s = (src >> shift) & 0xFF;
+		u32 d = (dst >> shift) & 0xFF;
+		out |= RSGL_SW_DIV255(s * a + d * inv) << shift;
+	}
+
+	return out;
+}
+
+/* blends a constant color over a run of pixels */
+static void RSGL_SW_blendSpan(u32* dst, size_t count, u32 color) {
+	u32 a = color >> 24;
+	size_t i = 0;
+
+	if (a == 0) return;
+
+	if (a == 255) {
+		for (i = 0; i < count; i++) dst[i] = color;
+		return;
+	}
+
+#if defined(RSGL_SW_SSE2)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i round = _mm_set1_epi16(128);
+		const __m128i inv = _mm_set1_epi16((short)(255 - a));
+
+		/* src * a for two pixels, widened to u16 */
+		__m128i src = _mm_unpacklo_epi8(_mm_set1_epi32((int)color), zero);
+		src = _mm_mullo_epi16(src, _mm_set1_epi16((short)a));
+		src = _mm_add_epi16(src, round);
+
+		for (; i + 4 <= count; i += 4) {
+			__m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+			__m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inv), src);
+			__m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inv), src);
+			lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+			hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+			_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+		}
+	}
+#elif defined(RSGL_SW_NEON)
+	{
+		const uint8x8_t inv = vdup_n_u8((u8)(255 - a));
+		uint16x8_t src = vmull_u8(vreinterpret_u8_u32(vdup_n_u32(color)), vdup_n_u8((u8)a));
+
+		for (; i + 4 <= count; i += 4) {
+			uint8x16_t d = vreinterpretq_u8_u32(vld1q_u32(dst + i));
+			uint16x8_t lo = vmlal_u8(src, vget_low_u8(d), inv);
+			uint16x8_t hi = vmlal_u8(src, vget_high_u8(d), inv);
+			uint8x16_t out = vcombine_u8(vraddhn_u16(lo, vrshrq_n_u16(lo, 8)), vraddhn_u16(hi, vrshrq_n_u16(hi, 8)));
+			vst1q_u32(dst + i, vreinterpretq_u32_u8(out));
+		}
+	}
+#endif
+
+	for (; i < count; i++)
+		dst[i] = RSGL_SW_blend(color, dst[i]);
+}
+
+static u32 RSGL_SW_colorToPixel(float r, float g, float b, float a) {
+	#define RSGL_SW_CHANNEL(c) (u32)((c) <= 0.0f ? 0 : ((c) >= 1.0f ? 255 : (u32)((c) * 255.0f + 0.5f)))
+	return RSGL_SW_PACK(RSGL_SW_CHANNEL(r), RSGL_SW_CHANNEL(g), RSGL_SW_CHANNEL(b), RSGL_SW_CHANNEL(a));
+}
+
+#ifndef RSGL_SW_BGRA_TO_RGBA
+#define RSGL_SW_BGRA_TO_RGBA(dst, src, count) RSGL_SW_bgraToRGBA(dst, src, count)
+static void RSGL_SW_bgraToRGBA(u8* dst, const u8* src, size_t count) {
+	size_t i;
+	for (i = 0; i < count; i++) {
+		dst[i * 4 + 0] = src[i * 4 + 2];
+		dst[i * 4 + 1] = src[i * 4 + 1];
+		dst[i * 4 + 2] = src[i * 4 + 0];
+		dst[i * 4 + 3] = src[i * 4 + 3];
+	}
+}
+#endif
+
+/*
+****
+textures
+****
+*/
+
+static u32 RSGL_SW_texel(const RSGL_textureBlob* blob, size_t index) {
+	if (blob->dataType == RSGL_textureDataFloat) {
+		const float* f = (const float*)blob->data;
+		switch (blob->dataFormat) {
+			case RSGL_formatRGB: return RSGL_SW_colorToPixel(f[index * 3], f[index * 3 + 1], f[index * 3 + 2], 1.0f);
+			case RSGL_formatRGBA: return RSGL_SW_colorToPixel(f[index * 4], f[index * 4 + 1], f[index * 4 + 2], f[index * 4 + 3]);
+			default: return RSGL_SW_colorToPixel(f[index], f[index], f[index], 1.0f);
+		}
+	}
+
+	const u8* p = (const u8*)blob->data;
+	switch (blob->dataFormat) {
+		case RSGL_formatRGB: p += index * 3; return RSGL_SW_PACK(p[0], p[1], p[2], 255);
+		case RSGL_formatBGR: p += index * 3; return RSGL_SW_PACK(p[2], p[1], p[0], 255);
+		case RSGL_formatBGRA: p += index * 4; return RSGL_SW_PACK(p[2], p[1], p[0], p[3]);
+		case RSGL_formatRed: p += index; return RSGL_SW_PACK(p[0], 0, 0, 255);
+		case RSGL_formatGrayscale: p += index; return RSGL_SW_PACK(p[0], p[0], p[0], 255);
+		case RSGL_formatGrayscaleAlpha: p += index; return RSGL_SW_PACK(255, 255, 255, p[0]);
+		default: p += index * 4; return RSGL_SW_PACK(p[0], p[1], p[2], p[3]);
+	}
+}
+
+RSGL_texture RSGL_SW_createTexture(RSGL_swRenderer* ctx, const RSGL_textureBlob* blob) {
+	RSGL_swTexture* texture = (RSGL_swTexture*)RSGL_MALLOC(sizeof(RSGL_swTexture));
+	texture->width = (i32)blob->width;
+	texture->height = (i32)blob->height;
+	texture->pixels = (u32*)RSGL_MALLOC(blob->width * blob->height * sizeof(u32));
+	RSGL_MEMSET(texture->pixels, 0, blob->width * blob->height * sizeof(u32));
+
+	if (blob->data)
+		RSGL_SW_copyToTexture(ctx, (RSGL_texture)texture, 0, 0, blob);
+
+	return (RSGL_texture)texture;
+}
+
+void RSGL_SW_copyToTexture(RSGL_swRenderer* ctx, RSGL_texture texture, size_t x, size_t y, const RSGL_textureBlob* blob) {
+	RSGL_swTexture* tex = (RSGL_swTexture*)texture;
+	RSGL_UNUSED(ctx);
+
+	size_t ix, iy;
+	for (iy = 0; iy < blob->height && y + iy < (size_t)tex->height; iy++) {
+		u32* row = tex->pixels + (y + iy) * (size_t)tex->width + x;
+		for (ix = 0; ix < blob->width && x + ix < (size_t)tex->width; ix++)
+			row[ix] = RSGL_SW_texel(blob, iy * blob->width + ix);
+	}
+}
+
+void RSGL_SW_deleteTexture(RSGL_swRenderer* ctx, RSGL_texture tex) {
+	RSGL_swTexture* texture = (RSGL_swTexture*)tex;
+	RSGL_UNUSED(ctx);
+	if (texture == NULL) return;
+
+	RSGL_FREE(texture->pixels);
+	RSGL_FREE(texture);
+}
+
+/*
+****
+buffers (plain CPU memory, like the GL1 backend)
+****
+*/
+
+void RSGL_SW_createBuffer(RSGL_swRenderer* ctx, RSGL_bufferType type, size_t size, const void* data, size_t* buffer) {
+	void* rawBuffer = RSGL_MALLOC(size);
+
+	if (data)
+		RSGL_SW_updateBuffer(ctx, type, (size_t)rawBuffer, data, 0, size);
+
+	if (buffer) *buffer = (size_t)rawBuffer;
+}
+
+void RSGL_SW_updateBuffer(RSGL_swRenderer* ctx, RSGL_bufferType type, size_t buffer, const void* data, size_t start, size_t end) {
+	RSGL_UNUSED(ctx); RSGL_UNUSED(type);
+	RSGL_MEMCPY(&((u8*)buffer)[start], data, end - start);
+}
+
+void RSGL_SW_deleteBuffer(RSGL_swRenderer* ctx, size_t buffer) {
+	RSGL_UNUSED(ctx);
+	RSGL_FREE((void*)buffer);
+}
+
+/*
+****
+state
+****
+*/
+
+void RSGL_SW_setSurface(RSGL_swRenderer* ctx, RSGL_swSurface* surface) {
+	if (surface)
+		ctx->surface = *surface;
+	else
+		RSGL_MEMSET(&ctx->surface, 0, sizeof(ctx->surface));
+}
+
+void RSGL_SW_viewport(RSGL_swRenderer* ctx, i32 x, i32 y, i32 w, i32 h) {
+	ctx->viewport[0] = x;
+	ctx->viewport[1] = y;
+	ctx->viewport[2] = w;
+	ctx->viewport[3] = h;
+}
+
+void RSGL_SW_scissorStart(RSGL_swRenderer* ctx, float x, float y, float w, float h, float renderer_height) {
+	RSGL_UNUSED(renderer_height); /* the surface already has a top-left origin */
+	ctx->scissor = RSGL_TRUE;
+	ctx->scissorRect[0] = (i32)x;
+	ctx->scissorRect[1] = (i32)y;
+	ctx->scissorRect[2] = (i32)(x + w);
+	ctx->scissorRect[3] = (i32)(y + h);
+}
+
+void RSGL_SW_scissorEnd(RSGL_swRenderer* ctx) {
+	ctx->scissor = RSGL_FALSE;
+}
+
+void RSGL_SW_clear(RSGL_swRenderer* ctx, RSGL_framebuffer framebuffer, float r, float g, float b, float a) {
+	RSGL_UNUSED(framebuffer);
+	if (ctx->surface.pixels == NULL) return;
+
+	u32 color = RSGL_SW_colorToPixel(r, g, b, a);
+
+	i32 x, y;
+	for (y = 0; y < ctx->surface.height; y++) {
+		u32* row = ctx->surface.pixels + (size_t)y * (size_t)ctx->surface.stride;
+		for (x = 0; x < ctx->surface.width; x++)
+			row[x] = color;
+	}
+}
+
+/*
+****
+pixel readback
+****
+*/
+
+void RSGL_SW_readPixels(RSGL_swRenderer* ctx, i32 x, i32 y, i32 w, i32 h, float renderer_height, u8* data) {
+	RSGL_UNUSED(renderer_height); /* the surface already has a top-left origin */
+
+	i32 row;
+	for (row = 0; row < h; row++) {
+		u8* dst = data + (size_t)row * (size_t)w * 4;
+		i32 sy = y + row;
+		i32 start = (x < 0) ? -x : 0;
+		i32 end = (x + w > ctx->surface.width) ? ctx->surface.width - x : w;
+
+		/* anything outside of the surface reads as transparent black */
+		if (ctx->surface.pixels == NULL || sy < 0 || sy >= ctx->surface.height || start >= end) {
+			RSGL_MEMSET(dst, 0, (size_t)w * 4);
+			continue;
+		}
+
+		if (start > 0) RSGL_MEMSET(dst, 0, (size_t)start * 4);
+		if (end < w) RSGL_MEMSET(dst + (size_t)end * 4, 0, (size_t)(w - end) * 4);
+
+		const u32* src = ctx->surface.pixels + (size_t)sy * (size_t)ctx->surface.stride + x + start;
+		RSGL_SW_BGRA_TO_RGBA(dst + (size_t)start * 4, (const u8*)src, (size_t)(end - start));
+	}
+}
+
+void RSGL_SW_requestPixels(RSGL_swRenderer* ctx, i32 x, i32 y, i32 w, i32 h, float renderer_height) {
+	ctx->readbackSize = (size_t)w * (size_t)h * 4;
+	if (ctx->readbackSize > ctx->readbackCap) {
+		ctx->readback = (u8*)RSGL_REALLOC(ctx->readback, ctx->readbackSize);
+		ctx->readbackCap = ctx->readbackSize;
+	}
+
+	RSGL_SW_readPixels(ctx, x, y, w, h, renderer_height, ctx->readback);
+	ctx->readbackPending = RSGL_TRUE;
+}
+
+RSGL_bool RSGL_SW_fetchPixels(RSGL_swRenderer* ctx, u8* data, RSGL_bool wait) {
+	RSGL_UNUSED(wait);
+	if (ctx->readbackPending == RSGL_FALSE) return RSGL_FALSE;
+
+	RSGL_MEMCPY(data, ctx->readback, ctx->readbackSize);
+	ctx->readbackPending = RSGL_FALSE;
+	return RSGL_TRUE;
+}
+
+/*
+****
+triangle setup and binning
+****
+*/
+
+/* vertex in screen space, attributes are already divided by w */
+typedef struct RSGL_swVertex {
+	float x, y, invW;
+	float attr[6]; /* u, v, r, g, b, a */
+} RSGL_swVertex;
+
+static void RSGL_SW_pushTriangle(RSGL_swRenderer* ctx, const RSGL_swVertex* v0, const RSGL_swVertex* v1, const RSGL_swVertex* v2,
+								const RSGL_swTexture* texture, const i32 clip[4]) {
+	const RSGL_swVertex* v[3] = { v0, v1, v2 };
+
+	/* edge i is opposite vertex i */
+	float edges[3][3];
+	size_t i, j;
+	for (i = 0; i < 3; i++) {
+		const RSGL_swVertex* a = v[(i + 1) % 3];
+		const RSGL_swVertex* b = v[(i + 2) % 3];
+		edges[i][0] = a->y - b->y;
+		edges[i][1] = b->x - a->x;
+		edges[i][2] = a->x * b->y - a->y * b->x;
+	}
+
+	float area = edges[0][2] + edges[1][2] + edges[2][2];
+	if (area == 0.0f) return;
+
+	if (area < 0.0f) {
+		for (i = 0; i < 3; i++) {
+			edges[i][0] = -edges[i][0];
+			edges[i][1] = -edges[i][1];
+			edges[i][2] = -edges[i][2];
+		}
+		area = -area;
+	}
+
+	float minXf = v0->x, maxXf = v0->x, minYf = v0->y, maxYf = v0->y;
+	for (i = 1; i < 3; i++) {
+		if (v[i]->x < minXf) minXf = v[i]->x;
+		if (v[i]->x > maxXf) maxXf = v[i]->x;
+		if (v[i]->y < minYf) minYf = v[i]->y;
+		if (v[i]->y > maxYf) maxYf = v[i]->y;
+	}
+
+	i32 minX = (minXf < (float)clip[0]) ? clip[0] : (i32)minXf;
+	i32 minY = (minYf < (float)clip[1]) ? clip[1] : (i32)minYf;
+	i32 maxX = (maxXf + 1.0f > (float)clip[2]) ? clip[2] : (i32)maxXf + 1;
+	i32 maxY = (maxYf + 1.0f > (float)clip[3]) ? clip[3] : (i32)maxYf + 1;
+	if (minX >= maxX || minY >= maxY) return;
+
+	if (ctx->triangleCount >= ctx->triangleCap) {
+		ctx->triangleCap = ctx->triangleCap ? ctx->triangleCap * 2 : 1024;
+		ctx->triangles = (RSGL_swTriangle*)RSGL_REALLOC(ctx->triangles, ctx->triangleCap * sizeof(RSGL_swTriangle));
+	}
+
+	RSGL_swTriangle* tri = &ctx->triangles[ctx->triangleCount];
+	RSGL_MEMCPY(tri->edges, edges, sizeof(edges));
+	for (i = 0; i < 3; i++)
+		tri->invA[i] = (edges[i][0] != 0.0f) ? (1.0f / edges[i][0]) : 0.0f;
+	tri->minX = minX; tri->minY = minY;
+	tri->maxX = maxX; tri->maxY = maxY;
+
+	/* a 1x1 opaque white texture is the renderer's default texture, treat it as untextured */
+	tri->texture = texture;
+	if (texture && texture->width == 1 && texture->height == 1 && texture->pixels[0] == 0xFFFFFFFF)
+		tri->texture = NULL;
+
+	tri->affine = (v0->invW == v1->invW && v0->invW == v2->invW);
+
+	tri->flat = (tri->texture == NULL);
+	for (j = 2; j < 6 && tri->flat; j++)
+		tri->flat = (v0->attr[j] == v1->attr[j] && v0->attr[j] == v2->attr[j]);
+
+	if (tri->flat) {
+		float w = 1.0f / v0->invW;
+		tri->color = RSGL_SW_colorToPixel(v0->attr[2] * w, v0->attr[3] * w, v0->attr[4] * w, v0->attr[5] * w);
+		if ((tri->color >> 24) == 0) return;
+	}
+
+	/* attribute planes, f(x, y) = sum(f_i * edge_i(x, y)) / area */
+	for (j = 0; j < 7; j++) {
+		float f[3];
+		for (i = 0; i < 3; i++)
+			f[i] = (j < 6) ? v[i]->attr[j] : v[i]->invW;
+
+		tri->planes[j][0] = (f[0] * edges[0][0] + f[1] * edges[1][0] + f[2] * edges[2][0]) / area;
+		tri->planes[j][1] = (f[0] * edges[0][1] + f[1] * edges[1][1] + f[2] * edges[2][1]) / area;
+		tri->planes[j][2] = (f[0] * edges[0][2] + f[1] * edges[1][2] + f[2] * edges[2][2]) / area;
+	}
+
+	/* bin into every tile the bounding box touches */
+	size_t tx, ty;
+	size_t tileMinX = (size_t)minX / RSGL_SW_TILE_SIZE, tileMaxX = (size_t)(maxX - 1) / RSGL_SW_TILE_SIZE;
+	size_t tileMinY = (size_t)minY / RSGL_SW_TILE_SIZE, tileMaxY = (size_t)(maxY - 1) / RSGL_SW_TILE_SIZE;
+	for (ty = tileMinY; ty <= tileMaxY; ty++) {
+		for (tx = tileMinX; tx <= tileMaxX; tx++) {
+			RSGL_swTile* tile = &ctx->tiles[ty * ctx->tilesX + tx];
+			if (tile->count >= tile->cap) {
+				tile->cap = tile->cap ? tile->cap * 2 : 64;
+				tile->triangles = (u32*)RSGL_REALLOC(tile->triangles, tile->cap * sizeof(u32));
+			}
+			tile->triangles[tile->count++] = (u32)ctx->triangleCount;
+		}
+	}
+
+	ctx->triangleCount++;
+}
+
+/* expands a screen space line into a quad */
+static void RSGL_SW_pushLine(RSGL_swRenderer* ctx, const RSGL_swVertex* v0, const RSGL_swVertex* v1, float width,
+								const RSGL_swTexture* texture, const i32 clip[4]) {
+	float dx = v1->x - v0->x;
+	float dy = v1->y - v0->y;
+	float len = sqrtf(dx * dx + dy * dy);
+	if (len == 0.0f) return;
+
+	float half = ((width < 1.0f) ? 1.0f : width) * 0.5f;
+	float nx = -dy / len * half;
+	float ny = dx / len * half;
+
+	RSGL_swVertex q[4] = { *v0, *v0, *v1, *v1 };
+	q[0].x += nx; q[0].y += ny;
+	q[1].x -= nx; q[1].y -= ny;
+	q[2].x += nx; q[2].y += ny;
+	q[3].x -= nx; q[3].y -= ny;
+
+	RSGL_SW_pushTriangle(ctx, &q[0], &q[1], &q[2], texture, clip);
+	RSGL_SW_pushTriangle(ctx, &q[3], &q[2], &q[1], texture, clip);
+}
+
+static void RSGL_SW_pushPoint(RSGL_swRenderer* ctx, const RSGL_swVertex* v0, float size,
+								const RSGL_swTexture* texture, const i32 clip[4]) {
+	float half = ((size < 1.0f) ? 1.0f : size) * 0.5f;
+
+	RSGL_swVertex q[4] = { *v0, *v0, *v0, *v0 };
+	q[0].x -= half; q[0].y -= half;
+	q[1].x -= half; q[1].y += half;
+	q[2].x += half; q[2].y -= half;
+	q[3].x += half; q[3].y += half;
+
+	RSGL_SW_pushTriangle(ctx, &q[0], &q[1], &q[2], texture, clip);
+	RSGL_SW_pushTriangle(ctx, &q[3], &q[2], &q[1], texture, clip);
+}
+
+/*
+****
+rasterization
+****
+*/
+
+/* ceil for values that are known to fit in an i32 */
+static i32 RSGL_SW_ceil(float x) {
+	i32 i = (i32)x;
+	return (i32)((float)i < x) + i;
+}
+
+static void RSGL_SW_rasterTriangle(RSGL_swRenderer* ctx, const RSGL_swTriangle* tri, i32 x0, i32 y0, i32 x1, i32 y1) {
+	if (tri->minX > x0) x0 = tri->minX;
+	if (tri->minY > y0) y0 = tri->minY;
+	if (tri->maxX < x1) x1 = tri->maxX;
+	if (tri->maxY < y1) y1 = tri->maxY;
+
+	i32 y;
+	for (y = y0; y < y1; y++) {
+		float yc = (float)y + 0.5f;
+
+		/* find the span of the row that is inside all three edges */
+		i32 lo = x0, hi = x1;
+		size_t i;
+		for (i = 0; i < 3 && lo < hi; i++) {
+			float A = tri->edges[i][0];
+			float K = tri->edges[i][1] * yc + tri->edges[i][2];
+
+			if (A == 0.0f) {
+				/* horizontal edge, pixels exactly on it go to the triangle where B > 0 */
+				if (K < 0.0f || (K == 0.0f && tri->edges[i][1] <= 0.0f))
+					hi = lo;
+				continue;
+			}
+
+			/* both triangles sharing an edge compute the same bound, so each pixel is drawn exactly once */
+			float bound = -K * tri->invA[i] - 0.5f;
+			if (A > 0.0f) {
+				if (bound > (float)lo) lo = (bound >= (float)hi) ? hi : RSGL_SW_ceil(bound);
+			} else {
+				if (bound < (float)hi) hi = (bound <= (float)lo) ? lo : RSGL_SW_ceil(bound);
+			}
+		}
+
+		if (lo >= hi) continue;
+
+		u32* row = ctx->surface.pixels + (size_t)y * (size_t)ctx->surface.stride;
+
+		if (tri->flat) {
+			RSGL_SW_blendSpan(row + lo, (size_t)(hi - lo), tri->color);
+			continue;
+		}
+
+		/* interpolate the attribute planes across the span */
+		float xc = (float)lo + 0.5f;
+		float attr[7], step[7];
+		for (i = 0; i < 7; i++) {
+			attr[i] = tri->planes[i][0] * xc + tri->planes[i][1] * yc + tri->planes[i][2];
+			step[i] = tri->planes[i][0];
+		}
+
+		const RSGL_swTexture* tex = tri->texture;
+		float affineW = 1.0f / tri->planes[6][2]; /* 1/w is constant when every vertex shares the same w */
+		i32 x;
+		for (x = lo; x < hi; x++) {
+			float w = tri->affine ? affineW : (1.0f / attr[6]);
+
+			u32 r = RSGL_SW_CHANNEL(attr[2] * w);
+			u32 g = RSGL_SW_CHANNEL(attr[3] * w);
+			u32 b = RSGL_SW_CHANNEL(attr[4] * w);
+			u32 a = RSGL_SW_CHANNEL(attr[5] * w);
+
+			if (tex) {
+				/* nearest sampling with GL_REPEAT wrapping */
+				i32 tx = (i32)floorf(attr[0] * w * (float)tex->width);
+				i32 ty = (i32)floorf(attr[1] * w * (float)tex->height);
+				if (tx < 0 || tx >= tex->width) { tx %= tex->width; if (tx < 0) tx += tex->width; }
+				if (ty < 0 || ty >= tex->height) { ty %= tex->height; if (ty < 0) ty += tex->height; }
+
+				u32 texel = tex->pixels[(size_t)ty * (size_t)tex->width + (size_t)tx];
+				r = RSGL_SW_DIV255(((texel >> 16) & 0xFF) * r);
+				g = RSGL_SW_DIV255(((texel >> 8) & 0xFF) * g);
+				b = RSGL_SW_DIV255((texel & 0xFF) * b);
+				a = RSGL_SW_DIV255((texel >> 24) * a);
+			}
+
+			row[x] = RSGL_SW_blend(RSGL_SW_PACK(r, g, b, a), row[x]);
+
+			for (i = 0; i < 7; i++)
+				attr[i] += step[i];
+		}
+	}
+}
+
+static void RSGL_SW_rasterTile(RSGL_swRenderer* ctx, size_t index) {
+	const RSGL_swTile* tile = &ctx->tiles[index];
+	if (tile->count == 0) return;
+
+	i32 x0 = (i32)(index % ctx->tilesX) * RSGL_SW_TILE_SIZE;
+	i32 y0 = (i32)(index / ctx->tilesX) * RSGL_SW_TILE_SIZE;
+	i32 x1 = x0 + RSGL_SW_TILE_SIZE;
+	i32 y1 = y0 + RSGL_SW_TILE_SIZE;
+	if (x1 > ctx->surface.width) x1 = ctx->surface.width;
+	if (y1 > ctx->surface.height) y1 = ctx->surface.height;
+
+	/* a tile is only ever touched by one thread, so triangles are drawn in submission order */
+	size_t i;
+	for (i = 0; i < tile->count; i++)
+		RSGL_SW_rasterTriangle(ctx, &ctx->triangles[tile->triangles[i]], x0, y0, x1, y1);
+}
+
+static void RSGL_SW_rasterTiles(RSGL_swRenderer* ctx) {
+	size_t count = ctx->tilesX * ctx->tilesY;
+
+	for (;;) {
+#ifndef RSGL_SW_NO_THREADS
+		size_t index = (size_t)RSGL_SW_ATOMIC_INC(&ctx->nextTile);
+#else
+		size_t index = (size_t)ctx->nextTile++;
+#endif
+		if (index >= count) break;
+		RSGL_SW_rasterTile(ctx, index);
+	}
+}
+
+/*
+****
+thread pool
+****
+*/
+
+#ifndef RSGL_SW_NO_THREADS
+
+typedef struct RSGL_swWorkers {
+	RSGL_swRenderer* ctx;
+	size_t count;
+	u32 generation; /* bumped every time a frame is handed to the workers */
+	size_t busy;
+	RSGL_bool quit;
+#if defined(_WIN32)
+	HANDLE threads[RSGL_SW_MAX_THREADS];
+	CRITICAL_SECTION lock;
+	CONDITION_VARIABLE start, done;
+#else
+	pthread_t threads[RSGL_SW_MAX_THREADS];
+	pthread_mutex_t lock;
+	pthread_cond_t start, done;
+#endif
+} RSGL_swWorkers;
+
+#if defined(_WIN32)
+	#define RSGL_SW_LOCK(w) EnterCriticalSection(&(w)->lock)
+	#define RSGL_SW_UNLOCK(w) LeaveCriticalSection(&(w)->lock)
+	#define RSGL_SW_WAIT(w, cond) SleepConditionVariableCS(&(w)->cond, &(w)->lock, INFINITE)
+	#define RSGL_SW_SIGNAL(w, cond) WakeConditionVariable(&(w)->cond)
+	#define RSGL_SW_BROADCAST(w, cond) WakeAllConditionVariable(&(w)->cond)
+#else
+	#define RSGL_SW_LOCK(w) pthread_mutex_lock(&(w)->lock)
+	#define RSGL_SW_UNLOCK(w) pthread_mutex_unlock(&(w)->lock)
+	#define RSGL_SW_WAIT(w, cond) pthread_cond_wait(&(w)->cond, &(w)->lock)
+	#define RSGL_SW_SIGNAL(w, cond) pthread_cond_signal(&(w)->cond)
+	#define RSGL_SW_BROADCAST(w, cond) pthread_cond_broadcast(&(w)->cond)
+#endif
+
+#if defined(_WIN32)
+static DWORD WINAPI RSGL_SW_workerProc(LPVOID arg) {
+#else
+static void* RSGL_SW_workerProc(void* arg) {
+#endif
+	RSGL_swWorkers* workers = (RSGL_swWorkers*)arg;
+	u32 generation = 0;
+
+	for (;;) {
+		RSGL_SW_LOCK(workers);
+		while (workers->generation == generation && workers->quit == RSGL_FALSE)
+			RSGL_SW_WAIT(workers, start);
+
+		if (workers->quit) {
+			RSGL_SW_UNLOCK(workers);
+			break;
+		}
+
+		generation = workers->generation;
+		RSGL_SW_UNLOCK(workers);
+
+		RSGL_SW_rasterTiles(workers->ctx);
+
+		RSGL_SW_LOCK(workers);
+		workers->busy--;
+		if (workers->busy == 0)
+			RSGL_SW_SIGNAL(workers, done);
+		RSGL_SW_UNLOCK(workers);
+	}
+
+	return 0;
+}
+
+static size_t RSGL_SW_cpuCount(void) {
+#if defined(_WIN32)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (size_t)info.dwNumberOfProcessors;
+#else
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return (count > 0) ? (size_t)count : 1;
+#endif
+}
+
+static RSGL_swWorkers* RSGL_SW_createWorkers(RSGL_swRenderer* ctx) {
+	/* the calling thread rasterizes too */
+	size_t count = RSGL_SW_cpuCount() - 1;
+	if (count > RSGL_SW_MAX_THREADS) count = RSGL_SW_MAX_THREADS;
+	if (count == 0) return NULL;
+
+	RSGL_swWorkers* workers = (RSGL_swWorkers*)RSGL_MALLOC(sizeof(RSGL_swWorkers));
+	RSGL_MEMSET(workers, 0, sizeof(RSGL_swWorkers));
+	workers->ctx = ctx;
+
+#if defined(_WIN32)
+	InitializeCriticalSection(&workers->lock);
+	InitializeConditionVariable(&workers->start);
+	InitializeConditionVariable(&workers->done);
+#else
+	pthread_mutex_init(&workers->lock, NULL);
+	pthread_cond_init(&workers->start, NULL);
+	pthread_cond_init(&workers->done, NULL);
+#endif
+
+	for (workers->count = 0; workers->count < count; workers->count++) {
+#if defined(_WIN32)
+		workers->threads[workers->count] = CreateThread(NULL, 0, RSGL_SW_workerProc, workers, 0, NULL);
+		if (workers->threads[workers->count] == NULL) break;
+#else
+		if (pthread_create(&workers->threads[workers->count], NULL, RSGL_SW_workerProc, workers) != 0) break;
+#endif
+	}
+
+	return workers;
+}
+
+static void RSGL_SW_freeWorkers(RSGL_swWorkers* workers) {
+	RSGL_SW_LOCK(workers);
+	workers->quit = RSGL_TRUE;
+	RSGL_SW_BROADCAST(workers, start);
+	RSGL_SW_UNLOCK(workers);
+
+	size_t i;
+	for (i = 0; i < workers->count; i++) {
+#if defined(_WIN32)
+		WaitForSingleObject(workers->threads[i], INFINITE);
+		CloseHandle(workers->threads[i]);
+#else
+		pthread_join(workers->threads[i], NULL);
+#endif
+	}
+
+#if defined(_WIN32)
+	DeleteCriticalSection(&workers->lock);
+#else
+	pthread_mutex_destroy(&workers->lock);
+	pthread_cond_destroy(&workers->start);
+	pthread_cond_destroy(&workers->done);
+#endif
+
+	RSGL_FREE(workers);
+}
+
+#endif /* RSGL_SW_NO_THREADS */
+
+void RSGL_SW_initPtr(RSGL_swRenderer* ctx, void* proc) {
+	RSGL_UNUSED(proc);
+	RSGL_MEMSET(ctx, 0, sizeof(RSGL_swRenderer));
+}
+
+void RSGL_SW_freePtr(RSGL_swRenderer* ctx) {
+#ifndef RSGL_SW_NO_THREADS
+	if (ctx->workers)
+		RSGL_SW_freeWorkers((RSGL_swWorkers*)ctx->workers);
+#endif
+
+	size_t i;
+	for (i = 0; i < ctx->tileCap; i++)
+		RSGL_FREE(ctx->tiles[i].triangles);
+
+	if (ctx->tiles) RSGL_FREE(ctx->tiles);
+	if (ctx->triangles) RSGL_FREE(ctx->triangles);
+	if (ctx->readback) RSGL_FREE(ctx->readback);
+}
+
+void RSGL_SW_render(RSGL_swRenderer* ctx, const RSGL_renderPass* pass) {
+	if (ctx->surface.pixels == NULL || pass->buffers->batchCount == 0)
+		return;
+
+	/* (re)size the tile grid to the surface */
+	ctx->tilesX = ((size_t)ctx->surface.width + RSGL_SW_TILE_SIZE - 1) / RSGL_SW_TILE_SIZE;
+	ctx->tilesY = ((size_t)ctx->surface.height + RSGL_SW_TILE_SIZE - 1) / RSGL_SW_TILE_SIZE;
+
+	size_t i, j;
+	size_t tileCount = ctx->tilesX * ctx->tilesY;
+	if (tileCount > ctx->tileCap) {
+		ctx->tiles = (RSGL_swTile*)RSGL_REALLOC(ctx->tiles, tileCount * sizeof(RSGL_swTile));
+		RSGL_MEMSET(&ctx->tiles[ctx->tileCap], 0, (tileCount - ctx->tileCap) * sizeof(RSGL_swTile));
+		ctx->tileCap = tileCount;
+	}
+
+	for (i = 0; i < tileCount; i++)
+		ctx->tiles[i].count = 0;
+	ctx->triangleCount = 0;
+
+	i32 clip[4] = { 0, 0, ctx->surface.width, ctx->surface.height };
+	if (ctx->scissor) {
+		if (ctx->scissorRect[0] > clip[0]) clip[0] = ctx->scissorRect[0];
+		if (ctx->scissorRect[1] > clip[1]) clip[1] = ctx->scissorRect[1];
+		if (ctx->scissorRect[2] < clip[2]) clip[2] = ctx->scissorRect[2];
+		if (ctx->scissorRect[3] < clip[3]) clip[3] = ctx->scissorRect[3];
+	}
+
+	if (clip[0] >= clip[2] || clip[1] >= clip[3])
+		return;
+
+	const float* verts = (const float*)pass->buffers->vertex;
+	const float* texCoords = (const float*)pass->buffers->texture;
+	const float* colors = (const float*)pass->buffers->color;
+	const u16* elements = (const u16*)pass->buffers->elements;
+
+	float vx = (float)ctx->viewport[0], vy = (float)ctx->viewport[1];
+	float vw = (float)ctx->viewport[2], vh = (float)ctx->viewport[3];
+	if (vw == 0.0f || vh == 0.0f) {
+		vw = (float)ctx->surface.width;
+		vh = (float)ctx->surface.height;
+	}
+
+	/* setup and bin every primitive */
+	for (i = 0; i < pass->buffers->batchCount; i++) {
+		const RSGL_BATCH* batch = &pass->buffers->batches[i];
+
+		/* gl_Position = pv * model * position */
+		RSGL_mat4 matrix = RSGL_mat4_multiply((float*)batch->matrix.m, pass->matrix);
+		const RSGL_swTexture* texture = (const RSGL_swTexture*)batch->tex;
+
+		i32 batchClip[4] = { clip[0], clip[1], clip[2], clip[3] };
+		if (batch->clipped) {
+			i32 x0 = (i32)batch->clip.x, y0 = (i32)batch->clip.y;
+			i32 x1 = (i32)(batch->clip.x + batch->clip.w), y1 = (i32)(batch->clip.y + batch->clip.h);
+			if (x0 > batchClip[0]) batchClip[0] = x0;
+			if (y0 > batchClip[1]) batchClip[1] = y0;
+			if (x1 < batchClip[2]) batchClip[2] = x1;
+			if (y1 < batchClip[3]) batchClip[3] = y1;
+
+			if (batchClip[0] >= batchClip[2] || batchClip[1] >= batchClip[3])
+				continue;
+		}
+
+		size_t per = (batch->type == RSGL_TRIANGLES) ? 3 : ((batch->type == RSGL_LINES) ? 2 : 1);
+		size_t end = batch->elmStart + batch->elmCount;
+
+		for (j = batch->elmStart; j + per <= end; j += per) {
+			RSGL_swVertex v[3];
+			RSGL_bool valid = RSGL_TRUE;
+
+			size_t k;
+			for (k = 0; k < per; k++) {
+				size_t index = elements[j + k];
+				if (index < batch->start || index >= batch->start + batch->len) {
+					valid = RSGL_FALSE;
+					break;
+				}
+
+				const float* p = &verts[index * 3];
+				float x = matrix.m[0] * p[0] + matrix.m[4] * p[1] + matrix.m[8] * p[2] + matrix.m[12];
+				float y = matrix.m[1] * p[0] + matrix.m[5] * p[1] + matrix.m[9] * p[2] + matrix.m[13];
+				float w = matrix.m[3] * p[0] + matrix.m[7] * p[1] + matrix.m[11] * p[2] + matrix.m[15];
+
+				/* no near plane clipping, drop anything behind the camera */
+				if (w <= 1e-6f) {
+					valid = RSGL_FALSE;
+					break;
+				}
+
+				float invW = 1.0f / w;
+				v[k].x = vx + (x * invW * 0.5f + 0.5f) * vw;
+				v[k].y = (float)ctx->surface.height - (vy + (y * invW * 0.5f + 0.5f) * vh);
+				v[k].invW = invW;
+				v[k].attr[0] = texCoords[index * 2] * invW;
+				v[k].attr[1] = texCoords[index * 2 + 1] * invW;
+				v[k].attr[2] = colors[index * 4] * invW;
+				v[k].attr[3] = colors[index * 4 + 1] * invW;
+				v[k].attr[4] = colors[index * 4 + 2] * invW;
+				v[k].attr[5] = colors[index * 4 + 3] * invW;
+			}
+
+			if (valid == RSGL_FALSE) continue;
+
+			switch (batch->type) {
+				case RSGL_TRIANGLES: RSGL_SW_pushTriangle(ctx, &v[0], &v[1], &v[2], texture, batchClip); break;
+				case RSGL_LINES: RSGL_SW_pushLine(ctx, &v[0], &v[1], batch->lineWidth, texture, batchClip); break;
+				default: RSGL_SW_pushPoint(ctx, &v[0], batch->lineWidth, texture, batchClip); break;
+			}
+		}
+	}
+
+	if (ctx->triangleCount == 0)
+		return;
+
+	ctx->nextTile = 0;
+
+#ifndef RSGL_SW_NO_THREADS
+	/* small frames aren't worth waking the workers for */
+	if (ctx->triangleCount >= 64 && tileCount > 1) {
+		if (ctx->workers == NULL)
+			ctx->workers = RSGL_SW_createWorkers(ctx);
+
+		RSGL_swWorkers* workers = (RSGL_swWorkers*)ctx->workers;
+		if (workers && workers->count) {
+			RSGL_SW_LOCK(workers);
+			workers->busy = workers->count;
+			workers->generation++;
+			RSGL_SW_BROADCAST(workers, start);
+			RSGL_SW_UNLOCK(workers);
+
+			RSGL_SW_rasterTiles(ctx);
+
+			RSGL_SW_LOCK(workers);
+			while (workers->busy)
+				RSGL_SW_WAIT(workers, done);
+			RSGL_SW_UNLOCK(workers);
+			return;
+		}
+	}
+#endif
+
+	RSGL_SW_rasterTiles(ctx);
+}
+
+#endif /* RSGL_IMPLEMENTATION */
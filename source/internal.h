@@ -1,11 +1,288 @@
+#ifndef HL_INTERNAL_H
+#define HL_INTERNAL_H
+
 #include <hoglib.h>
 
-HL_API hl_windowHandle hl_createWindowPlatform(const char* name, int32_t width, int32_t height, hl_windowFlags flags);
+/* `share` is the window whose OpenGL context the new one shares objects with (or NULL), returns NULL on failure */
+HL_API hl_windowHandle hl_createWindowPlatform(const char* name, int32_t width, int32_t height, hl_windowFlags flags, hl_windowHandle share);
 
 HL_API void hl_updateRendererSize(hl_windowHandle window);
 
+/**!
+ * @brief hl_initRenderer, but reuses the default program and texture of `share`'s renderer when the types match
+ * @param the backend renderer to use
+ * @param handle to the window object
+ * @param handle to the window to share with (or NULL)
+*/
+HL_API hl_rendererHandle hl_initSharedRenderer(uint32_t type, hl_windowHandle window, hl_windowHandle share);
+
 HL_API void hl_setWindowRenderer(hl_windowHandle window, hl_rendererHandle renderer);
 
+/**!
+ * @brief queue the mouse motion event held back for coalescing, hl_pollEvents calls it after polling
+*/
+HL_API void hl_flushEvents(void);
+
+/* Pixel conversion kernels */
+
+typedef enum hl_simdLevel {
+	HL_SIMD_SCALAR = 0,
+	HL_SIMD_SSE2,
+	HL_SIMD_SSSE3,
+	HL_SIMD_AVX2,
+	HL_SIMD_NEON
+} hl_simdLevel;
+
+/* every kernel writes 8-bit RGBA, `count` is in pixels */
+typedef struct hl_pixelOps {
+	hl_simdLevel level;
+	void (*rgbToRGBA)(uint8_t* dst, const uint8_t* src, size_t count);
+	void (*bgrToRGBA)(uint8_t* dst, const uint8_t* src, size_t count);
+	void (*bgraToRGBA)(uint8_t* dst, const uint8_t* src, size_t count);
+	void (*grayAlphaToRGBA)(uint8_t* dst, const uint8_t* src, size_t count); /* 2 channel gray + alpha */
+	void (*coverageToRGBA)(uint8_t* dst, const uint8_t* src, size_t count); /* 1 channel value copied to all 4 channels */
+} hl_pixelOps;
+
+/**!
+ * @brief fetch the best SIMD level supported by the CPU
+ * @return the detected SIMD level
+*/
+HL_API hl_simdLevel hl_getSimdLevel(void);
+
+/**!
+ * @brief fetch the kernels for the best SIMD level supported by the CPU
+ * @return the kernel table
+*/
+HL_API const hl_pixelOps* hl_getPixelOps(void);
+
+/**!
+ * @brief fetch the kernels for a given SIMD level, unsupported levels are clamped to what the CPU supports
+ * @param the requested SIMD level
+ * @return the kernel table
+*/
+HL_API const hl_pixelOps* hl_getPixelOpsLevel(hl_simdLevel level);
+
+/**!
+ * @brief convert 8-bit RGB, BGR, BGRA, gray + alpha or RGBA pixels to RGBA
+ * @param [OUTPUT] destination buffer, must hold count * 4 bytes
+ * @param source pixels
+ * @param format of the source pixels
+ * @param number of pixels
+ * @return false if the format isn't supported
+*/
+HL_API bool hl_convertToRGBA(uint8_t* dst, const uint8_t* src, hl_textureFormat format, size_t count);
+
+/* Threading */
+
+typedef struct hl_thread hl_thread;
+typedef struct hl_mutex hl_mutex;
+typedef struct hl_condition hl_condition;
+
+typedef void (*hl_threadFunc)(void* arg);
+
+#if defined(_MSC_VER)
+	#define HL_THREAD_LOCAL __declspec(thread)
+#else
+	#define HL_THREAD_LOCAL __thread
+#endif
+
+/**!
+ * @brief start a thread
+ * @param function the thread runs
+ * @param argument passed to the function
+ * @return handle to the thread or NULL on failure, it must be joined with hl_joinThread
+*/
+HL_API hl_thread* hl_createThread(hl_threadFunc func, void* arg);
+
+/**!
+ * @brief wait for a thread to return and free it
+ * @param handle to the thread
+*/
+HL_API void hl_joinThread(hl_thread* thread);
+
+HL_API hl_mutex* hl_createMutex(void);
+HL_API void hl_freeMutex(hl_mutex* mutex);
+HL_API void hl_lockMutex(hl_mutex* mutex);
+HL_API void hl_unlockMutex(hl_mutex* mutex);
+
+HL_API hl_condition* hl_createCondition(void);
+HL_API void hl_freeCondition(hl_condition* condition);
+
+/**!
+ * @brief unlock the mutex and sleep until the condition is signaled, the mutex is locked again before returning
+ * @param handle to the condition
+ * @param handle to a mutex locked by the calling thread
+*/
+HL_API void hl_waitCondition(hl_condition* condition, hl_mutex* mutex);
+
+/**!
+ * @brief wake every thread waiting on the condition
+ * @param handle to the condition
+*/
+HL_API void hl_broadcastCondition(hl_condition* condition);
+
+/**!
+ * @brief load a value written by another thread with hl_atomicStore, writes made before that store are visible after this load
+ * @param pointer to the value
+ * @return the value
+*/
+HL_API size_t hl_atomicLoad(volatile size_t* ptr);
+
+/**!
+ * @brief store a value for another thread to read with hl_atomicLoad, writes made before this store are visible to it
+ * @param pointer to the value
+ * @param the new value
+*/
+HL_API void hl_atomicStore(volatile size_t* ptr, size_t value);
+
+/* Frame arena */
+
+/**!
+ * @brief allocate temporary memory from the calling thread's arena, it has to be freed with hl_tempFree on the same thread
+ * large allocations go to the heap, freeing the newest allocation makes its memory available again right away
+ * @param size in bytes
+ * @return 16 byte aligned memory
+*/
+HL_API void* hl_tempAlloc(size_t size);
+HL_API void* hl_tempRealloc(void* ptr, size_t size);
+HL_API void hl_tempFree(void* ptr);
+
+/**!
+ * @brief send temporaries to the heap instead of the arenas (enabled by default), for measuring what the arenas save
+ * @param false to use the heap
+*/
+HL_API void hl_setTempArena(bool enabled);
+
+/* Render thread */
+
+/**!
+ * @brief move the window's OpenGL context to a render thread that submits and presents the recorded frames
+ * @param handle to a window with an OpenGL renderer, its context must be current on the calling thread
+*/
+HL_API void hl_startRenderThread(hl_windowHandle window);
+
+/**!
+ * @brief run a function on the window's render thread once the frames submitted so far are presented
+ * @param handle to the window object
+ * @param function to run with the OpenGL context current
+ * @param argument passed to the function
+ * @return false if the window doesn't have a render thread, the function isn't called then
+*/
+HL_API bool hl_runOnRenderThread(hl_windowHandle window, hl_threadFunc func, void* arg);
+
+/* Capture */
+
+typedef struct hl_captureState hl_captureState;
+
+typedef enum hl_captureOp {
+	HL_CAPTURE_START_FRAME = 1,
+	HL_CAPTURE_FINISH_FRAME,
+	HL_CAPTURE_CLEAR,
+	HL_CAPTURE_READ_PIXELS,
+	HL_CAPTURE_REQUEST_PIXELS,
+	HL_CAPTURE_FETCH_PIXELS,
+	HL_CAPTURE_SET_FRAME_LATENCY,
+	HL_CAPTURE_SET_DEPTH_SORTING,
+	HL_CAPTURE_SET_POLYLINE_DECIMATION,
+	HL_CAPTURE_SET_PREWARM_BUDGET,
+	HL_CAPTURE_SET_TEXTURE,
+	HL_CAPTURE_SET_TEXTURE_SOURCE,
+	HL_CAPTURE_SET_FONT,
+	HL_CAPTURE_SET_COLOR,
+	HL_CAPTURE_PUSH_CLIP,
+	HL_CAPTURE_POP_CLIP,
+	HL_CAPTURE_DRAW_RECT,
+	HL_CAPTURE_DRAW_LINE,
+	HL_CAPTURE_DRAW_POLYLINE,
+	HL_CAPTURE_DRAW_TEXT,
+	HL_CAPTURE_DRAW_TEXT_LEN,
+	HL_CAPTURE_DRAW_TILEMAP,
+	HL_CAPTURE_SET_TILE, /* hl_clearTile sets an empty tile */
+	HL_CAPTURE_DATA, /* bytes a font was loaded from, stored once for every file or buffer */
+	HL_CAPTURE_LOAD_FONT,
+	HL_CAPTURE_RELEASE_FONT,
+	HL_CAPTURE_PREWARM_FONT,
+	HL_CAPTURE_LOAD_TEXTURE,
+	HL_CAPTURE_RELEASE_TEXTURE,
+	HL_CAPTURE_CREATE_DRAW_LIST,
+	HL_CAPTURE_RELEASE_DRAW_LIST,
+	HL_CAPTURE_CREATE_TILEMAP,
+	HL_CAPTURE_RELEASE_TILEMAP
+} hl_captureOp;
+
+/* set while hl_startCapture is recording, the hooks below are only called then and check it again under the capture's lock */
+extern hl_captureState* hl_activeCapture;
+
+/* record calls made on the captured window or its draw lists, `op` is a hl_captureOp */
+HL_API void hl_recordOp(hl_windowHandle window, uint32_t op);
+HL_API void hl_recordRect(hl_windowHandle window, uint32_t op, hl_rect rect);
+HL_API void hl_recordColor(hl_windowHandle window, uint32_t op, hl_color color);
+HL_API void hl_recordValue(hl_windowHandle window, uint32_t op, double value);
+HL_API void hl_recordHandle(hl_windowHandle window, uint32_t op, const void* handle);
+HL_API void hl_recordTextureSource(hl_windowHandle window, hl_textureHandle texture, hl_rect rect);
+HL_API void hl_recordLine(hl_windowHandle window, hl_vec2D vec1, hl_vec2D vec2);
+HL_API void hl_recordPolyline(hl_windowHandle window, const hl_vec2D* points, size_t count, float thickness);
+HL_API void hl_recordText(hl_windowHandle window, uint32_t op, const char* text, size_t len, int32_t x, int32_t y, int32_t size);
+
+/**!
+ * @brief record a loaded font along with the bytes it was loaded from, every file or buffer is only stored once
+ * @param handle to the window the font was loaded for
+ * @param handle to the font
+ * @param path of the font file, or NULL if it was loaded from memory
+ * @param the font data if `path` is NULL
+ * @param size of the font data
+ * @param the max height the font was loaded with
+*/
+HL_API void hl_recordFont(hl_windowHandle window, hl_fontHandle font, const char* path, const uint8_t* data, size_t size, uint32_t maxHeight);
+HL_API void hl_recordPrewarm(hl_windowHandle window, hl_fontHandle font, const hl_codepointRange* ranges, size_t rangeCount, const uint32_t* sizes, size_t sizeCount);
+
+/* record a created texture, the blob's pixels are stored in the capture */
+HL_API void hl_recordTexture(hl_windowHandle window, hl_textureHandle texture, const hl_textureBlob* blob);
+HL_API void hl_recordTilemap(hl_windowHandle window, hl_tilemapHandle tilemap, uint32_t columns, uint32_t rows, float tileWidth, float tileHeight, hl_textureHandle atlas);
+HL_API void hl_recordTile(hl_tilemapHandle tilemap, uint32_t op, uint32_t column, uint32_t row, hl_rect source, hl_color color);
+HL_API void hl_recordDrawTilemap(hl_windowHandle window, hl_tilemapHandle tilemap, float cameraX, float cameraY, float zoom);
+
+/* stops the capture if `window` is the captured window, called by hl_freeRenderer */
+HL_API void hl_captureWindowClosed(hl_windowHandle window);
+
+/* starts capturing the first window the process creates when HL_CAPTURE is set to a path */
+HL_API void hl_captureNewWindow(hl_windowHandle window);
+
+/* state the replay checks before calling functions that assert on it */
+HL_API void hl_getTilemapSize(hl_tilemapHandle tilemap, uint32_t* columns, uint32_t* rows);
+
+/* Software surface Native API */
+
+/**!
+ * @brief check if the window was created with HL_WINDOW_HEADLESS
+ * @param handle to the window object
+ * @return true if the window has no native window to blit to
+*/
+HL_API bool hl_isWindowHeadless(hl_windowHandle window);
+
+/**!
+ * @brief create a surface that can be blitted to the window
+ * @param handle to the window object
+ * @param BGRA8 pixel data owned by the caller, must stay alive as long as the surface
+ * @param width of the surface
+ * @param height of the surface
+ * @return handle to the surface or NULL on failure
+*/
+HL_API void* hl_createSurface(hl_windowHandle window, uint8_t* pixels, int32_t width, int32_t height);
+
+/**!
+ * @brief copy the surface pixels to the window
+ * @param handle to the window object
+ * @param handle to the surface
+*/
+HL_API void hl_blitSurface(hl_windowHandle window, void* surface);
+
+/**!
+ * @brief free a surface created with hl_createSurface, this doesn't free the pixel data
+ * @param handle to the surface
+*/
+HL_API void hl_freeSurface(void* surface);
+
 /* OpenGL Native API */
 
 /**!
@@ -22,7 +299,7 @@ HL_API void hl_swapBuffers(hl_windowHandle window);
 HL_API hl_proc hl_getProcAddress(const char* procname);
 
 /**!
- * @brief make the window this current OpenGL context
+ * @brief make the window this current OpenGL context, does nothing if it already is current on this thread
  * @param handle to the window object
 */
 HL_API void hl_makeCurrentContext(hl_windowHandle window);
@@ -34,3 +311,4 @@ HL_API void hl_makeCurrentContext(hl_windowHandle window);
 */
 HL_API void hl_swapInterval(hl_windowHandle window, int32_t swapInterval);
 
+#endif /* HL_INTERNAL_H */
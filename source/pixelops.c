@@ -0,0 +1,444 @@
+#include "internal.h"
+
+#include <string.h>
+
+/*
+ * pixel conversion kernels
+ * every kernel converts `count` pixels from src into dst, dst is always 8-bit RGBA
+ * the SIMD kernels handle the bulk of the data and finish the tail with the scalar kernel
+*/
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define HL_PIXELOPS_X86
+	#include <immintrin.h>
+
+	#if defined(__GNUC__) || defined(__clang__)
+		#define HL_TARGET(x) __attribute__((target(x)))
+		#include <cpuid.h>
+	#else
+		#define HL_TARGET(x)
+		#include <intrin.h>
+	#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#define HL_PIXELOPS_NEON
+	#include <arm_neon.h>
+#endif
+
+/* scalar kernels */
+
+static void hl_rgbToRGBA_scalar(uint8_t* dst, const uint8_t* src, size_t count) {
+	size_t i;
+	for (i = 0; i < count; i++) {
+		dst[0] = src[0];
+		dst[1] = src[1];
+		dst[2] = src[2];
+		dst[3] = 255;
+		dst += 4; src += 3;
+	}
+}
+
+static void hl_bgrToRGBA_scalar(uint8_t* dst, const uint8_t* src, size_t count) {
+	size_t i;
+	for (i = 0; i < count; i++) {
+		dst[0] = src[2];
+		dst[1] = src[1];
+		dst[2] = src[0];
+		dst[3] = 255;
+		dst += 4; src += 3;
+	}
+}
+
+static void hl_bgraToRGBA_scalar(uint8_t* dst, const uint8_t* src, size_t count) {
+	size_t i;
+	for (i = 0; i < count; i++) {
+		uint8_t b = src[0];
+		dst[0] = src[2];
+		dst[1] = src[1];
+		dst[2] = b;
+		dst[3] = src[3];
+		dst += 4; src += 4;
+	}
+}
+
+static void hl_grayAlphaToRGBA_scalar(uint8_t* dst, const uint8_t* src, size_t count) {
+	size_t i;
+	for (i = 0; i < count; i++) {
+		dst[0] = src[0];
+		dst[1] = src[0];
+		dst[2] = src[0];
+		dst[3] = src[1];
+		dst += 4; src += 2;
+	}
+}
+
+static void hl_coverageToRGBA_scalar(uint8_t* dst, const uint8_t* src, size_t count) {
+	size_t i;
+	for (i = 0; i < count; i++) {
+		dst[0] = src[i];
+		dst[1] = src[i];
+		dst[2] = src[i];
+		dst[3] = src[i];
+		dst += 4;
+	}
+}
+
+static const hl_pixelOps hl_pixelOps_scalar = {
+	HL_SIMD_SCALAR,
+	hl_rgbToRGBA_scalar,
+	hl_bgrToRGBA_scalar,
+	hl_bgraToRGBA_scalar,
+	hl_grayAlphaToRGBA_scalar,
+	hl_coverageToRGBA_scalar
+};
+
+#ifdef HL_PIXELOPS_X86
+
+/* SSE2 kernels */
+
+HL_TARGET("sse2") static void hl_bgraToRGBA_sse2(uint8_t* dst, const uint8_t* src, size_t count) {
+	const __m128i maskAG = _mm_set1_epi32((int)0xFF00FF00);
+	const __m128i maskR = _mm_set1_epi32(0x000000FF);
+	const __m128i maskB = _mm_set1_epi32(0x00FF0000);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128i x = _mm_loadu_si128((const __m128i*)(src + i * 4));
+		__m128i out = _mm_or_si128(_mm_and_si128(x, maskAG),
+						_mm_or_si128(_mm_and_si128(_mm_srli_epi32(x, 16), maskR), _mm_and_si128(_mm_slli_epi32(x, 16), maskB)));
+		_mm_storeu_si128((__m128i*)(dst + i * 4), out);
+	}
+
+	hl_bgraToRGBA_scalar(dst + i * 4, src + i * 4, count - i);
+}
+
+HL_TARGET("sse2") static void hl_grayAlphaToRGBA_sse2(uint8_t* dst, const uint8_t* src, size_t count) {
+	const __m128i maskLow = _mm_set1_epi16(0x00FF);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m128i x = _mm_loadu_si128((const __m128i*)(src + i * 2));
+		__m128i g = _mm_and_si128(x, maskLow);
+		__m128i a = _mm_srli_epi16(x, 8);
+		__m128i gg = _mm_or_si128(g, _mm_slli_epi16(g, 8));
+		__m128i ga = _mm_or_si128(g, _mm_slli_epi16(a, 8));
+
+		_mm_storeu_si128((__m128i*)(dst + i * 4), _mm_unpacklo_epi16(gg, ga));
+		_mm_storeu_si128((__m128i*)(dst + i * 4 + 16), _mm_unpackhi_epi16(gg, ga));
+	}
+
+	hl_grayAlphaToRGBA_scalar(dst + i * 4, src + i * 2, count - i);
+}
+
+HL_TARGET("sse2") static void hl_coverageToRGBA_sse2(uint8_t* dst, const uint8_t* src, size_t count) {
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		__m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i lo = _mm_unpacklo_epi8(x, x);
+		__m128i hi = _mm_unpackhi_epi8(x, x);
+
+		_mm_storeu_si128((__m128i*)(dst + i * 4), _mm_unpacklo_epi16(lo, lo));
+		_mm_storeu_si128((__m128i*)(dst + i * 4 + 16), _mm_unpackhi_epi16(lo, lo));
+		_mm_storeu_si128((__m128i*)(dst + i * 4 + 32), _mm_unpacklo_epi16(hi, hi));
+		_mm_storeu_si128((__m128i*)(dst + i * 4 + 48), _mm_unpackhi_epi16(hi, hi));
+	}
+
+	hl_coverageToRGBA_scalar(dst + i * 4, src + i, count - i);
+}
+
+/* SSSE3 kernels, SSE2 has no byte shuffle so the 3 channel swizzles need pshufb */
+
+HL_TARGET("ssse3") static void hl_rgbToRGBA_ssse3(uint8_t* dst, const uint8_t* src, size_t count) {
+	const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+	const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+
+	/* each load reads 16 bytes but only consumes 12, keep 4 bytes of slack */
+	size_t i = 0;
+	for (; i + 6 <= count; i += 4) {
+		__m128i x = _mm_loadu_si128((const __m128i*)(src + i * 3));
+		_mm_storeu_si128((__m128i*)(dst + i * 4), _mm_or_si128(_mm_shuffle_epi8(x, shuffle), alpha));
+	}
+
+	hl_rgbToRGBA_scalar(dst + i * 4, src + i * 3, count - i);
+}
+
+HL_TARGET("ssse3") static void hl_bgrToRGBA_ssse3(uint8_t* dst, const uint8_t* src, size_t count) {
+	const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+	const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+
+	size_t i = 0;
+	for (; i + 6 <= count; i += 4) {
+		__m128i x = _mm_loadu_si128((const __m128i*)(src + i * 3));
+		_mm_storeu_si128((__m128i*)(dst + i * 4), _mm_or_si128(_mm_shuffle_epi8(x, shuffle), alpha));
+	}
+
+	hl_bgrToRGBA_scalar(dst + i * 4, src + i * 3, count - i);
+}
+
+HL_TARGET("ssse3") static void hl_bgraToRGBA_ssse3(uint8_t* dst, const uint8_t* src, size_t count) {
+	const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128i x = _mm_loadu_si128((const __m128i*)(src + i * 4));
+		_mm_storeu_si128((__m128i*)(dst + i * 4), _mm_shuffle_epi8(x, shuffle));
+	}
+
+	hl_bgraToRGBA_scalar(dst + i * 4, src + i * 4, count - i);
+}
+
+/* AVX2 kernels */
+
+HL_TARGET("avx2") static void hl_rgbToRGBA_avx2(uint8_t* dst, const uint8_t* src, size_t count) {
+	const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+											0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+	const __m256i alpha = _mm256_set1_epi32((int)0xFF000000);
+
+	size_t i = 0;
+	for (; i + 10 <= count; i += 8) {
+		__m128i lo = _mm_loadu_si128((const __m128i*)(src + i * 3));
+		__m128i hi = _mm_loadu_si128((const __m128i*)(src + i * 3 + 12));
+		__m256i x = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+		_mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_or_si256(_mm256_shuffle_epi8(x, shuffle), alpha));
+	}
+
+	hl_rgbToRGBA_ssse3(dst + i * 4, src + i * 3, count - i);
+}
+
+HL_TARGET("avx2") static void hl_bgrToRGBA_avx2(uint8_t* dst, const uint8_t* src, size_t count) {
+	const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1,
+											2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+	const __m256i alpha = _mm256_set1_epi32((int)0xFF000000);
+
+	size_t i = 0;
+	for (; i + 10 <= count; i += 8) {
+		__m128i lo = _mm_loadu_si128((const __m128i*)(src + i * 3));
+		__m128i hi = _mm_loadu_si128((const __m128i*)(src + i * 3 + 12));
+		__m256i x = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+		_mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_or_si256(_mm256_shuffle_epi8(x, shuffle), alpha));
+	}
+
+	hl_bgrToRGBA_ssse3(dst + i * 4, src + i * 3, count - i);
+}
+
+HL_TARGET("avx2") static void hl_bgraToRGBA_avx2(uint8_t* dst, const uint8_t* src, size_t count) {
+	const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+											2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i x = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+		_mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_shuffle_epi8(x, shuffle));
+	}
+
+	hl_bgraToRGBA_scalar(dst + i * 4, src + i * 4, count - i);
+}
+
+HL_TARGET("avx2") static void hl_grayAlphaToRGBA_avx2(uint8_t* dst, const uint8_t* src, size_t count) {
+	const __m256i maskLow = _mm256_set1_epi32(0x000000FF);
+	const __m256i spread = _mm256_set1_epi32(0x00010101);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i x = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(src + i * 2)));
+		__m256i g = _mm256_mullo_epi32(_mm256_and_si256(x, maskLow), spread);
+		__m256i a = _mm256_slli_epi32(_mm256_srli_epi32(x, 8), 24);
+		_mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_or_si256(g, a));
+	}
+
+	hl_grayAlphaToRGBA_scalar(dst + i * 4, src + i * 2, count - i);
+}
+
+HL_TARGET("avx2") static void hl_coverageToRGBA_avx2(uint8_t* dst, const uint8_t* src, size_t count) {
+	const __m256i spread = _mm256_set1_epi32(0x01010101);
+
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		__m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+		__m256i lo = _mm256_mullo_epi32(_mm256_cvtepu8_epi32(x), spread);
+		__m256i hi = _mm256_mullo_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(x, 8)), spread);
+		_mm256_storeu_si256((__m256i*)(dst + i * 4), lo);
+		_mm256_storeu_si256((__m256i*)(dst + i * 4 + 32), hi);
+	}
+
+	hl_coverageToRGBA_scalar(dst + i * 4, src + i, count - i);
+}
+
+static const hl_pixelOps hl_pixelOps_sse2 = {
+	HL_SIMD_SSE2,
+	hl_rgbToRGBA_scalar,
+	hl_bgrToRGBA_scalar,
+	hl_bgraToRGBA_sse2,
+	hl_grayAlphaToRGBA_sse2,
+	hl_coverageToRGBA_sse2
+};
+
+static const hl_pixelOps hl_pixelOps_ssse3 = {
+	HL_SIMD_SSSE3,
+	hl_rgbToRGBA_ssse3,
+	hl_bgrToRGBA_ssse3,
+	hl_bgraToRGBA_ssse3,
+	hl_grayAlphaToRGBA_sse2,
+	hl_coverageToRGBA_sse2
+};
+
+static const hl_pixelOps hl_pixelOps_avx2 = {
+	HL_SIMD_AVX2,
+	hl_rgbToRGBA_avx2,
+	hl_bgrToRGBA_avx2,
+	hl_bgraToRGBA_avx2,
+	hl_grayAlphaToRGBA_avx2,
+	hl_coverageToRGBA_avx2
+};
+
+static hl_simdLevel hl_detectSimdLevel(void) {
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) return HL_SIMD_AVX2;
+	if (__builtin_cpu_supports("ssse3")) return HL_SIMD_SSSE3;
+	if (__builtin_cpu_supports("sse2")) return HL_SIMD_SSE2;
+#else
+	int info[4];
+	__cpuid(info, 0);
+	int maxLeaf = info[0];
+
+	__cpuid(info, 1);
+	int ecx1 = info[2], edx1 = info[3];
+
+	/* AVX2 also needs the OS to save the YMM registers (OSXSAVE + XCR0) */
+	if (maxLeaf >= 7 && (ecx1 & (1 << 27)) && (_xgetbv(0) & 6) == 6) {
+		__cpuidex(info, 7, 0);
+		if (info[1] & (1 << 5)) return HL_SIMD_AVX2;
+	}
+
+	if (ecx1 & (1 << 9)) return HL_SIMD_SSSE3;
+	if (edx1 & (1 << 26)) return HL_SIMD_SSE2;
+#endif
+	return HL_SIMD_SCALAR;
+}
+
+#elif defined(HL_PIXELOPS_NEON)
+
+/* NEON kernels, the structured loads/stores do the (de)interleaving */
+
+static void hl_rgbToRGBA_neon(uint8_t* dst, const uint8_t* src, size_t count) {
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		uint8x16x3_t x = vld3q_u8(src + i * 3);
+		uint8x16x4_t out = { { x.val[0], x.val[1], x.val[2], vdupq_n_u8(255) } };
+		vst4q_u8(dst + i * 4, out);
+	}
+
+	hl_rgbToRGBA_scalar(dst + i * 4, src + i * 3, count - i);
+}
+
+static void hl_bgrToRGBA_neon(uint8_t* dst, const uint8_t* src, size_t count) {
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		uint8x16x3_t x = vld3q_u8(src + i * 3);
+		uint8x16x4_t out = { { x.val[2], x.val[1], x.val[0], vdupq_n_u8(255) } };
+		vst4q_u8(dst + i * 4, out);
+	}
+
+	hl_bgrToRGBA_scalar(dst + i * 4, src + i * 3, count - i);
+}
+
+static void hl_bgraToRGBA_neon(uint8_t* dst, const uint8_t* src, size_t count) {
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		uint8x16x4_t x = vld4q_u8(src + i * 4);
+		uint8x16_t b = x.val[0];
+		x.val[0] = x.val[2];
+		x.val[2] = b;
+		vst4q_u8(dst + i * 4, x);
+	}
+
+	hl_bgraToRGBA_scalar(dst + i * 4, src + i * 4, count - i);
+}
+
+static void hl_grayAlphaToRGBA_neon(uint8_t* dst, const uint8_t* src, size_t count) {
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		uint8x16x2_t x = vld2q_u8(src + i * 2);
+		uint8x16x4_t out = { { x.val[0], x.val[0], x.val[0], x.val[1] } };
+		vst4q_u8(dst + i * 4, out);
+	}
+
+	hl_grayAlphaToRGBA_scalar(dst + i * 4, src + i * 2, count - i);
+}
+
+static void hl_coverageToRGBA_neon(uint8_t* dst, const uint8_t* src, size_t count) {
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		uint8x16_t x = vld1q_u8(src + i);
+		uint8x16x4_t out = { { x, x, x, x } };
+		vst4q_u8(dst + i * 4, out);
+	}
+
+	hl_coverageToRGBA_scalar(dst + i * 4, src + i, count - i);
+}
+
+static const hl_pixelOps hl_pixelOps_neon = {
+	HL_SIMD_NEON,
+	hl_rgbToRGBA_neon,
+	hl_bgrToRGBA_neon,
+	hl_bgraToRGBA_neon,
+	hl_grayAlphaToRGBA_neon,
+	hl_coverageToRGBA_neon
+};
+
+static hl_simdLevel hl_detectSimdLevel(void) { return HL_SIMD_NEON; }
+
+#else
+
+static hl_simdLevel hl_detectSimdLevel(void) { return HL_SIMD_SCALAR; }
+
+#endif
+
+static const hl_pixelOps* hl_pixelOps_current = NULL;
+
+hl_simdLevel hl_getSimdLevel(void) {
+	static int32_t level = -1;
+	if (level == -1)
+		level = (int32_t)hl_detectSimdLevel();
+	return (hl_simdLevel)level;
+}
+
+const hl_pixelOps* hl_getPixelOpsLevel(hl_simdLevel level) {
+	/* never hand out kernels the CPU can't run */
+	if (level > hl_getSimdLevel())
+		level = hl_getSimdLevel();
+
+	switch (level) {
+#ifdef HL_PIXELOPS_X86
+		case HL_SIMD_AVX2: return &hl_pixelOps_avx2;
+		case HL_SIMD_SSSE3: return &hl_pixelOps_ssse3;
+		case HL_SIMD_SSE2: return &hl_pixelOps_sse2;
+#elif defined(HL_PIXELOPS_NEON)
+		case HL_SIMD_NEON: return &hl_pixelOps_neon;
+#endif
+		default: break;
+	}
+
+	return &hl_pixelOps_scalar;
+}
+
+const hl_pixelOps* hl_getPixelOps(void) {
+	if (hl_pixelOps_current == NULL)
+		hl_pixelOps_current = hl_getPixelOpsLevel(hl_getSimdLevel());
+	return hl_pixelOps_current;
+}
+
+bool hl_convertToRGBA(uint8_t* dst, const uint8_t* src, hl_textureFormat format, size_t count) {
+	const hl_pixelOps* ops = hl_getPixelOps();
+
+	switch (format) {
+		case HL_FORMAT_RGB: ops->rgbToRGBA(dst, src, count); break;
+		case HL_FORMAT_BGR: ops->bgrToRGBA(dst, src, count); break;
+		case HL_FORMAT_BGRA: ops->bgraToRGBA(dst, src, count); break;
+		case HL_FORMAT_GRAYSCALEALPHA: ops->grayAlphaToRGBA(dst, src, count); break;
+		case HL_FORMAT_RGBA: memcpy(dst, src, count * 4); break;
+		default: return false;
+	}
+
+	return true;
+}
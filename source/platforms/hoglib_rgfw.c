@@ -8,19 +8,157 @@
 
 #include "RGFW.h"
 
+/* marks windows created with HL_WINDOW_HEADLESS, RGFW doesn't use the upper flag bits */
+#define HL_RGFW_HEADLESS RGFW_BIT(31)
+
+/* hoglib's per window state, stored in RGFW_window.userPtr */
+typedef struct hl_windowData {
+	hl_rendererHandle renderer;
+
+	hl_mouseSample* mouseHistory; /* ring of HL_MOUSE_HISTORY_SIZE samples, allocated on the first motion */
+	size_t mouseCount; /* samples recorded during poll `mousePoll` */
+	size_t mousePoll;
+} hl_windowData;
+
+/* bumped by every hl_pollEvents, a window's history is only valid for the poll it was recorded in */
+static size_t hl_pollCount = 1;
+
+/* the window whose context is current on this thread, so frames across several windows only switch when they have to */
+static HL_THREAD_LOCAL hl_windowHandle hl_currentContext = NULL;
+
+static hl_windowData* hl_getWindowData(hl_windowHandle window) {
+	return (hl_windowData*)((RGFW_window*)window)->userPtr;
+}
+
 void hl_setWindowRenderer(hl_windowHandle window, hl_rendererHandle renderer) {
-	((RGFW_window*)window)->userPtr = renderer;
+	hl_getWindowData(window)->renderer = renderer;
 }
 
 hl_rendererHandle hl_getWindowRenderer(hl_windowHandle window) {
-	return ((RGFW_window*)window)->userPtr;
+	return hl_getWindowData(window)->renderer;
+}
+
+static void hl_pushWindowEvent(RGFW_window* win, hl_eventType type, int32_t x, int32_t y) {
+	hl_event event;
+	memset(&event, 0, sizeof(event));
+	event.type = type;
+	event.win.window = win;
+	event.win.x = x;
+	event.win.y = y;
+	hl_pushEvent(&event);
 }
 
 void hl_resizeHandler(RGFW_window* win, int32_t w, int32_t h)  {
 	hl_updateRendererSize(win);
+	hl_pushWindowEvent(win, HL_EVENT_WINDOW_RESIZED, w, h);
+}
+
+static void hl_windowMovedHandler(RGFW_window* win, int32_t x, int32_t y) {
+	hl_pushWindowEvent(win, HL_EVENT_WINDOW_MOVED, x, y);
+}
+
+static void hl_quitHandler(RGFW_window* win) {
+	hl_pushWindowEvent(win, HL_EVENT_WINDOW_CLOSE, 0, 0);
+}
+
+static void hl_focusHandler(RGFW_window* win, RGFW_bool inFocus) {
+	hl_pushWindowEvent(win, inFocus ? HL_EVENT_FOCUS_IN : HL_EVENT_FOCUS_OUT, 0, 0);
+}
+
+static void hl_keyHandler(RGFW_window* win, u8 key, u8 sym, RGFW_keymod mod, RGFW_bool repeat, RGFW_bool pressed) {
+	hl_event event;
+	memset(&event, 0, sizeof(event));
+	event.type = pressed ? HL_EVENT_KEY_PRESSED : HL_EVENT_KEY_RELEASED;
+	event.key.window = win;
+	event.key.key = (hl_keyCode)key;
+	event.key.sym = sym;
+	event.key.mod = (hl_keymod)mod;
+	event.key.repeat = repeat;
+	hl_pushEvent(&event);
 }
 
-hl_windowHandle hl_createWindowPlatform(const char* name, int32_t width, int32_t height, hl_windowFlags flags) {
+static void hl_mouseButtonHandler(RGFW_window* win, RGFW_mouseButton button, RGFW_bool pressed) {
+	hl_event event;
+	memset(&event, 0, sizeof(event));
+	event.type = pressed ? HL_EVENT_MOUSE_BUTTON_PRESSED : HL_EVENT_MOUSE_BUTTON_RELEASED;
+	event.button.window = win;
+	event.button.button = (hl_mouseButton)button;
+	hl_pushEvent(&event);
+}
+
+static void hl_mouseScrollHandler(RGFW_window* win, float x, float y) {
+	hl_event event;
+	memset(&event, 0, sizeof(event));
+	event.type = HL_EVENT_MOUSE_SCROLL;
+	event.scroll.window = win;
+	event.scroll.x = x;
+	event.scroll.y = y;
+	hl_pushEvent(&event);
+}
+
+static void hl_recordMouseSample(RGFW_window* win, int32_t x, int32_t y, float vecX, float vecY, double time) {
+	hl_windowData* data = hl_getWindowData(win);
+
+	if (data->mouseHistory == NULL)
+		data->mouseHistory = (hl_mouseSample*)RGFW_ALLOC(HL_MOUSE_HISTORY_SIZE * sizeof(hl_mouseSample));
+
+	if (data->mousePoll != hl_pollCount) {
+		data->mousePoll = hl_pollCount;
+		data->mouseCount = 0;
+	}
+
+	hl_mouseSample* sample = &data->mouseHistory[data->mouseCount % HL_MOUSE_HISTORY_SIZE];
+	sample->x = x;
+	sample->y = y;
+	sample->vecX = vecX;
+	sample->vecY = vecY;
+	sample->time = time;
+	data->mouseCount += 1;
+}
+
+static void hl_mousePosHandler(RGFW_window* win, int32_t x, int32_t y, float vecX, float vecY) {
+	double time = hl_getTime();
+	hl_recordMouseSample(win, x, y, vecX, vecY, time);
+
+	hl_event event;
+	memset(&event, 0, sizeof(event));
+	event.type = HL_EVENT_MOUSE_MOVED;
+	event.mouse.window = win;
+	event.mouse.time = time;
+	event.mouse.x = x;
+	event.mouse.y = y;
+	event.mouse.vecX = vecX;
+	event.mouse.vecY = vecY;
+	hl_pushEvent(&event);
+}
+
+static void hl_mouseNotifyHandler(RGFW_window* win, int32_t x, int32_t y, RGFW_bool status) {
+	hl_event event;
+	memset(&event, 0, sizeof(event));
+	event.type = status ? HL_EVENT_MOUSE_ENTER : HL_EVENT_MOUSE_LEAVE;
+	event.mouse.window = win;
+	event.mouse.x = x;
+	event.mouse.y = y;
+	hl_pushEvent(&event);
+}
+
+hl_windowHandle hl_createWindowPlatform(const char* name, int32_t width, int32_t height, hl_windowFlags flags, hl_windowHandle share) {
+	if (flags & HL_WINDOW_HEADLESS) {
+		/* a bare window struct, nothing here touches the display server */
+		RGFW_window* window = (RGFW_window*)RGFW_ALLOC(sizeof(RGFW_window));
+		RGFW_MEMSET(window, 0, sizeof(RGFW_window));
+		window->w = width;
+		window->h = height;
+		window->internal.flags = HL_RGFW_HEADLESS;
+		window->userPtr = RGFW_ALLOC(sizeof(hl_windowData));
+		RGFW_MEMSET(window->userPtr, 0, sizeof(hl_windowData));
+		return window;
+	}
+
+	/* RGFW is initialized by the first real window, fail if there is no display to open */
+	if (_RGFW == NULL && RGFW_init() != 0)
+		return NULL;
+
 	RGFW_windowFlags win_flags = RGFW_windowCenter;
 
 	if (flags & HL_WINDOW_NO_BORDER) win_flags |= RGFW_windowNoBorder;
@@ -41,8 +179,35 @@ hl_windowHandle hl_createWindowPlatform(const char* name, int32_t width, int32_t
 	if (flags & HL_RENDERER_GL_MODERN) win_flags |= RGFW_windowOpenGL;
 
 
+	/* textures, buffers and programs created by either context are visible to both */
+	RGFW_glHints* hints = RGFW_getGlobalHints_OpenGL();
+	RGFW_glContext* previousShare = hints->share;
+	if ((win_flags & RGFW_windowOpenGL) && share && hl_isWindowHeadless(share) == false)
+		hints->share = RGFW_window_getContext_OpenGL((RGFW_window*)share);
+
 	RGFW_window* window = RGFW_createWindow(name, 0, 0, width, height, win_flags);
+	hints->share = previousShare;
+
+	/* no display, or no context with the requested hints */
+	if (window == NULL)
+		return NULL;
+
+	window->userPtr = RGFW_ALLOC(sizeof(hl_windowData));
+	RGFW_MEMSET(window->userPtr, 0, sizeof(hl_windowData));
+
+	/* RGFW leaves the new context current */
+	if (win_flags & RGFW_windowOpenGL)
+		hl_currentContext = window;
+
 	RGFW_setWindowResizedCallback(hl_resizeHandler);
+	RGFW_setWindowMovedCallback(hl_windowMovedHandler);
+	RGFW_setWindowQuitCallback(hl_quitHandler);
+	RGFW_setFocusCallback(hl_focusHandler);
+	RGFW_setKeyCallback(hl_keyHandler);
+	RGFW_setMouseButtonCallback(hl_mouseButtonHandler);
+	RGFW_setMouseScrollCallback(hl_mouseScrollHandler);
+	RGFW_setMousePosCallback(hl_mousePosHandler);
+	RGFW_setMouseNotifyCallback(hl_mouseNotifyHandler);
 
 	return window;
 }
@@ -51,16 +216,86 @@ bool hl_windowShouldClose(hl_windowHandle window) {
 	return RGFW_window_shouldClose((RGFW_window*)window);
 }
 
+bool hl_isWindowHeadless(hl_windowHandle window) {
+	return (((RGFW_window*)window)->internal.flags & HL_RGFW_HEADLESS) != 0;
+}
+
 void hl_pollEvents(void) {
-	RGFW_pollEvents();
+	hl_pollCount += 1;
+
+	/* RGFW is only initialized once a real window is created */
+	if (_RGFW != NULL)
+		RGFW_pollEvents();
+
+	hl_flushEvents();
+}
+
+size_t hl_getMouseHistory(hl_windowHandle window, hl_mouseSample* samples, size_t count) {
+	hl_windowData* data = hl_getWindowData(window);
+	if (data->mousePoll != hl_pollCount)
+		return 0;
+
+	/* the ring only keeps the newest HL_MOUSE_HISTORY_SIZE samples, and the caller gets the newest `count` of those */
+	size_t available = data->mouseCount < HL_MOUSE_HISTORY_SIZE ? data->mouseCount : HL_MOUSE_HISTORY_SIZE;
+	if (count > available)
+		count = available;
+
+	size_t first = data->mouseCount - count;
+	size_t i;
+	for (i = 0; i < count; i++)
+		samples[i] = data->mouseHistory[(first + i) % HL_MOUSE_HISTORY_SIZE];
+
+	return count;
+}
+
+void hl_setRawMouseMode(hl_windowHandle window, bool enabled) {
+	if (hl_isWindowHeadless(window))
+		return;
+
+	if (enabled)
+		RGFW_window_holdMouse((RGFW_window*)window);
+	else
+		RGFW_window_unholdMouse((RGFW_window*)window);
 }
 
 void hl_closeWindow(hl_windowHandle window) {
 	hl_freeRenderer((RGFW_window*)window);
+
+	hl_windowData* data = hl_getWindowData(window);
+	if (data->mouseHistory)
+		RGFW_FREE(data->mouseHistory);
+	RGFW_FREE(data);
+
+	if (hl_isWindowHeadless(window)) {
+		RGFW_FREE(window);
+		return;
+	}
+
+	if (hl_currentContext == window)
+		hl_currentContext = NULL;
+
 	RGFW_window_close((RGFW_window*)window);
 }
 
+typedef struct hl_swapIntervalCall {
+	hl_windowHandle window;
+	int32_t swapInterval;
+} hl_swapIntervalCall;
+
+static void hl_swapIntervalProc(void* arg) {
+	hl_swapIntervalCall* call = (hl_swapIntervalCall*)arg;
+	RGFW_window_swapInterval_OpenGL((RGFW_window*)call->window, call->swapInterval);
+}
+
 void hl_swapInterval(hl_windowHandle window, int32_t swapInterval) {
+	if (hl_isWindowHeadless(window))
+		return;
+
+	/* the render thread has the context current */
+	hl_swapIntervalCall call = { window, swapInterval };
+	if (hl_runOnRenderThread(window, hl_swapIntervalProc, &call))
+		return;
+
 	RGFW_window_swapInterval_OpenGL((RGFW_window*)window, swapInterval);
 }
 
@@ -68,12 +303,28 @@ void hl_swapBuffers(hl_windowHandle window) {
 	RGFW_window_swapBuffers_OpenGL((RGFW_window*)window);
 }
 
+void* hl_createSurface(hl_windowHandle window, uint8_t* pixels, int32_t width, int32_t height) {
+	return RGFW_window_createSurface((RGFW_window*)window, pixels, width, height, RGFW_formatBGRA8);
+}
+
+void hl_blitSurface(hl_windowHandle window, void* surface) {
+	RGFW_window_blitSurface((RGFW_window*)window, (RGFW_surface*)surface);
+}
+
+void hl_freeSurface(void* surface) {
+	RGFW_surface_free((RGFW_surface*)surface);
+}
+
 hl_proc hl_getProcAddress(const char* procname) {
 	return RGFW_getProcAddress_OpenGL(procname);
 }
 
 void hl_makeCurrentContext(hl_windowHandle window) {
+	if (window == hl_currentContext)
+		return;
+
 	RGFW_window_makeCurrentContext_OpenGL((RGFW_window*)window);
+	hl_currentContext = window;
 }
 
 HL_API bool hl_getWindowMouse(hl_windowHandle window, int32_t* x, int32_t* y) {
@@ -2,31 +2,765 @@
 #include "internal.h"
 
 #define RSGL_RFONT
+#define RSGL_TEMP_MALLOC hl_tempAlloc
+#define RSGL_TEMP_FREE hl_tempFree
+#define RFONT_TEMP_MALLOC hl_tempAlloc
+#define RFONT_TEMP_FREE hl_tempFree
+#define RSGL_COVERAGE_TO_RGBA(dst, src, count) hl_getPixelOps()->coverageToRGBA(dst, src, count)
+#define RSGL_SW_BGRA_TO_RGBA(dst, src, count) hl_getPixelOps()->bgraToRGBA(dst, src, count)
+
+/* HL_BACKEND_* (make HL_BACKEND=...) fixes the backend at compile time, RSGL calls it directly instead of through its proc */
+#if defined(HL_BACKEND_GL_MODERN)
+	#define RSGL_STATIC_BACKEND(name) RSGL_GL_##name
+#elif defined(HL_BACKEND_GL_LEGACY)
+	#define RSGL_STATIC_BACKEND(name) RSGL_GL1_##name
+#elif defined(HL_BACKEND_SOFTWARE)
+	#define RSGL_STATIC_BACKEND(name) RSGL_SW_##name
+#endif
+
+/* the backends are declared before RSGL's implementation so it can call the static one */
+#include <RSGL.h>
+#include <RSGL_gl.h>
+#include <RSGL_gl1.h>
+#include <RSGL_sw.h>
+
 #define RSGL_IMPLEMENTATION
 #include <RSGL.h>
 #include <RSGL_gl.h>
 #include <RSGL_gl1.h>
+#include <RSGL_sw.h>
 
+#define STBI_MALLOC(size) hl_tempAlloc(size)
+#define STBI_REALLOC(ptr, size) hl_tempRealloc(ptr, size)
+#define STBI_FREE(ptr) hl_tempFree(ptr)
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
 #define RFONT_IMPLEMENTATION
 #include "RFont.h"
 
+struct hl_renderThread;
+struct hl_prewarmJob;
+
 typedef struct hl_rendererInfo {
 	RFont_renderer* renderer_rfont;
 	hl_fontHandle font;
+
+	uint32_t type;
+	void* surface; /* window surface the software renderer blits, NULL for the OpenGL renderers and headless windows */
+	RSGL_swSurface swSurface;
+
+	hl_drawList* drawLists; /* merged into the window in this order by hl_finishFrame */
+	size_t drawListCount, drawListCap;
+	RSGL_renderer* parent; /* renderer a draw list is merged into, NULL for windows */
+
+	struct hl_renderThread* renderThread; /* set when the window renderer only records and the render thread owns the real one */
+
+	hl_rect clipStack[HL_MAX_CLIP_DEPTH]; /* each entry is already intersected with the one below it */
+	size_t clipDepth;
+
+	bool decimatePolylines;
+	hl_vec2D* polyline; /* decimated points of the last hl_drawPolyline */
+	size_t polylineCap;
+
+	RSGL_texture* opaqueTextures; /* loaded without transparent texels, drawn in the opaque pass when depth sorting */
+	size_t opaqueTextureCount, opaqueTextureCap;
+
+	RSGL_renderStats overdraw; /* counted between hl_beginOverdrawReport and hl_endOverdrawReport */
+	size_t overdrawFrames;
+
+	struct hl_prewarmJob* prewarmJobs; /* committed by hl_startFrame in request order */
+	double prewarmBudget;
 } hl_rendererInfo;
 
+/*
+ * draw lists and windows with a render thread record into CPU memory through their own RSGL_renderer,
+ * each flush of that renderer is kept as a chunk that is later replayed on the real renderer
+*/
+typedef enum hl_drawChunkType {
+	HL_DRAW_CHUNK_BATCHES = 0,
+	HL_DRAW_CHUNK_CLEAR, /* args: r, g, b, a */
+	HL_DRAW_CHUNK_VIEWPORT, /* args: x, y, w, h */
+	HL_DRAW_CHUNK_REQUEST_PIXELS, /* args: x, y, w, h, renderer height */
+	HL_DRAW_CHUNK_TEXT /* batchStart: index into the stream's texts */
+} hl_drawChunkType;
+
+typedef struct hl_drawChunk {
+	u32 type;
+	size_t vertStart, vertCount;
+	size_t elmStart, elmCount;
+	size_t batchStart, batchCount;
+	float args[5];
+} hl_drawChunk;
+
+/* text of a draw list, laid out when the list is merged so glyphs are only rasterized by the thread owning the atlas */
+typedef struct hl_drawStreamText {
+	RFont_font* font;
+	size_t start, len; /* into the stream's chars */
+	float x, y;
+	u32 size;
+
+	/* state of the list when the text was drawn */
+	RSGL_color color;
+	RSGL_vec3D rotate, center;
+	RSGL_mat4 modelMatrix;
+	RSGL_bool clipped;
+	RSGL_rect clip;
+} hl_drawStreamText;
+
+typedef struct hl_drawStream {
+	float* verts;
+	float* texCoords;
+	float* colors;
+	u16* elements; /* relative to the start of their chunk */
+	size_t vertCount, vertCap;
+	size_t elmCount, elmCap;
+
+	RSGL_BATCH* batches;
+	size_t batchCount, batchCap;
+
+	hl_drawChunk* chunks;
+	size_t chunkCount, chunkCap;
+
+	hl_drawStreamText* texts;
+	size_t textCount, textCap;
+	char* chars;
+	size_t charCount, charCap;
+} hl_drawStream;
+
+typedef struct hl_renderThread {
+	hl_windowHandle window;
+	RSGL_renderer* renderer; /* only used by the render thread */
+
+	hl_thread* thread;
+	hl_mutex* lock;
+	hl_condition* cond; /* broadcast on every state change, both threads wait on it */
+
+	/* frames waiting for the render thread, the recording renderer swaps its stream with a finished one */
+	hl_drawStream queue[HL_MAX_FRAME_LATENCY];
+	bool present[HL_MAX_FRAME_LATENCY];
+	size_t head, count;
+	uint32_t latency;
+
+	/* one blocking call at a time, only run once the queue is empty */
+	hl_threadFunc callFunc;
+	void* callArg;
+	bool callDone;
+
+	bool quit;
+} hl_renderThread;
+
+typedef struct hl_drawListData {
+	RSGL_renderer* parent;
+	hl_renderThread* thread; /* resources are created on the render thread, NULL for draw lists */
+	size_t bufferCount;
+	size_t pendingVerts, pendingElms; /* written by updateBuffer, committed by render */
+
+	hl_drawStream stream;
+} hl_drawListData;
+
+/* RSGL_renderer_createRenderBuffers creates these in order */
+enum { HL_DRAW_LIST_VERTEX = 1, HL_DRAW_LIST_COLOR, HL_DRAW_LIST_TEXTURE, HL_DRAW_LIST_ELEMENTS };
+
+static void hl_renderThread_call(hl_renderThread* thread, hl_threadFunc func, void* arg);
+static void hl_renderThread_submit(hl_renderThread* thread, hl_drawListData* ctx, bool present);
+static void hl_cancelPrewarm(hl_rendererInfo* info, RFont_font* font);
+
+static void hl_drawStream_free(hl_drawStream* stream) {
+	free(stream->verts);
+	free(stream->texCoords);
+	free(stream->colors);
+	free(stream->elements);
+	free(stream->batches);
+	free(stream->chunks);
+	free(stream->texts);
+	free(stream->chars);
+}
+
+static void hl_drawStream_reset(hl_drawStream* stream) {
+	stream->vertCount = 0;
+	stream->elmCount = 0;
+	stream->batchCount = 0;
+	stream->chunkCount = 0;
+	stream->textCount = 0;
+	stream->charCount = 0;
+}
+
+static void hl_drawStream_reserve(hl_drawStream* stream, size_t verts, size_t elms) {
+	if (stream->vertCount + verts > stream->vertCap) {
+		stream->vertCap = (stream->vertCount + verts) * 2;
+		stream->verts = (float*)realloc(stream->verts, stream->vertCap * 3 * sizeof(float));
+		stream->texCoords = (float*)realloc(stream->texCoords, stream->vertCap * 2 * sizeof(float));
+		stream->colors = (float*)realloc(stream->colors, stream->vertCap * 4 * sizeof(float));
+	}
+
+	if (stream->elmCount + elms > stream->elmCap) {
+		stream->elmCap = (stream->elmCount + elms) * 2;
+		stream->elements = (u16*)realloc(stream->elements, stream->elmCap * sizeof(u16));
+	}
+}
+
+static hl_drawChunk* hl_drawStream_pushChunk(hl_drawStream* stream, u32 type) {
+	if (stream->chunkCount >= stream->chunkCap) {
+		stream->chunkCap = stream->chunkCap ? stream->chunkCap * 2 : 8;
+		stream->chunks = (hl_drawChunk*)realloc(stream->chunks, stream->chunkCap * sizeof(hl_drawChunk));
+	}
+
+	hl_drawChunk* chunk = &stream->chunks[stream->chunkCount++];
+	memset(chunk, 0, sizeof(hl_drawChunk));
+	chunk->type = type;
+	return chunk;
+}
+
+static void hl_drawStream_pushText(hl_drawStream* stream, const RSGL_renderer* list, RFont_font* font, const char* text, size_t len, float x, float y, u32 size) {
+	if (stream->textCount >= stream->textCap) {
+		stream->textCap = stream->textCap ? stream->textCap * 2 : 8;
+		stream->texts = (hl_drawStreamText*)realloc(stream->texts, stream->textCap * sizeof(hl_drawStreamText));
+	}
+
+	if (stream->charCount + len > stream->charCap) {
+		stream->charCap = (stream->charCount + len) * 2;
+		stream->chars = (char*)realloc(stream->chars, stream->charCap);
+	}
+
+	hl_drawStreamText* entry = &stream->texts[stream->textCount];
+	entry->font = font;
+	entry->start = stream->charCount;
+	entry->len = len;
+	entry->x = x;
+	entry->y = y;
+	entry->size = size;
+	entry->color = list->state.color;
+	entry->rotate = list->state.rotate;
+	entry->center = list->state.center;
+	entry->modelMatrix = list->state.modelMatrix;
+	entry->clipped = list->state.clipped;
+	entry->clip = list->state.clip;
+
+	memcpy(&stream->chars[stream->charCount], text, len);
+	stream->charCount += len;
+
+	hl_drawStream_pushChunk(stream, HL_DRAW_CHUNK_TEXT)->batchStart = stream->textCount++;
+}
+
+/* draw the text through the renderer's own font renderer, with the state the list had */
+static void hl_drawStream_text(RSGL_renderer* renderer, const hl_drawStream* stream, const hl_drawStreamText* text) {
+	hl_rendererInfo* info = (hl_rendererInfo*)renderer->userPtr;
+	if (info == NULL || info->renderer_rfont == NULL)
+		return;
+
+	RSGL_renderState save = renderer->state;
+	renderer->state.color = text->color;
+	renderer->state.rotate = text->rotate;
+	renderer->state.center = text->center;
+	renderer->state.modelMatrix = text->modelMatrix;
+	renderer->state.clipped = text->clipped;
+	renderer->state.clip = text->clip;
+	RSGL_renderer_forceBatch(renderer);
+
+	RFont_draw_text_len(info->renderer_rfont, text->font, &stream->chars[text->start], text->len, text->x, text->y, text->size, 0.0f);
+
+	renderer->state = save;
+	RSGL_renderer_forceBatch(renderer);
+}
+
+/* replay the stream on a renderer, batches are copied into its batch and flushed when it runs out of room */
+static void hl_drawStream_execute(RSGL_renderer* renderer, hl_drawStream* stream) {
+	size_t i, j;
+	for (i = 0; i < stream->chunkCount; i++) {
+		const hl_drawChunk* chunk = &stream->chunks[i];
+
+		switch (chunk->type) {
+			case HL_DRAW_CHUNK_CLEAR:
+				RSGL_renderer_clear(renderer, RSGL_RGBA((u8)(chunk->args[0] * 255.0f + 0.5f), (u8)(chunk->args[1] * 255.0f + 0.5f),
+													(u8)(chunk->args[2] * 255.0f + 0.5f), (u8)(chunk->args[3] * 255.0f + 0.5f)));
+				continue;
+			case HL_DRAW_CHUNK_VIEWPORT:
+				RSGL_renderer_render(renderer);
+				RSGL_renderer_updateSize(renderer, (size_t)chunk->args[2], (size_t)chunk->args[3]);
+				RSGL_renderer_viewport(renderer, RSGL_RECT(chunk->args[0], chunk->args[1], chunk->args[2], chunk->args[3]));
+				continue;
+			case HL_DRAW_CHUNK_REQUEST_PIXELS:
+				RSGL_renderer_requestPixels(renderer, RSGL_RECT(chunk->args[0], chunk->args[1], chunk->args[2], chunk->args[3]), (i32)chunk->args[4]);
+				continue;
+			case HL_DRAW_CHUNK_TEXT:
+				hl_drawStream_text(renderer, stream, &stream->texts[chunk->batchStart]);
+				continue;
+			default: break;
+		}
+
+		if (renderer->data.len + chunk->vertCount > RSGL_MAX_VERTS ||
+			renderer->data.elements_count + chunk->elmCount > RSGL_MAX_VERTS * 6 ||
+			renderer->state.buffers->batchCount + chunk->batchCount > RSGL_MAX_BATCHES) {
+			RSGL_renderer_render(renderer);
+		}
+
+		size_t vertBase = renderer->data.len;
+		size_t elmBase = renderer->data.elements_count;
+
+		memcpy(&renderer->data.verts[vertBase * 3], &stream->verts[chunk->vertStart * 3], chunk->vertCount * 3 * sizeof(float));
+		memcpy(&renderer->data.texCoords[vertBase * 2], &stream->texCoords[chunk->vertStart * 2], chunk->vertCount * 2 * sizeof(float));
+		memcpy(&renderer->data.colors[vertBase * 4], &stream->colors[chunk->vertStart * 4], chunk->vertCount * 4 * sizeof(float));
+
+		for (j = 0; j < chunk->elmCount; j++)
+			renderer->data.elements[elmBase + j] = (u16)(stream->elements[chunk->elmStart + j] + vertBase);
+
+		for (j = 0; j < chunk->batchCount; j++) {
+			RSGL_BATCH* batch = &renderer->state.buffers->batches[renderer->state.buffers->batchCount++];
+			*batch = stream->batches[chunk->batchStart + j];
+			batch->start += vertBase;
+			batch->elmStart += elmBase;
+
+			/* recorders don't sort, their batches go in the translucent pass at the depth of their place in the frame */
+			if (renderer->state.depthSort) {
+				float depth = RSGL_renderer_nextDepth(renderer);
+				size_t k;
+				for (k = batch->start; k < batch->start + batch->len; k++)
+					renderer->data.verts[k * 3 + 2] = depth;
+			}
+		}
+
+		renderer->data.len += chunk->vertCount;
+		renderer->data.elements_count += chunk->elmCount;
+	}
+
+	/* the next draw on the renderer shouldn't extend the stream's last batch */
+	RSGL_renderer_forceBatch(renderer);
+
+	hl_drawStream_reset(stream);
+}
+
+static size_t hl_drawList_size(void) { return sizeof(hl_drawListData); }
+
+static void hl_drawList_initPtr(hl_drawListData* ctx, void* parent) {
+	memset(ctx, 0, sizeof(hl_drawListData));
+	ctx->parent = (RSGL_renderer*)parent;
+}
+
+static void hl_drawList_freePtr(hl_drawListData* ctx) {
+	hl_drawStream_free(&ctx->stream);
+}
+
+typedef struct hl_textureCall {
+	RSGL_renderer* renderer;
+	const RSGL_textureBlob* blob;
+	RSGL_texture texture;
+	size_t x, y;
+} hl_textureCall;
+
+static void hl_createTextureCall(void* arg) {
+	hl_textureCall* call = (hl_textureCall*)arg;
+	call->texture = RSGL_renderer_createTexture(call->renderer, call->blob);
+}
+
+static void hl_copyToTextureCall(void* arg) {
+	hl_textureCall* call = (hl_textureCall*)arg;
+	RSGL_renderer_copyToTexture(call->renderer, call->texture, call->x, call->y, call->blob);
+}
+
+static void hl_deleteTextureCall(void* arg) {
+	hl_textureCall* call = (hl_textureCall*)arg;
+	RSGL_renderer_deleteTexture(call->renderer, call->texture);
+}
+
+/* draw lists can only use the parent's textures, RSGL_renderer_initPtr also gets the parent's default texture from here */
+static RSGL_texture hl_drawList_createTexture(hl_drawListData* ctx, const RSGL_textureBlob* blob) {
+	if (ctx->thread == NULL)
+		return ctx->parent->defaultTexture;
+
+	hl_textureCall call = { ctx->parent, blob, 0, 0, 0 };
+	hl_renderThread_call(ctx->thread, hl_createTextureCall, &call);
+	return call.texture;
+}
+
+static void hl_drawList_copyToTexture(hl_drawListData* ctx, RSGL_texture texture, size_t x, size_t y, const RSGL_textureBlob* blob) {
+	if (ctx->thread == NULL)
+		return;
+
+	hl_textureCall call = { ctx->parent, blob, texture, x, y };
+	hl_renderThread_call(ctx->thread, hl_copyToTextureCall, &call);
+}
+
+static void hl_drawList_deleteTexture(hl_drawListData* ctx, RSGL_texture texture) {
+	if (ctx->thread == NULL)
+		return;
+
+	hl_textureCall call = { ctx->parent, NULL, texture, 0, 0 };
+	hl_renderThread_call(ctx->thread, hl_deleteTextureCall, &call);
+}
+
+static void hl_drawList_createBuffer(hl_drawListData* ctx, RSGL_bufferType type, size_t size, const void* data, size_t* buffer) {
+	(void)(type); (void)(size); (void)(data);
+	*buffer = ++ctx->bufferCount;
+}
+
+/* RSGL_renderer_updateRenderBuffers always uploads the full buffers right before rendering */
+static void hl_drawList_updateBuffer(hl_drawListData* ctx, RSGL_bufferType type, size_t buffer, const void* data, size_t start, size_t end) {
+	hl_drawStream* stream = &ctx->stream;
+	(void)(type); (void)(start);
+
+	switch (buffer) {
+		case HL_DRAW_LIST_VERTEX:
+			ctx->pendingVerts = end / (3 * sizeof(float));
+			hl_drawStream_reserve(stream, ctx->pendingVerts, 0);
+			memcpy(&stream->verts[stream->vertCount * 3], data, end);
+			break;
+		case HL_DRAW_LIST_COLOR:
+			memcpy(&stream->colors[stream->vertCount * 4], data, end);
+			break;
+		case HL_DRAW_LIST_TEXTURE:
+			memcpy(&stream->texCoords[stream->vertCount * 2], data, end);
+			break;
+		case HL_DRAW_LIST_ELEMENTS:
+			ctx->pendingElms = end / sizeof(u16);
+			hl_drawStream_reserve(stream, 0, ctx->pendingElms);
+			memcpy(&stream->elements[stream->elmCount], data, end);
+			break;
+		default: break;
+	}
+}
+
+static void hl_drawList_render(hl_drawListData* ctx, const RSGL_renderPass* pass) {
+	hl_drawStream* stream = &ctx->stream;
+	if (pass->buffers->batchCount == 0)
+		return;
+
+	if (stream->batchCount + pass->buffers->batchCount > stream->batchCap) {
+		stream->batchCap = (stream->batchCount + pass->buffers->batchCount) * 2;
+		stream->batches = (RSGL_BATCH*)realloc(stream->batches, stream->batchCap * sizeof(RSGL_BATCH));
+	}
+
+	hl_drawChunk* chunk = hl_drawStream_pushChunk(stream, HL_DRAW_CHUNK_BATCHES);
+	chunk->vertStart = stream->vertCount;
+	chunk->vertCount = ctx->pendingVerts;
+	chunk->elmStart = stream->elmCount;
+	chunk->elmCount = ctx->pendingElms;
+	chunk->batchStart = stream->batchCount;
+	chunk->batchCount = pass->buffers->batchCount;
+
+	memcpy(&stream->batches[stream->batchCount], pass->buffers->batches, pass->buffers->batchCount * sizeof(RSGL_BATCH));
+
+	stream->vertCount += ctx->pendingVerts;
+	stream->elmCount += ctx->pendingElms;
+	stream->batchCount += pass->buffers->batchCount;
+	ctx->pendingVerts = 0;
+	ctx->pendingElms = 0;
+}
+
+static void hl_drawList_clear(hl_drawListData* ctx, RSGL_framebuffer framebuffer, float r, float g, float b, float a) {
+	(void)(framebuffer);
+
+	hl_drawChunk* chunk = hl_drawStream_pushChunk(&ctx->stream, HL_DRAW_CHUNK_CLEAR);
+	chunk->args[0] = r;
+	chunk->args[1] = g;
+	chunk->args[2] = b;
+	chunk->args[3] = a;
+}
+
+static void hl_drawList_viewport(hl_drawListData* ctx, i32 x, i32 y, i32 w, i32 h) {
+	hl_drawChunk* chunk = hl_drawStream_pushChunk(&ctx->stream, HL_DRAW_CHUNK_VIEWPORT);
+	chunk->args[0] = (float)x;
+	chunk->args[1] = (float)y;
+	chunk->args[2] = (float)w;
+	chunk->args[3] = (float)h;
+}
+
+static void hl_drawList_requestPixels(hl_drawListData* ctx, i32 x, i32 y, i32 w, i32 h, float renderer_height) {
+	hl_drawChunk* chunk = hl_drawStream_pushChunk(&ctx->stream, HL_DRAW_CHUNK_REQUEST_PIXELS);
+	chunk->args[0] = (float)x;
+	chunk->args[1] = (float)y;
+	chunk->args[2] = (float)w;
+	chunk->args[3] = (float)h;
+	chunk->args[4] = renderer_height;
+}
+
+typedef struct hl_fetchPixelsCall {
+	RSGL_renderer* renderer;
+	u8* data;
+	RSGL_bool wait;
+	RSGL_bool result;
+} hl_fetchPixelsCall;
+
+static void hl_fetchPixelsProc(void* arg) {
+	hl_fetchPixelsCall* call = (hl_fetchPixelsCall*)arg;
+	call->result = RSGL_renderer_fetchPixels(call->renderer, call->data, call->wait);
+}
+
+static RSGL_bool hl_drawList_fetchPixels(hl_drawListData* ctx, u8* data, RSGL_bool wait) {
+	if (ctx->thread == NULL)
+		return RSGL_FALSE;
+
+	/* the request is still queued, don't block on the render thread */
+	if (wait == RSGL_FALSE) {
+		hl_lockMutex(ctx->thread->lock);
+		size_t count = ctx->thread->count;
+		hl_unlockMutex(ctx->thread->lock);
+
+		if (count)
+			return RSGL_FALSE;
+	}
+
+	hl_fetchPixelsCall call = { ctx->parent, data, wait, RSGL_FALSE };
+	hl_renderThread_call(ctx->thread, hl_fetchPixelsProc, &call);
+	return call.result;
+}
+
+/* hand what was recorded so far to the render thread and wait for the read back */
+static void hl_drawList_readPixels(hl_drawListData* ctx, i32 x, i32 y, i32 w, i32 h, float renderer_height, u8* data) {
+	if (ctx->thread == NULL)
+		return;
+
+	hl_drawList_requestPixels(ctx, x, y, w, h, renderer_height);
+	hl_renderThread_submit(ctx->thread, ctx, false);
+	hl_drawList_fetchPixels(ctx, data, RSGL_TRUE);
+}
+
+/* RSGL calls these without checking for NULL, there is nothing to record for them */
+static void hl_drawList_scissorStart(hl_drawListData* ctx, float x, float y, float w, float h, float renderer_height) { (void)(ctx); (void)(x); (void)(y); (void)(w); (void)(h); (void)(renderer_height); }
+static void hl_drawList_scissorEnd(hl_drawListData* ctx) { (void)(ctx); }
+
+static RSGL_rendererProc hl_drawList_rendererProc(void) {
+	RSGL_rendererProc proc;
+	memset(&proc, 0, sizeof(proc));
+
+	proc.size = hl_drawList_size;
+	proc.initPtr = (void (*)(void*, void*))hl_drawList_initPtr;
+	proc.freePtr = (void (*)(void*))hl_drawList_freePtr;
+	proc.render = (void (*)(void*, const RSGL_renderPass*))hl_drawList_render;
+	proc.clear = (void (*)(void*, RSGL_framebuffer, float, float, float, float))hl_drawList_clear;
+	proc.viewport = (void (*)(void*, i32, i32, i32, i32))hl_drawList_viewport;
+	proc.createTexture = (RSGL_texture (*)(void*, const RSGL_textureBlob*))hl_drawList_createTexture;
+	proc.copyToTexture = (void (*)(void*, RSGL_texture, size_t, size_t, const RSGL_textureBlob*))hl_drawList_copyToTexture;
+	proc.deleteTexture = (void (*)(void*, RSGL_texture))hl_drawList_deleteTexture;
+	proc.scissorStart = (void (*)(void*, float, float, float, float, float))hl_drawList_scissorStart;
+	proc.scissorEnd = (void (*)(void*))hl_drawList_scissorEnd;
+	proc.createBuffer = (void (*)(void*, RSGL_bufferType, size_t, const void*, size_t*))hl_drawList_createBuffer;
+	proc.updateBuffer = (void (*)(void*, RSGL_bufferType, size_t, void*, size_t, size_t))hl_drawList_updateBuffer;
+	proc.readPixels = (void (*)(void*, i32, i32, i32, i32, float, u8*))hl_drawList_readPixels;
+	proc.requestPixels = (void (*)(void*, i32, i32, i32, i32, float))hl_drawList_requestPixels;
+	proc.fetchPixels = (RSGL_bool (*)(void*, u8*, RSGL_bool))hl_drawList_fetchPixels;
+	return proc;
+}
+
+/* drop anything recorded since the list was last merged */
+static void hl_drawList_reset(RSGL_renderer* list) {
+	hl_drawListData* ctx = (hl_drawListData*)list->ctx;
+
+	list->data.len = 0;
+	list->data.elements_count = 0;
+	list->state.buffers->batchCount = 0;
+	ctx->pendingVerts = 0;
+	ctx->pendingElms = 0;
+	hl_drawStream_reset(&ctx->stream);
+
+	RSGL_renderer_setTexture(list, 0);
+}
+
+/* lists don't own an atlas, the text is kept in the stream in order with the geometry around it */
+static void hl_drawList_text(RSGL_renderer* list, hl_fontHandle font, const char* text, size_t len, int32_t x, int32_t y, int32_t size) {
+	if (font == NULL || len == 0)
+		return;
+
+	RSGL_renderer_render(list);
+	hl_drawStream_pushText(&((hl_drawListData*)list->ctx)->stream, list, (RFont_font*)font, text, len, (float)x, (float)y, (u32)size);
+}
+
+static void hl_mergeDrawList(RSGL_renderer* renderer, RSGL_renderer* list) {
+	RSGL_renderer_render(list);
+	hl_drawStream_execute(renderer, &((hl_drawListData*)list->ctx)->stream);
+}
+
+static void hl_renderThreadProc(void* arg) {
+	hl_renderThread* thread = (hl_renderThread*)arg;
+	hl_makeCurrentContext(thread->window);
+
+	hl_lockMutex(thread->lock);
+	for (;;) {
+		if (thread->count) {
+			/* the app thread doesn't touch queued streams, so they're replayed without holding the lock */
+			hl_drawStream* stream = &thread->queue[thread->head];
+			bool present = thread->present[thread->head];
+			hl_unlockMutex(thread->lock);
+
+			hl_drawStream_execute(thread->renderer, stream);
+			RSGL_renderer_render(thread->renderer);
+			if (present)
+				hl_swapBuffers(thread->window);
+
+			hl_lockMutex(thread->lock);
+			thread->head = (thread->head + 1) % HL_MAX_FRAME_LATENCY;
+			thread->count -= 1;
+			hl_broadcastCondition(thread->cond);
+		} else if (thread->callFunc && thread->callDone == false) {
+			hl_threadFunc func = thread->callFunc;
+			void* callArg = thread->callArg;
+			hl_unlockMutex(thread->lock);
+
+			func(callArg);
+
+			hl_lockMutex(thread->lock);
+			thread->callDone = true;
+			hl_broadcastCondition(thread->cond);
+		} else if (thread->quit) {
+			break;
+		} else {
+			hl_waitCondition(thread->cond, thread->lock);
+		}
+	}
+	hl_unlockMutex(thread->lock);
+
+	hl_makeCurrentContext(NULL);
+}
+
+/* run a function on the render thread after every queued frame and wait for it */
+static void hl_renderThread_call(hl_renderThread* thread, hl_threadFunc func, void* arg) {
+	hl_lockMutex(thread->lock);
+	thread->callFunc = func;
+	thread->callArg = arg;
+	thread->callDone = false;
+	hl_broadcastCondition(thread->cond);
+
+	while (thread->callDone == false)
+		hl_waitCondition(thread->cond, thread->lock);
+
+	thread->callFunc = NULL;
+	hl_unlockMutex(thread->lock);
+}
+
+/* queue the recorded stream, waiting while the render thread is already `latency` frames behind */
+static void hl_renderThread_submit(hl_renderThread* thread, hl_drawListData* ctx, bool present) {
+	hl_lockMutex(thread->lock);
+	while (thread->count >= thread->latency)
+		hl_waitCondition(thread->cond, thread->lock);
+
+	/* the slot holds the empty buffers of a replayed frame, the recorder reuses them */
+	size_t slot = (thread->head + thread->count) % HL_MAX_FRAME_LATENCY;
+	hl_drawStream stream = thread->queue[slot];
+	thread->queue[slot] = ctx->stream;
+	ctx->stream = stream;
+
+	thread->present[slot] = present;
+	thread->count += 1;
+	hl_broadcastCondition(thread->cond);
+	hl_unlockMutex(thread->lock);
+}
+
+static void hl_freeRendererCall(void* arg) {
+	RSGL_renderer_free((RSGL_renderer*)arg);
+}
+
+static void hl_stopRenderThread(hl_renderThread* thread) {
+	hl_renderThread_call(thread, hl_freeRendererCall, thread->renderer);
+
+	hl_lockMutex(thread->lock);
+	thread->quit = true;
+	hl_broadcastCondition(thread->cond);
+	hl_unlockMutex(thread->lock);
+
+	hl_joinThread(thread->thread);
+
+	size_t i;
+	for (i = 0; i < HL_MAX_FRAME_LATENCY; i++)
+		hl_drawStream_free(&thread->queue[i]);
+
+	hl_freeCondition(thread->cond);
+	hl_freeMutex(thread->lock);
+	free(thread);
+}
+
+void hl_startRenderThread(hl_windowHandle window) {
+	RSGL_renderer* renderer = (RSGL_renderer*)hl_getWindowRenderer(window);
+	hl_rendererInfo* info = (hl_rendererInfo*)renderer->userPtr;
+
+	/* RFont is recreated on the recording renderer, so its textures are made through the render thread */
+	RFont_RSGL_renderer_free(info->renderer_rfont);
+	hl_makeCurrentContext(NULL);
+
+	hl_renderThread* thread = (hl_renderThread*)malloc(sizeof(hl_renderThread));
+	memset(thread, 0, sizeof(hl_renderThread));
+	thread->window = window;
+	thread->renderer = renderer;
+	thread->latency = 1;
+	thread->lock = hl_createMutex();
+	thread->cond = hl_createCondition();
+	thread->thread = hl_createThread(hl_renderThreadProc, thread);
+
+	RSGL_renderer* recorder = RSGL_renderer_init(hl_drawList_rendererProc(), (void*)renderer);
+	((hl_drawListData*)recorder->ctx)->thread = thread;
+
+	renderer->userPtr = NULL;
+	recorder->userPtr = info;
+	info->renderThread = thread;
+	info->renderer_rfont = RFont_RSGL_renderer_init(recorder);
+
+	hl_setWindowRenderer(window, recorder);
+	hl_updateRendererSize(window);
+}
+
+bool hl_runOnRenderThread(hl_windowHandle window, hl_threadFunc func, void* arg) {
+	RSGL_renderer* renderer = (RSGL_renderer*)hl_getWindowRenderer(window);
+	if (renderer == NULL)
+		return false;
+
+	hl_rendererInfo* info = (hl_rendererInfo*)renderer->userPtr;
+	if (info->renderThread == NULL)
+		return false;
+
+	hl_renderThread_call(info->renderThread, func, arg);
+	return true;
+}
+
+void hl_setFrameLatency(hl_windowHandle window, uint32_t frames) {
+	RSGL_renderer* renderer = (RSGL_renderer*)hl_getWindowRenderer(window);
+	if (hl_activeCapture)
+		hl_recordValue(window, HL_CAPTURE_SET_FRAME_LATENCY, frames);
+
+	hl_rendererInfo* info = (hl_rendererInfo*)renderer->userPtr;
+	if (info->renderThread == NULL)
+		return;
+
+	if (frames < 1) frames = 1;
+	if (frames > HL_MAX_FRAME_LATENCY) frames = HL_MAX_FRAME_LATENCY;
+
+	hl_lockMutex(info->renderThread->lock);
+	info->renderThread->latency = frames;
+	hl_broadcastCondition(info->renderThread->cond);
+	hl_unlockMutex(info->renderThread->lock);
+}
+
+void hl_setProgramCacheDirectory(const char* path) {
+	RSGL_GL_setProgramCache(path);
+}
+
 hl_rendererHandle hl_initRenderer(uint32_t type, hl_windowHandle window) {
+	return hl_initSharedRenderer(type, window, NULL);
+}
+
+hl_rendererHandle hl_initSharedRenderer(uint32_t type, hl_windowHandle window, hl_windowHandle share) {
 	RSGL_renderer* renderer = NULL;
 
+	/* the share group already has the default program and texture, only the per context state (VAO, buffers) is new */
+	const RSGL_renderer* shared = NULL;
+	if (share && hl_getWindowRenderer(share)) {
+		shared = (const RSGL_renderer*)hl_getWindowRenderer(share);
+		hl_rendererInfo* shareInfo = (hl_rendererInfo*)shared->userPtr;
+
+		/* a render thread's recorder doesn't own GL objects, the renderer behind it does */
+		if (shareInfo->renderThread)
+			shared = shareInfo->renderThread->renderer;
+		if (shareInfo->type != type)
+			shared = NULL;
+	}
+
 	switch (type) {
 		case HL_RENDERER_GL_MODERN:
-			renderer = RSGL_renderer_init(RSGL_GL_rendererProc(), (void*)hl_getProcAddress);
+			renderer = RSGL_renderer_initShared(RSGL_GL_rendererProc(), (void*)hl_getProcAddress, shared);
 			break;
 		case HL_RENDERER_GL_LEGACY:
-			renderer = RSGL_renderer_init(RSGL_GL1_rendererProc(), (void*)hl_getProcAddress);
+			renderer = RSGL_renderer_initShared(RSGL_GL1_rendererProc(), (void*)hl_getProcAddress, shared);
+			break;
+		case HL_RENDERER_SOFTWARE:
+			renderer = RSGL_renderer_initShared(RSGL_SW_rendererProc(), NULL, shared);
 			break;
 		default: break;
 	}
@@ -34,6 +768,10 @@ hl_rendererHandle hl_initRenderer(uint32_t type, hl_windowHandle window) {
 	hl_setWindowRenderer(window, renderer);
 
 	hl_rendererInfo* info = (hl_rendererInfo*)malloc(sizeof(hl_rendererInfo));
+	memset(info, 0, sizeof(hl_rendererInfo));
+	info->type = type;
+	info->decimatePolylines = true;
+	info->prewarmBudget = HL_PREWARM_BUDGET;
 	info->renderer_rfont = RFont_RSGL_renderer_init(renderer);
 	renderer->userPtr = info;
 
@@ -50,6 +788,22 @@ void hl_updateRendererSize(hl_windowHandle window) {
 	int32_t w, h;
 	hl_getWindowSize(window, &w, &h);
 
+	if (info->type == HL_RENDERER_SOFTWARE && (info->swSurface.width != w || info->swSurface.height != h)) {
+		if (info->surface)
+			hl_freeSurface(info->surface);
+		if (info->swSurface.pixels)
+			free(info->swSurface.pixels);
+
+		info->swSurface.pixels = (u32*)malloc((size_t)w * (size_t)h * sizeof(u32));
+		info->swSurface.width = w;
+		info->swSurface.height = h;
+		info->swSurface.stride = w;
+		if (hl_isWindowHeadless(window) == false)
+			info->surface = hl_createSurface(window, (uint8_t*)info->swSurface.pixels, w, h);
+
+		RSGL_renderer_setSurface((RSGL_renderer*)renderer, &info->swSurface);
+	}
+
 	RFont_renderer_set_framebuffer(info->renderer_rfont, (u32)w, (u32)h);
 	RSGL_renderer_updateSize((RSGL_renderer*)renderer, w, h);
 	RSGL_renderer_viewport((RSGL_renderer*)renderer, RSGL_RECT(0, 0, w, h));
@@ -59,9 +813,34 @@ void hl_freeRenderer(hl_windowHandle window) {
 	hl_rendererHandle renderer = hl_getWindowRenderer(window);
 	hl_rendererInfo* info = (hl_rendererInfo*)((RSGL_renderer*)renderer)->userPtr;
 
-	RFont_RSGL_renderer_free(info->renderer_rfont);
+	if (hl_activeCapture)
+		hl_captureWindowClosed(window);
+
+	/* draw lists don't outlive their window */
+	while (info->drawListCount)
+		hl_releaseDrawList(window, info->drawLists[info->drawListCount - 1]);
+	free(info->drawLists);
+
+	hl_cancelPrewarm(info, NULL);
+
+	/* the VAO and buffers belong to this window's context, with several windows another one may be current */
+	if (info->type != HL_RENDERER_SOFTWARE && info->renderThread == NULL && hl_isWindowHeadless(window) == false)
+		hl_makeCurrentContext(window);
+
+	if (info->renderer_rfont)
+		RFont_RSGL_renderer_free(info->renderer_rfont);
 
 	RSGL_renderer_free((RSGL_renderer*)renderer);
+
+	if (info->renderThread)
+		hl_stopRenderThread(info->renderThread);
+	if (info->surface)
+		hl_freeSurface(info->surface);
+	if (info->swSurface.pixels)
+		free(info->swSurface.pixels);
+
+	free(info->polyline);
+	free(info->opaqueTextures);
 	free(info);
 }
 
@@ -69,90 +848,733 @@ hl_fontHandle hl_loadFont(hl_windowHandle window, const char* name, uint32_t max
 	hl_rendererHandle renderer = hl_getWindowRenderer(window);
 	hl_rendererInfo* info = (hl_rendererInfo*)((RSGL_renderer*)renderer)->userPtr;
 
-    RFont_font* font = RFont_font_init(info->renderer_rfont, name, maxHeight, maxHeight * 100, maxHeight * 100);
+	/* the face is mapped once and shared by every font loaded from the same path, in any window */
+	RFont_font* font = RFont_font_init(info->renderer_rfont, name, maxHeight, maxHeight * 100, maxHeight * 100);
+	if (font && hl_activeCapture)
+		hl_recordFont(window, (hl_fontHandle)font, name, NULL, 0, maxHeight);
+
+	return (hl_fontHandle)font;
+}
+
+hl_fontHandle hl_loadFontFromMemory(hl_windowHandle window, const uint8_t* data, size_t size, uint32_t maxHeight) {
+	hl_rendererHandle renderer = hl_getWindowRenderer(window);
+	hl_rendererInfo* info = (hl_rendererInfo*)((RSGL_renderer*)renderer)->userPtr;
+
+	RFont_src* src = RFont_src_init_data(data, size, false);
+	RFont_font* font = RFont_font_init_src(info->renderer_rfont, src, maxHeight, maxHeight * 100, maxHeight * 100);
+	RFont_src_release(src);
+	if (font && hl_activeCapture)
+		hl_recordFont(window, (hl_fontHandle)font, NULL, data, size, maxHeight);
 
-	return (hl_rendererHandle)font;
+	return (hl_fontHandle)font;
 }
 
 void hl_releaseFont(hl_windowHandle window, hl_fontHandle font) {
 	hl_rendererHandle renderer = hl_getWindowRenderer(window);
 	hl_rendererInfo* info = (hl_rendererInfo*)((RSGL_renderer*)renderer)->userPtr;
-    RFont_font_free(info->renderer_rfont, (RFont_font*)font);
+
+	if (hl_activeCapture)
+		hl_recordHandle(window, HL_CAPTURE_RELEASE_FONT, font);
+
+	hl_cancelPrewarm(info, (RFont_font*)font);
+	RFont_font_free(info->renderer_rfont, (RFont_font*)font);
 }
 
+/* glyphs a prewarm worker may rasterize ahead of hl_startFrame */
+#define HL_PREWARM_QUEUE_SIZE 256
+
+typedef struct hl_prewarmGlyph {
+	RFont_glyph glyph;
+	u8* bitmap; /* owned by the slot and reused, the rasterizer's bitmap lives in the worker's arena */
+	size_t bitmapCap;
+} hl_prewarmGlyph;
+
+/*
+ * the worker only reads the font's face, which doesn't change after loading,
+ * the glyph table and the atlas are only written by the window's thread when it commits
+*/
+typedef struct hl_prewarmJob {
+	RFont_font* font;
+	hl_codepointRange* ranges;
+	size_t rangeCount;
+	uint32_t* sizes;
+	size_t sizeCount;
+
+	size_t total; /* glyphs requested */
+	size_t committed; /* glyphs taken out of the queue */
+	volatile size_t skipped; /* written by the worker, glyphs the font doesn't have */
+	volatile size_t finished; /* set by the worker after its last push */
+	volatile size_t cancel;
+
+	/* guarded by the mutex */
+	hl_prewarmGlyph queue[HL_PREWARM_QUEUE_SIZE];
+	size_t head, tail;
+
+	hl_mutex* mutex;
+	hl_condition* space; /* broadcast when a glyph is taken out of the queue or the job is canceled */
+	hl_thread* thread;
+
+	struct hl_prewarmJob* next;
+} hl_prewarmJob;
+
+static void hl_prewarmWorker(void* arg) {
+	hl_prewarmJob* job = (hl_prewarmJob*)arg;
+	size_t r, i;
+
+	for (r = 0; r < job->rangeCount; r++) {
+		uint32_t codepoint = job->ranges[r].first;
+
+		for (;;) {
+			for (i = 0; i < job->sizeCount; i++) {
+				if (hl_atomicLoad(&job->cancel))
+					goto done;
+
+				RFont_glyph glyph;
+				u8* bitmap;
+				if (RFont_font_rasterize_codepoint(job->font, codepoint, job->sizes[i], &glyph, &bitmap) == false) {
+					hl_atomicStore(&job->skipped, job->skipped + 1);
+					continue;
+				}
+
+				hl_lockMutex(job->mutex);
+				while (job->tail - job->head == HL_PREWARM_QUEUE_SIZE && job->cancel == 0)
+					hl_waitCondition(job->space, job->mutex);
+
+				bool cancel = job->cancel != 0;
+				hl_unlockMutex(job->mutex);
+
+				if (cancel) {
+					RFONT_TEMP_FREE(bitmap);
+					goto done;
+				}
+
+				/* the window's thread doesn't look at the slot until tail moves past it */
+				hl_prewarmGlyph* entry = &job->queue[job->tail % HL_PREWARM_QUEUE_SIZE];
+				size_t size = (size_t)glyph.w * (size_t)glyph.h;
+				if (size > entry->bitmapCap) {
+					entry->bitmapCap = size;
+					entry->bitmap = (u8*)realloc(entry->bitmap, size);
+				}
+
+				if (bitmap)
+					memcpy(entry->bitmap, bitmap, size);
+				entry->glyph = glyph;
+				RFONT_TEMP_FREE(bitmap);
+
+				hl_lockMutex(job->mutex);
+				job->tail += 1;
+				hl_unlockMutex(job->mutex);
+			}
+
+			/* checked before incrementing so a range ending at UINT32_MAX doesn't wrap */
+			if (codepoint == job->ranges[r].last)
+				break;
+			codepoint += 1;
+		}
+	}
+
+done:
+	hl_atomicStore(&job->finished, 1);
+}
+
+static void hl_freePrewarmJob(hl_prewarmJob* job) {
+	hl_atomicStore(&job->cancel, 1);
+
+	hl_lockMutex(job->mutex);
+	hl_broadcastCondition(job->space);
+	hl_unlockMutex(job->mutex);
+
+	hl_joinThread(job->thread);
+
+	size_t i;
+	for (i = 0; i < HL_PREWARM_QUEUE_SIZE; i++)
+		free(job->queue[i].bitmap);
+
+	hl_freeCondition(job->space);
+	hl_freeMutex(job->mutex);
+	free(job->ranges);
+	free(job->sizes);
+	free(job);
+}
+
+/* stops the jobs prewarming the font, or every job if it's NULL */
+static void hl_cancelPrewarm(hl_rendererInfo* info, RFont_font* font) {
+	hl_prewarmJob** link = &info->prewarmJobs;
+	while (*link) {
+		hl_prewarmJob* job = *link;
+		if (font && job->font != font) {
+			link = &job->next;
+			continue;
+		}
+
+		*link = job->next;
+		hl_freePrewarmJob(job);
+	}
+}
+
+/* called by hl_startFrame with the window's context current */
+static void hl_commitPrewarmedGlyphs(hl_rendererInfo* info) {
+	double start = hl_getTime();
+	bool first = true;
+
+	hl_prewarmJob** link = &info->prewarmJobs;
+	while (*link) {
+		hl_prewarmJob* job = *link;
+		RFont_font* font = job->font;
+
+		/* read before looking at the queue, everything the worker pushed is in it once this is set */
+		bool finished = hl_atomicLoad(&job->finished) != 0;
+		bool empty = false;
+
+		while (first || hl_getTime() - start < info->prewarmBudget) {
+			hl_lockMutex(job->mutex);
+			empty = job->head == job->tail;
+			hl_unlockMutex(job->mutex);
+
+			if (empty)
+				break;
+
+			/* the slot stays ours until head moves past it */
+			hl_prewarmGlyph* entry = &job->queue[job->head % HL_PREWARM_QUEUE_SIZE];
+
+			/* text drawn since the request may have added it already */
+			size_t i;
+			for (i = 0; i < font->glyph_len; i++)
+				if (font->glyphs[i].codepoint == entry->glyph.codepoint && font->glyphs[i].size == entry->glyph.size)
+					break;
+
+			if (i == font->glyph_len)
+				RFont_font_commit_glyph(info->renderer_rfont, font, &entry->glyph, entry->bitmap);
+
+			hl_lockMutex(job->mutex);
+			job->head += 1;
+			hl_broadcastCondition(job->space);
+			hl_unlockMutex(job->mutex);
+
+			job->committed += 1;
+			first = false;
+
+			/* nothing else fits, the rest of the job would be thrown away */
+			if (font->glyph_len >= RFONT_MAX_GLYPHS) {
+				hl_atomicStore(&job->cancel, 1);
+				finished = true;
+				empty = true;
+				break;
+			}
+		}
 
+		if (finished && empty) {
+			*link = job->next;
+			hl_freePrewarmJob(job);
+			continue;
+		}
+
+		link = &job->next;
+	}
+}
+
+bool hl_prewarmFont(hl_windowHandle window, hl_fontHandle font, const hl_codepointRange* ranges, size_t rangeCount, const uint32_t* sizes, size_t sizeCount) {
+	hl_rendererHandle renderer = hl_getWindowRenderer(window);
+	hl_rendererInfo* info = (hl_rendererInfo*)((RSGL_renderer*)renderer)->userPtr;
+
+	if (info->parent || font == NULL)
+		return false;
+
+	if (hl_activeCapture)
+		hl_recordPrewarm(window, font, ranges, rangeCount, sizes, sizeCount);
+
+	hl_prewarmJob* job = (hl_prewarmJob*)malloc(sizeof(hl_prewarmJob));
+	memset(job, 0, sizeof(hl_prewarmJob));
+	job->font = (RFont_font*)font;
+
+	size_t i;
+	for (i = 0; i < rangeCount; i++) {
+		if (ranges[i].first > ranges[i].last)
+			continue;
+
+		if (job->rangeCount == 0)
+			job->ranges = (hl_codepointRange*)malloc(rangeCount * sizeof(hl_codepointRange));
+		job->ranges[job->rangeCount++] = ranges[i];
+		job->total += ((size_t)ranges[i].last - ranges[i].first + 1) * sizeCount;
+	}
+
+	if (job->total == 0) {
+		free(job->ranges);
+		free(job);
+		return true;
+	}
+
+	job->sizes = (uint32_t*)malloc(sizeCount * sizeof(uint32_t));
+	memcpy(job->sizes, sizes, sizeCount * sizeof(uint32_t));
+	job->sizeCount = sizeCount;
+
+	job->mutex = hl_createMutex();
+	job->space = hl_createCondition();
+	job->thread = hl_createThread(hl_prewarmWorker, job);
+	if (job->thread == NULL) {
+		hl_freeCondition(job->space);
+		hl_freeMutex(job->mutex);
+		free(job->ranges);
+		free(job->sizes);
+		free(job);
+		return false;
+	}
+
+	hl_prewarmJob** link = &info->prewarmJobs;
+	while (*link)
+		link = &(*link)->next;
+	*link = job;
+	return true;
+}
+
+float hl_getPrewarmProgress(hl_windowHandle window, hl_fontHandle font) {
+	hl_rendererHandle renderer = hl_getWindowRenderer(window);
+	hl_rendererInfo* info = (hl_rendererInfo*)((RSGL_renderer*)renderer)->userPtr;
+
+	size_t done = 0, total = 0;
+	hl_prewarmJob* job;
+	for (job = info->prewarmJobs; job; job = job->next) {
+		if (font && job->font != (RFont_font*)font)
+			continue;
+
+		done += job->committed + hl_atomicLoad(&job->skipped);
+		total += job->total;
+	}
+
+	if (total == 0)
+		return 1.0f;
+
+	return (float)((double)done / (double)total);
+}
+
+void hl_setPrewarmBudget(hl_windowHandle window, double seconds) {
+	hl_rendererHandle renderer = hl_getWindowRenderer(window);
+	hl_rendererInfo* info = (hl_rendererInfo*)((RSGL_renderer*)renderer)->userPtr;
+	info->prewarmBudget = seconds;
+
+	if (hl_activeCapture)
+		hl_recordValue(window, HL_CAPTURE_SET_PREWARM_BUDGET, seconds);
+}
+
+
+
+static bool hl_isTextureOpaque(const hl_rendererInfo* info, RSGL_texture texture) {
+	size_t i;
+	for (i = 0; i < info->opaqueTextureCount; i++) {
+		if (info->opaqueTextures[i] == texture)
+			return true;
+	}
+	return false;
+}
+
+static void hl_addOpaqueTexture(hl_rendererInfo* info, RSGL_texture texture) {
+	if (info->opaqueTextureCount >= info->opaqueTextureCap) {
+		info->opaqueTextureCap = info->opaqueTextureCap ? info->opaqueTextureCap * 2 : 8;
+		info->opaqueTextures = (RSGL_texture*)realloc(info->opaqueTextures, info->opaqueTextureCap * sizeof(RSGL_texture));
+	}
+	info->opaqueTextures[info->opaqueTextureCount++] = texture;
+}
+
+static bool hl_isAlphaOpaque(const u8* rgba, size_t count) {
+	size_t i;
+	for (i = 0; i < count; i++) {
+		if (rgba[i * 4 + 3] != 255)
+			return false;
+	}
+	return true;
+}
 
 hl_textureHandle hl_loadTextureFromBlob(hl_windowHandle window, const hl_textureBlob* blob) {
 	hl_rendererHandle renderer = hl_getWindowRenderer(window);
-	return (void*)RSGL_renderer_createTexture(renderer, (RSGL_textureBlob*)blob);
+	hl_rendererInfo* info = (hl_rendererInfo*)((RSGL_renderer*)renderer)->userPtr;
+
+	/* swizzle 3 channel, BGR(A) and gray + alpha data to RGBA on the CPU rather than leaving it to the driver's slow path */
+	if (blob->data && blob->dataType == HL_TEXTURE_DATA_INT &&
+		(blob->dataFormat == HL_FORMAT_RGB || blob->dataFormat == HL_FORMAT_BGR || blob->dataFormat == HL_FORMAT_BGRA ||
+		blob->dataFormat == HL_FORMAT_GRAYSCALEALPHA)) {
+		size_t count = blob->width * blob->height;
+		u8* pixels = (u8*)hl_tempAlloc(count * 4);
+		hl_convertToRGBA(pixels, (const u8*)blob->data, blob->dataFormat, count);
+
+		hl_textureBlob converted = *blob;
+		converted.data = pixels;
+		converted.dataFormat = HL_FORMAT_RGBA;
+		converted.textureFormat = HL_FORMAT_RGBA;
+
+		size_t texture = RSGL_renderer_createTexture(renderer, (RSGL_textureBlob*)&converted);
+		bool hasAlpha = (blob->dataFormat == HL_FORMAT_BGRA || blob->dataFormat == HL_FORMAT_GRAYSCALEALPHA);
+		if (texture && (hasAlpha == false || hl_isAlphaOpaque(pixels, count)))
+			hl_addOpaqueTexture(info, texture);
+
+		hl_tempFree(pixels);
+		if (texture && hl_activeCapture)
+			hl_recordTexture(window, (hl_textureHandle)texture, blob);
+		return (void*)texture;
+	}
+
+	size_t texture = RSGL_renderer_createTexture(renderer, (RSGL_textureBlob*)blob);
+	if (texture && blob->data && blob->dataType == HL_TEXTURE_DATA_INT && blob->dataFormat == HL_FORMAT_RGBA &&
+		hl_isAlphaOpaque((const u8*)blob->data, blob->width * blob->height))
+		hl_addOpaqueTexture(info, texture);
+
+	if (texture && hl_activeCapture)
+		hl_recordTexture(window, (hl_textureHandle)texture, blob);
+
+	return (void*)texture;
 }
 
 hl_textureHandle hl_loadTextureFromImage(hl_windowHandle window, const char* file) {
 	hl_rendererHandle renderer = hl_getWindowRenderer(window);
+	hl_rendererInfo* info = (hl_rendererInfo*)((RSGL_renderer*)renderer)->userPtr;
 	int w, h, c;
     u8* data = stbi_load(file, &w, &h, &c, 0);
+	if (data == NULL)
+		return NULL;
+
+	size_t count = (size_t)w * (size_t)h;
+	u8* pixels = data;
 
 	RSGL_textureBlob blob;
-	blob.data = data;
+	RSGL_MEMSET(&blob, 0, sizeof(blob));
 	blob.width = w;
 	blob.height = h;
 	blob.dataType = RSGL_textureDataInt;
-	blob.dataFormat = (c == 4) ? RSGL_formatRGBA : RSGL_formatRGB;
+	blob.dataFormat = RSGL_formatRGBA;
+
+	switch (c) {
+		case 1:
+			blob.dataFormat = RSGL_formatGrayscale;
+			break;
+		case 2:
+			pixels = (u8*)hl_tempAlloc(count * 4);
+			hl_getPixelOps()->grayAlphaToRGBA(pixels, data, count);
+			break;
+		case 3:
+			pixels = (u8*)hl_tempAlloc(count * 4);
+			hl_getPixelOps()->rgbToRGBA(pixels, data, count);
+			break;
+		default: break;
+	}
+
+	blob.data = pixels;
 	blob.textureFormat = blob.dataFormat;
     size_t texture = RSGL_renderer_createTexture(renderer, &blob);
+	if (texture && (c == 3 || (c == 4 && hl_isAlphaOpaque(data, count))))
+		hl_addOpaqueTexture(info, texture);
+
+	/* the decoded pixels are captured, replaying doesn't need the image file */
+	if (texture && hl_activeCapture)
+		hl_recordTexture(window, (hl_textureHandle)texture, (const hl_textureBlob*)&blob);
 
-    free(data);
+	if (pixels != data)
+		hl_tempFree(pixels);
+	stbi_image_free(data);
 
 	return (void*)texture;
 }
 
 void hl_releaseTexture(hl_windowHandle window, hl_textureHandle texture) {
 	hl_rendererHandle renderer = hl_getWindowRenderer(window);
+	hl_rendererInfo* info = (hl_rendererInfo*)((RSGL_renderer*)renderer)->userPtr;
+
+	if (hl_activeCapture)
+		hl_recordHandle(window, HL_CAPTURE_RELEASE_TEXTURE, texture);
+
+	/* the GL name can be handed out again for a texture that isn't opaque */
+	size_t i;
+	for (i = 0; i < info->opaqueTextureCount; i++) {
+		if (info->opaqueTextures[i] == (RSGL_texture)texture) {
+			info->opaqueTextures[i] = info->opaqueTextures[--info->opaqueTextureCount];
+			break;
+		}
+	}
+
 	RSGL_renderer_deleteTexture(renderer, (size_t)texture);
 }
 
+hl_drawList hl_createDrawList(hl_windowHandle window) {
+	RSGL_renderer* renderer = (RSGL_renderer*)hl_getWindowRenderer(window);
+	hl_rendererInfo* info = (hl_rendererInfo*)renderer->userPtr;
+
+	int32_t w, h;
+	hl_getWindowSize(window, &w, &h);
+
+	/* a list is a bare headless window so every hl_set and hl_draw function works on it unchanged */
+	hl_drawList list = hl_createWindowPlatform(NULL, w, h, HL_WINDOW_HEADLESS, NULL);
+
+	RSGL_renderer* listRenderer = RSGL_renderer_init(hl_drawList_rendererProc(), (void*)renderer);
+	hl_setWindowRenderer(list, listRenderer);
+
+	hl_rendererInfo* listInfo = (hl_rendererInfo*)malloc(sizeof(hl_rendererInfo));
+	memset(listInfo, 0, sizeof(hl_rendererInfo));
+	listInfo->type = info->type;
+	listInfo->decimatePolylines = info->decimatePolylines;
+	listInfo->parent = renderer;
+	listRenderer->userPtr = listInfo;
+
+	if (info->drawListCount >= info->drawListCap) {
+		info->drawListCap = info->drawListCap ? info->drawListCap * 2 : 4;
+		info->drawLists = (hl_drawList*)realloc(info->drawLists, info->drawListCap * sizeof(hl_drawList));
+	}
+
+	info->drawLists[info->drawListCount++] = list;
+
+	if (hl_activeCapture)
+		hl_recordHandle(window, HL_CAPTURE_CREATE_DRAW_LIST, list);
+	return list;
+}
+
+void hl_releaseDrawList(hl_windowHandle window, hl_drawList list) {
+	RSGL_renderer* renderer = (RSGL_renderer*)hl_getWindowRenderer(window);
+	hl_rendererInfo* info = (hl_rendererInfo*)renderer->userPtr;
+
+	if (hl_activeCapture)
+		hl_recordHandle(window, HL_CAPTURE_RELEASE_DRAW_LIST, list);
+
+	size_t i;
+	for (i = 0; i < info->drawListCount; i++) {
+		if (info->drawLists[i] != list)
+			continue;
+
+		/* keep the creation order, it's the merge order */
+		memmove(&info->drawLists[i], &info->drawLists[i + 1], (info->drawListCount - i - 1) * sizeof(hl_drawList));
+		info->drawListCount -= 1;
+		break;
+	}
+
+	hl_closeWindow(list);
+}
+
 void hl_startFrame(hl_windowHandle window) {
 	hl_rendererHandle renderer = hl_getWindowRenderer(window);
 	assert(renderer);
 
-	hl_makeCurrentContext(window);
+	if (hl_activeCapture)
+		hl_recordOp(window, HL_CAPTURE_START_FRAME);
+
+	hl_rendererInfo* info = (hl_rendererInfo*)((RSGL_renderer*)renderer)->userPtr;
+	if (info->type != HL_RENDERER_SOFTWARE && info->renderThread == NULL)
+		hl_makeCurrentContext(window);
+
+	hl_resetFrameArena();
 
 	hl_setTexture(window, 0);
+
+	info->clipDepth = 0;
+	RSGL_renderer_resetClip((RSGL_renderer*)renderer);
+
+	if (info->prewarmJobs)
+		hl_commitPrewarmedGlyphs(info);
+
+	/* drop anything a draw list recorded after the last hl_finishFrame */
+	size_t i;
+	for (i = 0; i < info->drawListCount; i++)
+		hl_drawList_reset((RSGL_renderer*)hl_getWindowRenderer(info->drawLists[i]));
 }
 
 void hl_finishFrame(hl_windowHandle window) {
 	hl_rendererHandle renderer = hl_getWindowRenderer(window);
+	hl_rendererInfo* info = (hl_rendererInfo*)((RSGL_renderer*)renderer)->userPtr;
+
+	if (hl_activeCapture)
+		hl_recordOp(window, HL_CAPTURE_FINISH_FRAME);
+
+	/* lists go on top of the window's own draws, in creation order so the output doesn't depend on thread timing */
+	size_t i;
+	for (i = 0; i < info->drawListCount; i++)
+		hl_mergeDrawList((RSGL_renderer*)renderer, (RSGL_renderer*)hl_getWindowRenderer(info->drawLists[i]));
+
 	RSGL_renderer_render((RSGL_renderer*)renderer);
 
-	hl_swapBuffers(window);
+	if (((RSGL_renderer*)renderer)->stats)
+		info->overdrawFrames += 1;
+
+	if (info->renderThread)
+		hl_renderThread_submit(info->renderThread, (hl_drawListData*)((RSGL_renderer*)renderer)->ctx, true);
+	else if (info->type != HL_RENDERER_SOFTWARE)
+		hl_swapBuffers(window);
+	else if (info->surface)
+		hl_blitSurface(window, info->surface);
 }
 
 void hl_clear(hl_windowHandle window, hl_color color) {
 	hl_rendererHandle renderer = hl_getWindowRenderer(window);
+	if (hl_activeCapture)
+		hl_recordColor(window, HL_CAPTURE_CLEAR, color);
+
 	RSGL_renderer_clear(renderer, *(RSGL_color*)&color);
 }
 
+void hl_readPixels(hl_windowHandle window, hl_rect rect, uint8_t* pixels) {
+	hl_rendererHandle renderer = hl_getWindowRenderer(window);
+	if (hl_activeCapture)
+		hl_recordRect(window, HL_CAPTURE_READ_PIXELS, rect);
+
+	int32_t w, h;
+	hl_getWindowSize(window, &w, &h);
+	RSGL_renderer_readPixels((RSGL_renderer*)renderer, RSGL_RECT(rect.x, rect.y, rect.w, rect.h), h, pixels);
+}
+
+void hl_requestPixels(hl_windowHandle window, hl_rect rect) {
+	hl_rendererHandle renderer = hl_getWindowRenderer(window);
+	if (hl_activeCapture)
+		hl_recordRect(window, HL_CAPTURE_REQUEST_PIXELS, rect);
+
+	int32_t w, h;
+	hl_getWindowSize(window, &w, &h);
+	RSGL_renderer_requestPixels((RSGL_renderer*)renderer, RSGL_RECT(rect.x, rect.y, rect.w, rect.h), h);
+}
+
+bool hl_fetchPixels(hl_windowHandle window, uint8_t* pixels, bool wait) {
+	hl_rendererHandle renderer = hl_getWindowRenderer(window);
+	if (hl_activeCapture)
+		hl_recordValue(window, HL_CAPTURE_FETCH_PIXELS, wait);
+
+	return RSGL_renderer_fetchPixels((RSGL_renderer*)renderer, pixels, wait);
+}
+
 void hl_setTextureSource(hl_windowHandle window, hl_textureHandle texture, hl_rect rect) {
 	hl_rendererHandle renderer = hl_getWindowRenderer(window);
+	if (hl_activeCapture)
+		hl_recordTextureSource(window, texture, rect);
+
 	RSGL_renderer_setTextureSource(renderer, (RSGL_texture)texture, RSGL_RECT(rect.x, rect.y, rect.w, rect.h));
+
+	if (texture && hl_isTextureOpaque((hl_rendererInfo*)((RSGL_renderer*)renderer)->userPtr, (RSGL_texture)texture))
+		RSGL_renderer_setTextureOpaque(renderer, RSGL_TRUE);
 }
 
 void hl_setTexture(hl_windowHandle window, hl_textureHandle texture) {
 	hl_rendererHandle renderer = hl_getWindowRenderer(window);
+	if (hl_activeCapture)
+		hl_recordHandle(window, HL_CAPTURE_SET_TEXTURE, texture);
+
 	RSGL_renderer_setTexture(renderer, (RSGL_texture)texture);
+
+	if (texture && hl_isTextureOpaque((hl_rendererInfo*)((RSGL_renderer*)renderer)->userPtr, (RSGL_texture)texture))
+		RSGL_renderer_setTextureOpaque(renderer, RSGL_TRUE);
+}
+
+bool hl_setDepthSorting(hl_windowHandle window, bool enabled) {
+	RSGL_renderer* renderer = (RSGL_renderer*)hl_getWindowRenderer(window);
+	hl_rendererInfo* info = (hl_rendererInfo*)renderer->userPtr;
+
+	if (hl_activeCapture)
+		hl_recordValue(window, HL_CAPTURE_SET_DEPTH_SORTING, enabled);
+
+	/* the software renderer has no depth buffer, lists and render thread windows only record */
+	if (info->type == HL_RENDERER_SOFTWARE || info->parent || info->renderThread)
+		return false;
+
+	/* the batched draws got their z for the old mode */
+	if (renderer->data.len)
+		RSGL_renderer_render(renderer);
+
+	RSGL_renderer_setDepthSort(renderer, enabled);
+	return true;
+}
+
+bool hl_beginOverdrawReport(hl_windowHandle window) {
+	RSGL_renderer* renderer = (RSGL_renderer*)hl_getWindowRenderer(window);
+	hl_rendererInfo* info = (hl_rendererInfo*)renderer->userPtr;
+
+	/* only the modern renderer has occlusion queries, a render thread's renderer isn't reachable from here */
+	if (info->type != HL_RENDERER_GL_MODERN || info->parent || info->renderThread)
+		return false;
+
+	memset(&info->overdraw, 0, sizeof(info->overdraw));
+	info->overdrawFrames = 0;
+	RSGL_renderer_setStats(renderer, &info->overdraw);
+	return true;
+}
+
+bool hl_endOverdrawReport(hl_windowHandle window, hl_overdrawStats* stats) {
+	RSGL_renderer* renderer = (RSGL_renderer*)hl_getWindowRenderer(window);
+	hl_rendererInfo* info = (hl_rendererInfo*)renderer->userPtr;
+
+	if (renderer->stats == NULL)
+		return false;
+	RSGL_renderer_setStats(renderer, NULL);
+
+	int32_t w, h;
+	hl_getWindowSize(window, &w, &h);
+
+	stats->frames = info->overdrawFrames;
+	stats->pixels = (size_t)w * (size_t)h;
+	stats->fragments = info->overdraw.fragments;
+	stats->overdraw = (stats->frames && stats->pixels) ? (float)((double)stats->fragments / ((double)stats->pixels * (double)stats->frames)) : 0.0f;
+	return info->overdraw.counted;
+}
+
+void hl_pushClip(hl_windowHandle window, hl_rect rect) {
+	RSGL_renderer* renderer = (RSGL_renderer*)hl_getWindowRenderer(window);
+	hl_rendererInfo* info = (hl_rendererInfo*)renderer->userPtr;
+	assert(info->clipDepth < HL_MAX_CLIP_DEPTH);
+	if (info->clipDepth >= HL_MAX_CLIP_DEPTH)
+		return;
+
+	if (hl_activeCapture)
+		hl_recordRect(window, HL_CAPTURE_PUSH_CLIP, rect);
+
+	if (info->clipDepth) {
+		hl_rect top = info->clipStack[info->clipDepth - 1];
+		float x0 = rect.x > top.x ? rect.x : top.x;
+		float y0 = rect.y > top.y ? rect.y : top.y;
+		float x1 = (rect.x + rect.w) < (top.x + top.w) ? (rect.x + rect.w) : (top.x + top.w);
+		float y1 = (rect.y + rect.h) < (top.y + top.h) ? (rect.y + rect.h) : (top.y + top.h);
+
+		/* an empty intersection clips everything */
+		float w = x1 > x0 ? x1 - x0 : 0.0f;
+		float h = y1 > y0 ? y1 - y0 : 0.0f;
+		rect = HL_RECT(x0, y0, w, h);
+	}
+
+	info->clipStack[info->clipDepth++] = rect;
+	RSGL_renderer_setClip(renderer, RSGL_RECT(rect.x, rect.y, rect.w, rect.h));
+}
+
+void hl_popClip(hl_windowHandle window) {
+	RSGL_renderer* renderer = (RSGL_renderer*)hl_getWindowRenderer(window);
+	hl_rendererInfo* info = (hl_rendererInfo*)renderer->userPtr;
+	assert(info->clipDepth);
+	if (info->clipDepth == 0)
+		return;
+
+	if (hl_activeCapture)
+		hl_recordOp(window, HL_CAPTURE_POP_CLIP);
+
+	info->clipDepth -= 1;
+	if (info->clipDepth == 0) {
+		RSGL_renderer_resetClip(renderer);
+		return;
+	}
+
+	hl_rect top = info->clipStack[info->clipDepth - 1];
+	RSGL_renderer_setClip(renderer, RSGL_RECT(top.x, top.y, top.w, top.h));
 }
 
 void hl_setFont(hl_windowHandle window, hl_fontHandle font) {
 	hl_rendererHandle renderer = hl_getWindowRenderer(window);
 	hl_rendererInfo* info = (hl_rendererInfo*)((RSGL_renderer*)renderer)->userPtr;
 	info->font = font;
+
+	if (hl_activeCapture)
+		hl_recordHandle(window, HL_CAPTURE_SET_FONT, font);
 }
 
 void hl_drawTextLen(hl_windowHandle window, const char* text, size_t len, int32_t x, int32_t y, int32_t size) {
 	hl_rendererHandle renderer = hl_getWindowRenderer(window);
 	hl_rendererInfo* info = (hl_rendererInfo*)((RSGL_renderer*)renderer)->userPtr;
 
-	assert(info->font);
+	if (hl_activeCapture)
+		hl_recordText(window, HL_CAPTURE_DRAW_TEXT_LEN, text, len, x, y, size);
+
+	if (info->parent) {
+		hl_drawList_text((RSGL_renderer*)renderer, info->font, text, len ? len : strlen(text), x, y, size);
+		return;
+	}
+
+	assert(info->font && info->renderer_rfont);
 	RFont_draw_text_len(info->renderer_rfont, info->font, text, len, x, y, size, 0.0f);
 }
 
@@ -160,22 +1582,393 @@ void hl_drawText(hl_windowHandle window, const char* text, int32_t x, int32_t y,
 	hl_rendererHandle renderer = hl_getWindowRenderer(window);
 	hl_rendererInfo* info = (hl_rendererInfo*)((RSGL_renderer*)renderer)->userPtr;
 
-	assert(info->font);
+	if (hl_activeCapture)
+		hl_recordText(window, HL_CAPTURE_DRAW_TEXT, text, strlen(text), x, y, size);
+
+	if (info->parent) {
+		hl_drawList_text((RSGL_renderer*)renderer, info->font, text, strlen(text), x, y, size);
+		return;
+	}
+
+	assert(info->font && info->renderer_rfont);
 	RFont_draw_text(info->renderer_rfont, info->font, text, (float)x, (float)y, (float)size);
 }
 
 void hl_setColor(hl_windowHandle window, hl_color color) {
 	hl_rendererHandle renderer = hl_getWindowRenderer(window);
+	if (hl_activeCapture)
+		hl_recordColor(window, HL_CAPTURE_SET_COLOR, color);
+
 	RSGL_renderer_setColor(renderer, *(RSGL_color*)&color);
 }
 
 void hl_drawLine(hl_windowHandle window, hl_vec2D vec1, hl_vec2D vec2) {
 	hl_rendererHandle renderer = hl_getWindowRenderer(window);
+	if (hl_activeCapture)
+		hl_recordLine(window, vec1, vec2);
+
 	RSGL_drawLine(renderer, RSGL_VEC2D(vec1.x, vec1.y), RSGL_VEC2D(vec2.x, vec2.y), 1);
 }
 
+/*
+ * min/max decimation that keeps the first, lowest, highest and last point of every pixel column in their original order,
+ * the line still enters, spans and leaves each column the same way so the result is drawn with the same pixels
+ * returns the number of points written to out, or 0 if the points aren't sorted by x or need more than cap
+*/
+static size_t hl_decimatePolyline(const hl_vec2D* points, size_t count, hl_vec2D* out, size_t cap) {
+	size_t written = 0;
+	size_t first = 0, low = 0, high = 0;
+	float column = floorf(points[0].x);
+	size_t i, j;
+
+	for (i = 1; i <= count; i++) {
+		if (i < count) {
+			if (points[i].x < points[i - 1].x)
+				return 0;
+
+			if (floorf(points[i].x) == column) {
+				if (points[i].y < points[low].y) low = i;
+				if (points[i].y > points[high].y) high = i;
+				continue;
+			}
+		}
+
+		/* the column ended at i - 1, emit its points by index and skip duplicates */
+		if (written + 4 > cap)
+			return 0;
+
+		size_t keep[4] = { first, low, high, i - 1 };
+		if (keep[1] > keep[2]) { size_t t = keep[1]; keep[1] = keep[2]; keep[2] = t; }
+
+		for (j = 0; j < 4; j++) {
+			if (j && keep[j] == keep[j - 1])
+				continue;
+			out[written++] = points[keep[j]];
+		}
+
+		if (i < count) {
+			first = low = high = i;
+			column = floorf(points[i].x);
+		}
+	}
+
+	return written;
+}
+
+void hl_drawPolyline(hl_windowHandle window, const hl_vec2D* points, size_t count, float thickness) {
+	RSGL_renderer* renderer = (RSGL_renderer*)hl_getWindowRenderer(window);
+	hl_rendererInfo* info = (hl_rendererInfo*)renderer->userPtr;
+
+	if (count < 2)
+		return;
+
+	if (hl_activeCapture)
+		hl_recordPolyline(window, points, count, thickness);
+
+	/* only worth a pass over the points when there are clearly more of them than columns */
+	float span = floorf(points[count - 1].x) - floorf(points[0].x) + 1.0f;
+	if (info->decimatePolylines && span > 0.0f && (float)count > span * 4.0f) {
+		size_t cap = (size_t)span * 4;
+		if (cap > info->polylineCap) {
+			info->polyline = (hl_vec2D*)realloc(info->polyline, cap * sizeof(hl_vec2D));
+			info->polylineCap = cap;
+		}
+
+		size_t decimated = hl_decimatePolyline(points, count, info->polyline, cap);
+		if (decimated) {
+			points = info->polyline;
+			count = decimated;
+		}
+	}
+
+	RSGL_drawPolyline(renderer, (const RSGL_vec2D*)points, count, thickness);
+}
+
+void hl_setPolylineDecimation(hl_windowHandle window, bool enabled) {
+	hl_rendererHandle renderer = hl_getWindowRenderer(window);
+	hl_rendererInfo* info = (hl_rendererInfo*)((RSGL_renderer*)renderer)->userPtr;
+	info->decimatePolylines = enabled;
+
+	if (hl_activeCapture)
+		hl_recordValue(window, HL_CAPTURE_SET_POLYLINE_DECIMATION, enabled);
+}
+
 void hl_drawRect(hl_windowHandle window, hl_rect rect) {
 	hl_rendererHandle renderer = hl_getWindowRenderer(window);
+	if (hl_activeCapture)
+		hl_recordRect(window, HL_CAPTURE_DRAW_RECT, rect);
+
 	RSGL_drawRect(renderer, RSGL_RECT(rect.x, rect.y, rect.w, rect.h));
 }
 
+
+/*
+ * tilemaps keep their tiles in chunks of HL_TILEMAP_CHUNK_SIZE x HL_TILEMAP_CHUNK_SIZE,
+ * every chunk owns vertex buffers that are only rebuilt after one of its tiles changed
+*/
+#define HL_TILEMAP_CHUNK_SIZE 32
+
+typedef struct hl_tile {
+	hl_rect source;
+	hl_color color; /* a transparent tile is empty */
+} hl_tile;
+
+typedef struct hl_tilemapChunk {
+	size_t vertex, color, texture, elements;
+	RSGL_BATCH* batches;
+	size_t batchCount;
+	bool created, dirty;
+} hl_tilemapChunk;
+
+typedef struct hl_tilemap {
+	RSGL_renderer* renderer; /* owner of the chunk buffers */
+	hl_textureHandle atlas;
+	uint32_t columns, rows;
+	float tileWidth, tileHeight;
+	hl_tile* tiles;
+
+	uint32_t chunkColumns, chunkRows;
+	hl_tilemapChunk* chunks;
+
+	/* RSGL_renderBuffers is too big to keep one per chunk, a chunk's buffers and batches are copied in here to build or draw it */
+	RSGL_renderBuffers pass;
+} hl_tilemap;
+
+hl_tilemapHandle hl_createTilemap(hl_windowHandle window, uint32_t columns, uint32_t rows, float tileWidth, float tileHeight, hl_textureHandle atlas) {
+	hl_tilemap* map = (hl_tilemap*)malloc(sizeof(hl_tilemap));
+	memset(map, 0, sizeof(hl_tilemap));
+
+	map->renderer = (RSGL_renderer*)hl_getWindowRenderer(window);
+	map->atlas = atlas;
+	map->columns = columns;
+	map->rows = rows;
+	map->tileWidth = tileWidth;
+	map->tileHeight = tileHeight;
+	map->tiles = (hl_tile*)calloc((size_t)columns * rows, sizeof(hl_tile));
+
+	map->chunkColumns = (columns + HL_TILEMAP_CHUNK_SIZE - 1) / HL_TILEMAP_CHUNK_SIZE;
+	map->chunkRows = (rows + HL_TILEMAP_CHUNK_SIZE - 1) / HL_TILEMAP_CHUNK_SIZE;
+	map->chunks = (hl_tilemapChunk*)calloc((size_t)map->chunkColumns * map->chunkRows, sizeof(hl_tilemapChunk));
+
+	if (hl_activeCapture)
+		hl_recordTilemap(window, (hl_tilemapHandle)map, columns, rows, tileWidth, tileHeight, atlas);
+
+	return (hl_tilemapHandle)map;
+}
+
+void hl_releaseTilemap(hl_windowHandle window, hl_tilemapHandle tilemap) {
+	hl_tilemap* map = (hl_tilemap*)tilemap;
+
+	if (hl_activeCapture)
+		hl_recordHandle(window, HL_CAPTURE_RELEASE_TILEMAP, tilemap);
+
+	size_t i;
+	for (i = 0; i < (size_t)map->chunkColumns * map->chunkRows; i++) {
+		hl_tilemapChunk* chunk = &map->chunks[i];
+		if (chunk->created) {
+			RSGL_renderer_deleteBuffer(map->renderer, chunk->vertex);
+			RSGL_renderer_deleteBuffer(map->renderer, chunk->color);
+			RSGL_renderer_deleteBuffer(map->renderer, chunk->texture);
+			RSGL_renderer_deleteBuffer(map->renderer, chunk->elements);
+		}
+		free(chunk->batches);
+	}
+
+	free(map->chunks);
+	free(map->tiles);
+	free(map);
+}
+
+void hl_getTilemapSize(hl_tilemapHandle tilemap, uint32_t* columns, uint32_t* rows) {
+	const hl_tilemap* map = (const hl_tilemap*)tilemap;
+	*columns = map->columns;
+	*rows = map->rows;
+}
+
+void hl_setTile(hl_tilemapHandle tilemap, uint32_t column, uint32_t row, hl_rect source, hl_color color) {
+	hl_tilemap* map = (hl_tilemap*)tilemap;
+	assert(column < map->columns && row < map->rows);
+
+	if (hl_activeCapture)
+		hl_recordTile(tilemap, HL_CAPTURE_SET_TILE, column, row, source, color);
+
+	hl_tile* tile = &map->tiles[(size_t)row * map->columns + column];
+	tile->source = source;
+	tile->color = color;
+
+	map->chunks[(size_t)(row / HL_TILEMAP_CHUNK_SIZE) * map->chunkColumns + column / HL_TILEMAP_CHUNK_SIZE].dirty = true;
+}
+
+void hl_clearTile(hl_tilemapHandle tilemap, uint32_t column, uint32_t row) {
+	hl_setTile(tilemap, column, row, HL_RECT(0, 0, 0, 0), HL_RGBA(0, 0, 0, 0));
+}
+
+/* emit the non empty tiles in [column0, column1) x [row0, row1), positioned by the map's tile grid scaled by zoom and shifted by offset */
+static void hl_tilemap_drawTiles(hl_tilemap* map, RSGL_renderer* renderer, uint32_t column0, uint32_t row0, uint32_t column1, uint32_t row1,
+								float offsetX, float offsetY, float zoom) {
+	float w = map->tileWidth * zoom, h = map->tileHeight * zoom;
+	uint32_t x, y;
+
+	for (y = row0; y < row1; y++) {
+		const hl_tile* tile = &map->tiles[(size_t)y * map->columns + column0];
+		for (x = column0; x < column1; x++, tile++) {
+			if (tile->color.a == 0)
+				continue;
+
+			RSGL_renderer_setTextureSource(renderer, (RSGL_texture)map->atlas, RSGL_RECT(tile->source.x, tile->source.y, tile->source.w, tile->source.h));
+			RSGL_renderer_setColor(renderer, *(RSGL_color*)&tile->color);
+
+			float tileX = (float)x * w + offsetX;
+			float tileY = (float)y * h + offsetY;
+			RSGL_drawRect(renderer, RSGL_RECT(tileX, tileY, w, h));
+		}
+	}
+}
+
+/* turn the chunk's tiles into vertices and upload them to its buffers, the renderer's batch has to be empty */
+static void hl_tilemap_buildChunk(hl_tilemap* map, RSGL_renderer* renderer, hl_tilemapChunk* chunk, uint32_t chunkX, uint32_t chunkY) {
+	const size_t maxVerts = HL_TILEMAP_CHUNK_SIZE * HL_TILEMAP_CHUNK_SIZE * 4;
+
+	if (chunk->created == false) {
+		memset(&map->pass, 0, sizeof(size_t) * 4); /* GL only writes the low 32 bits of the handles */
+		RSGL_renderer_createRenderBuffers(renderer, maxVerts, &map->pass);
+		chunk->vertex = map->pass.vertex;
+		chunk->color = map->pass.color;
+		chunk->texture = map->pass.texture;
+		chunk->elements = map->pass.elements;
+		chunk->created = true;
+	}
+
+	RSGL_renderState state = renderer->state;
+
+	map->pass.vertex = chunk->vertex;
+	map->pass.color = chunk->color;
+	map->pass.texture = chunk->texture;
+	map->pass.elements = chunk->elements;
+	map->pass.maxVerts = RSGL_MAX_VERTS; /* a full chunk fits, it must not flush halfway */
+	map->pass.batchCount = 0;
+
+	/* tiles are stored in map space, the camera is applied through the batch matrix when drawing */
+	renderer->state.buffers = &map->pass;
+	renderer->state.clipped = RSGL_FALSE;
+	renderer->state.rotate = RSGL_VEC3D(0, 0, 0);
+	renderer->state.gradient = NULL;
+	renderer->state.gradient_len = 0;
+	renderer->state.modelMatrix = RSGL_mat4_loadIdentity();
+	renderer->state.depthSort = RSGL_FALSE; /* built at z 0 and in draw order, hl_drawTilemap places the map */
+
+	uint32_t column0 = chunkX * HL_TILEMAP_CHUNK_SIZE, row0 = chunkY * HL_TILEMAP_CHUNK_SIZE;
+	uint32_t column1 = column0 + HL_TILEMAP_CHUNK_SIZE, row1 = row0 + HL_TILEMAP_CHUNK_SIZE;
+	if (column1 > map->columns) column1 = map->columns;
+	if (row1 > map->rows) row1 = map->rows;
+	hl_tilemap_drawTiles(map, renderer, column0, row0, column1, row1, 0.0f, 0.0f, 1.0f);
+
+	RSGL_renderer_updateRenderBuffers(renderer);
+
+	chunk->batches = (RSGL_BATCH*)realloc(chunk->batches, (map->pass.batchCount ? map->pass.batchCount : 1) * sizeof(RSGL_BATCH));
+	memcpy(chunk->batches, map->pass.batches, map->pass.batchCount * sizeof(RSGL_BATCH));
+	chunk->batchCount = map->pass.batchCount;
+	chunk->dirty = false;
+
+	renderer->data.len = 0;
+	renderer->data.elements_count = 0;
+	renderer->state = state;
+}
+
+/* range of cells of the given size that overlap [start, start + length), clamped to [0, count) */
+static bool hl_tilemap_visibleRange(float start, float length, float cellSize, uint32_t count, uint32_t* first, uint32_t* last) {
+	float cell0 = floorf(start / cellSize);
+	float cell1 = ceilf((start + length) / cellSize);
+	if (cell1 <= 0.0f || cell0 >= (float)count || cell1 <= cell0)
+		return false;
+
+	*first = cell0 > 0.0f ? (uint32_t)cell0 : 0;
+	*last = cell1 < (float)count ? (uint32_t)cell1 : count;
+	return true;
+}
+
+void hl_drawTilemap(hl_windowHandle window, hl_tilemapHandle tilemap, float cameraX, float cameraY, float zoom) {
+	RSGL_renderer* renderer = (RSGL_renderer*)hl_getWindowRenderer(window);
+	hl_rendererInfo* info = (hl_rendererInfo*)renderer->userPtr;
+	hl_tilemap* map = (hl_tilemap*)tilemap;
+
+	if (hl_activeCapture)
+		hl_recordDrawTilemap(window, tilemap, cameraX, cameraY, zoom);
+
+	int32_t w, h;
+	hl_getWindowSize(window, &w, &h);
+	float viewW = (float)w / zoom, viewH = (float)h / zoom;
+
+	/* draw lists and render thread windows only record, and other windows don't own the buffers, both get the visible tiles as plain draws */
+	if (renderer != map->renderer || info->parent || info->renderThread) {
+		uint32_t column0, column1, row0, row1;
+		if (hl_tilemap_visibleRange(cameraX, viewW, map->tileWidth, map->columns, &column0, &column1) == false ||
+			hl_tilemap_visibleRange(cameraY, viewH, map->tileHeight, map->rows, &row0, &row1) == false)
+			return;
+
+		RSGL_texture texture = renderer->state.texture;
+		RSGL_rect source = renderer->state.source;
+		RSGL_color color = renderer->state.color;
+		RSGL_bool textureOpaque = renderer->state.textureOpaque;
+
+		hl_tilemap_drawTiles(map, renderer, column0, row0, column1, row1, -cameraX * zoom, -cameraY * zoom, zoom);
+
+		renderer->state.texture = texture;
+		renderer->state.source = source;
+		renderer->state.color = color;
+		renderer->state.textureOpaque = textureOpaque;
+		return;
+	}
+
+	uint32_t chunkX0, chunkX1, chunkY0, chunkY1;
+	if (hl_tilemap_visibleRange(cameraX, viewW, map->tileWidth * HL_TILEMAP_CHUNK_SIZE, map->chunkColumns, &chunkX0, &chunkX1) == false ||
+		hl_tilemap_visibleRange(cameraY, viewH, map->tileHeight * HL_TILEMAP_CHUNK_SIZE, map->chunkRows, &chunkY0, &chunkY1) == false)
+		return;
+
+	/* the window's earlier draws go first, this also empties the batch the chunks are built with */
+	RSGL_renderer_render(renderer);
+
+	RSGL_mat4 camera = RSGL_mat4_loadIdentity();
+	camera.m[0] = zoom;
+	camera.m[5] = zoom;
+	camera.m[12] = -cameraX * zoom;
+	camera.m[13] = -cameraY * zoom;
+
+	/* the chunks are built at z 0, depth sorting moves the whole map to its place in the frame */
+	if (renderer->state.depthSort)
+		camera.m[14] = RSGL_renderer_nextDepth(renderer);
+
+	RSGL_renderBuffers* buffers = renderer->state.buffers;
+
+	uint32_t x, y;
+	size_t i;
+	for (y = chunkY0; y < chunkY1; y++) {
+		for (x = chunkX0; x < chunkX1; x++) {
+			hl_tilemapChunk* chunk = &map->chunks[(size_t)y * map->chunkColumns + x];
+			if (chunk->dirty)
+				hl_tilemap_buildChunk(map, renderer, chunk, x, y);
+			if (chunk->batchCount == 0)
+				continue;
+
+			map->pass.vertex = chunk->vertex;
+			map->pass.color = chunk->color;
+			map->pass.texture = chunk->texture;
+			map->pass.elements = chunk->elements;
+			map->pass.batchCount = chunk->batchCount;
+
+			/* the chunk was built without camera or clip, both are the current ones */
+			for (i = 0; i < chunk->batchCount; i++) {
+				RSGL_BATCH* batch = &map->pass.batches[i];
+				*batch = chunk->batches[i];
+				batch->matrix = camera;
+				batch->clipped = renderer->state.clipped;
+				batch->clip = renderer->state.clip;
+			}
+
+			renderer->state.buffers = &map->pass;
+			RSGL_renderer_renderBuffers(renderer);
+		}
+	}
+
+	renderer->state.buffers = buffers;
+}
@@ -0,0 +1,161 @@
+#include "internal.h"
+
+#include <stdlib.h>
+
+#if defined(_WIN32)
+	#include <windows.h>
+#else
+	#include <pthread.h>
+#endif
+
+struct hl_thread {
+	hl_threadFunc func;
+	void* arg;
+#if defined(_WIN32)
+	HANDLE handle;
+#else
+	pthread_t handle;
+#endif
+};
+
+struct hl_mutex {
+#if defined(_WIN32)
+	CRITICAL_SECTION handle;
+#else
+	pthread_mutex_t handle;
+#endif
+};
+
+struct hl_condition {
+#if defined(_WIN32)
+	CONDITION_VARIABLE handle;
+#else
+	pthread_cond_t handle;
+#endif
+};
+
+#if defined(_WIN32)
+static DWORD WINAPI hl_threadProc(LPVOID arg) {
+#else
+static void* hl_threadProc(void* arg) {
+#endif
+	hl_thread* thread = (hl_thread*)arg;
+	thread->func(thread->arg);
+	hl_freeThreadArena();
+	return 0;
+}
+
+hl_thread* hl_createThread(hl_threadFunc func, void* arg) {
+	hl_thread* thread = (hl_thread*)malloc(sizeof(hl_thread));
+	thread->func = func;
+	thread->arg = arg;
+
+#if defined(_WIN32)
+	thread->handle = CreateThread(NULL, 0, hl_threadProc, thread, 0, NULL);
+	if (thread->handle == NULL) {
+#else
+	if (pthread_create(&thread->handle, NULL, hl_threadProc, thread) != 0) {
+#endif
+		free(thread);
+		return NULL;
+	}
+
+	return thread;
+}
+
+void hl_joinThread(hl_thread* thread) {
+#if defined(_WIN32)
+	WaitForSingleObject(thread->handle, INFINITE);
+	CloseHandle(thread->handle);
+#else
+	pthread_join(thread->handle, NULL);
+#endif
+	free(thread);
+}
+
+hl_mutex* hl_createMutex(void) {
+	hl_mutex* mutex = (hl_mutex*)malloc(sizeof(hl_mutex));
+#if defined(_WIN32)
+	InitializeCriticalSection(&mutex->handle);
+#else
+	pthread_mutex_init(&mutex->handle, NULL);
+#endif
+	return mutex;
+}
+
+void hl_freeMutex(hl_mutex* mutex) {
+#if defined(_WIN32)
+	DeleteCriticalSection(&mutex->handle);
+#else
+	pthread_mutex_destroy(&mutex->handle);
+#endif
+	free(mutex);
+}
+
+void hl_lockMutex(hl_mutex* mutex) {
+#if defined(_WIN32)
+	EnterCriticalSection(&mutex->handle);
+#else
+	pthread_mutex_lock(&mutex->handle);
+#endif
+}
+
+void hl_unlockMutex(hl_mutex* mutex) {
+#if defined(_WIN32)
+	LeaveCriticalSection(&mutex->handle);
+#else
+	pthread_mutex_unlock(&mutex->handle);
+#endif
+}
+
+hl_condition* hl_createCondition(void) {
+	hl_condition* condition = (hl_condition*)malloc(sizeof(hl_condition));
+#if defined(_WIN32)
+	InitializeConditionVariable(&condition->handle);
+#else
+	pthread_cond_init(&condition->handle, NULL);
+#endif
+	return condition;
+}
+
+void hl_freeCondition(hl_condition* condition) {
+#if !defined(_WIN32)
+	pthread_cond_destroy(&condition->handle);
+#endif
+	free(condition);
+}
+
+void hl_waitCondition(hl_condition* condition, hl_mutex* mutex) {
+#if defined(_WIN32)
+	SleepConditionVariableCS(&condition->handle, &mutex->handle, INFINITE);
+#else
+	pthread_cond_wait(&condition->handle, &mutex->handle);
+#endif
+}
+
+void hl_broadcastCondition(hl_condition* condition) {
+#if defined(_WIN32)
+	WakeAllConditionVariable(&condition->handle);
+#else
+	pthread_cond_broadcast(&condition->handle);
+#endif
+}
+
+size_t hl_atomicLoad(volatile size_t* ptr) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#else
+	size_t value = *ptr;
+	MemoryBarrier();
+	return value;
+#endif
+}
+
+void hl_atomicStore(volatile size_t* ptr, size_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+	__atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#else
+	MemoryBarrier();
+	*ptr = value;
+#endif
+}
@@ -8,18 +8,33 @@
 #endif
 
 hl_windowHandle hl_createWindow(const char* name, int32_t width, int32_t height, hl_windowFlags flags) {
-	hl_windowHandle window = hl_createWindowPlatform(name, width, height, flags);
+	return hl_createSharedWindow(name, width, height, flags, NULL);
+}
+
+hl_windowHandle hl_createSharedWindow(const char* name, int32_t width, int32_t height, hl_windowFlags flags, hl_windowHandle share) {
+	hl_windowHandle window = hl_createWindowPlatform(name, width, height, flags, share);
+	if (window == NULL)
+		return NULL;
 
 	uint32_t type = -1;
 
-	if (flags & HL_RENDERER_GL_LEGACY)
+	if (flags & HL_WINDOW_HEADLESS)
+		type = HL_RENDERER_SOFTWARE; /* there is no display to create an OpenGL context with */
+	else if (flags & HL_RENDERER_GL_LEGACY)
 		type = HL_RENDERER_GL_LEGACY;
 	else if (flags & HL_RENDERER_GL_MODERN)
 		type = HL_RENDERER_GL_MODERN;
+	else if (flags & HL_RENDERER_SOFTWARE)
+		type = HL_RENDERER_SOFTWARE;
 
 	if (type != -1) {
-		hl_rendererHandle renderer = hl_initRenderer(type, window);
+		hl_rendererHandle renderer = hl_initSharedRenderer(type, window, share);
 		(void)(renderer);
+
+		if ((flags & HL_WINDOW_RENDER_THREAD) && type != HL_RENDERER_SOFTWARE)
+			hl_startRenderThread(window);
+
+		hl_captureNewWindow(window);
 	}
 
 	return (hl_windowHandle)window;